@@ -0,0 +1,567 @@
+//
+//  TLTransitionBenchmark.c
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+// Drives the portable transition core the way `TLTransitionLayout` does, over
+// synthetic layouts, and prints one JSON object per run. Runs headless on any
+// platform with a C99 compiler. See `usage()` for options.
+
+#define _XOPEN_SOURCE 600
+
+#include "TLTransitionCore.h"
+#include "TLTransitionMetrics.h"
+#include "TLTransitionTrace.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TLBenchmarkViewportWidth 375.0
+#define TLBenchmarkViewportHeight 667.0
+#define TLBenchmarkItemsPerSection 100
+#define TLBenchmarkSupplementaryHeight 30.0
+#define TLBenchmarkMaxColumns 4
+
+typedef enum {
+    TLBenchmarkLayoutFlow,
+    TLBenchmarkLayoutGrid,
+    TLBenchmarkLayoutRagged,
+    TLBenchmarkLayoutCount,
+} TLBenchmarkLayoutKind;
+
+static const char *TLBenchmarkLayoutNames[] = {"flow", "grid", "ragged"};
+
+typedef enum {
+    TLBenchmarkModeSweep,
+    TLBenchmarkModeReverse,
+    TLBenchmarkModeCancel,
+    TLBenchmarkModeCount,
+} TLBenchmarkMode;
+
+static const char *TLBenchmarkModeNames[] = {"sweep", "reverse", "cancel"};
+
+typedef struct {
+    TLBenchmarkLayoutKind kind;
+    size_t items;
+    bool supplementary;
+    bool transforms;
+} TLBenchmarkConfig;
+
+typedef struct {
+    TLCorePose *poses;
+    size_t count;
+    TLCoreSize contentSize;
+} TLBenchmarkLayout;
+
+// Allocation tracking
+//
+// Only the benchmark's own buffers go through `TLBenchmarkAlloc`, so the
+// `allocations` and `allocated_bytes` fields count the per-run pose buffers and
+// snapshots allocated here. Allocations made inside the core, such as trace
+// events or metrics buffers, are not included.
+
+static size_t allocationCount;
+static size_t allocatedBytes;
+
+static void *TLBenchmarkAlloc(size_t size)
+{
+    void *memory = malloc(size);
+    if (!memory) {
+        fprintf(stderr, "out of memory allocating %zu bytes\n", size);
+        exit(1);
+    }
+    allocationCount++;
+    allocatedBytes += size;
+    return memory;
+}
+
+// The peak is process-wide and never goes down, so each run is forked into its
+// own process (see `main`) for the figure to describe that run alone.
+static long TLBenchmarkPeakMemoryKB(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static double TLBenchmarkNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+// Synthetic layouts
+
+// deterministic per-item aspect ratio in [0.5, 1.5) for ragged layouts
+static double TLBenchmarkAspectRatio(size_t item)
+{
+    unsigned long long x = item * 6364136223846793005ULL + 1442695040888963407ULL;
+    x ^= x >> 33;
+    return 0.5 + (double)(x % 1000) / 1000.0;
+}
+
+static TLCorePose TLBenchmarkPose(double x, double y, double width, double height, bool transforms, int phase)
+{
+    TLCorePose pose;
+    memset(&pose, 0, sizeof(pose));
+    pose.size = (TLCoreSize){width, height};
+    pose.center = (TLCorePoint){x + width / 2, y + height / 2};
+    pose.alpha = 1;
+    double scale = transforms ? (phase ? 0.9 : 1.1) : 1;
+    double angle = transforms ? (phase ? -0.05 : 0.05) : 0;
+    pose.transform = (TLCoreAffineTransform){scale * cos(angle), scale * sin(angle), -scale * sin(angle), scale * cos(angle), 0, 0};
+    pose.transform3D.m11 = pose.transform3D.m22 = pose.transform3D.m33 = pose.transform3D.m44 = 1;
+    if (transforms) {
+        pose.transform3D.m34 = phase ? -1.0 / 500 : -1.0 / 800;
+    }
+    return pose;
+}
+
+/*
+ Builds the "from" (phase 0) or "to" (phase 1) layout. Items are laid out in
+ sections, each optionally preceded by a header and followed by a footer:
+
+   flow   - one column of rows, 44pt tall going to 88pt
+   grid   - square cells, 4 columns going to 2
+   ragged - waterfall of variable height cells, 2 columns going to 3
+ */
+static void TLBenchmarkBuildLayout(TLBenchmarkLayout *layout, const TLBenchmarkConfig *config, int phase)
+{
+    int columns;
+    switch (config->kind) {
+        case TLBenchmarkLayoutFlow: columns = 1; break;
+        case TLBenchmarkLayoutGrid: columns = phase ? 2 : 4; break;
+        default: columns = phase ? 3 : 2; break;
+    }
+    double columnWidth = TLBenchmarkViewportWidth / columns;
+    size_t sections = (config->items + TLBenchmarkItemsPerSection - 1) / TLBenchmarkItemsPerSection;
+    layout->count = config->items + (config->supplementary ? 2 * sections : 0);
+    layout->poses = TLBenchmarkAlloc(layout->count * sizeof(TLCorePose));
+
+    size_t index = 0;
+    size_t item = 0;
+    double y = 0;
+    for (size_t section = 0; section < sections; section++) {
+        if (config->supplementary) {
+            layout->poses[index++] = TLBenchmarkPose(0, y, TLBenchmarkViewportWidth, TLBenchmarkSupplementaryHeight, config->transforms, phase);
+            y += TLBenchmarkSupplementaryHeight;
+        }
+        double columnHeights[TLBenchmarkMaxColumns];
+        for (int column = 0; column < columns; column++) {
+            columnHeights[column] = y;
+        }
+        for (size_t row = 0; row < TLBenchmarkItemsPerSection && item < config->items; row++, item++) {
+            int column = 0;
+            double height;
+            switch (config->kind) {
+                case TLBenchmarkLayoutFlow:
+                    height = phase ? 88 : 44;
+                    break;
+                case TLBenchmarkLayoutGrid:
+                    column = row % columns;
+                    height = columnWidth;
+                    break;
+                default:
+                    for (int c = 1; c < columns; c++) {
+                        if (columnHeights[c] < columnHeights[column]) {
+                            column = c;
+                        }
+                    }
+                    height = columnWidth * TLBenchmarkAspectRatio(item);
+                    break;
+            }
+            layout->poses[index++] = TLBenchmarkPose(column * columnWidth, columnHeights[column], columnWidth, height, config->transforms, phase);
+            columnHeights[column] += height;
+        }
+        for (int column = 0; column < columns; column++) {
+            y = fmax(y, columnHeights[column]);
+        }
+        if (config->supplementary) {
+            layout->poses[index++] = TLBenchmarkPose(0, y, TLBenchmarkViewportWidth, TLBenchmarkSupplementaryHeight, config->transforms, phase);
+            y += TLBenchmarkSupplementaryHeight;
+        }
+    }
+    layout->contentSize = (TLCoreSize){TLBenchmarkViewportWidth, y};
+}
+
+// Simulated transition layout
+
+typedef struct {
+    const TLBenchmarkLayout *currentLayout;
+    const TLBenchmarkLayout *nextLayout;
+    TLCorePose *poses;
+    bool hasPoses;
+    double previousProgress;
+    double progress;
+    TLCorePoint fromContentOffset;
+    TLCorePoint toContentOffset;
+    TLCorePoint contentOffset;
+    size_t elementsInterpolated;
+    size_t elementsVisible;
+    double checksum;
+    double interpolateNanoseconds;
+    double queryNanoseconds;
+} TLBenchmarkTransition;
+
+// mirrors `-[TLTransitionLayout setTransitionProgress:time:]`
+static void TLBenchmarkSetProgress(TLBenchmarkTransition *transition, double progress)
+{
+    transition->previousProgress = transition->progress;
+    transition->progress = progress;
+    transition->contentOffset = TLCoreInterpolatePoint(transition->fromContentOffset, transition->toContentOffset, progress);
+}
+
+// mirrors `-[TLTransitionLayout prepareLayout]`
+static void TLBenchmarkPrepareLayout(TLBenchmarkTransition *transition)
+{
+    bool reverse = transition->previousProgress > transition->progress;
+    double t = TLCoreIncrementalProgress(transition->previousProgress, transition->progress);
+    const TLCorePose *current = transition->currentLayout->poses;
+    const TLCorePose *next = transition->nextLayout->poses;
+    size_t count = transition->currentLayout->count;
+    for (size_t i = 0; i < count; i++) {
+        const TLCorePose *fromPose = transition->hasPoses ? &transition->poses[i] : &current[i];
+        const TLCorePose *toPose = reverse ? &current[i] : &next[i];
+        TLCoreInterpolatePose(&transition->poses[i], fromPose, toPose, t);
+    }
+    transition->hasPoses = true;
+    transition->elementsInterpolated += count;
+}
+
+// mirrors `-[TLTransitionLayout layoutAttributesForElementsInRect:]` for the visible rect
+static void TLBenchmarkQueryVisibleRect(TLBenchmarkTransition *transition)
+{
+    TLCoreRect rect = {transition->contentOffset, {TLBenchmarkViewportWidth, TLBenchmarkViewportHeight}};
+    size_t count = transition->currentLayout->count;
+    for (size_t i = 0; i < count; i++) {
+        const TLCorePose *pose = &transition->poses[i];
+        double minX = pose->center.x - pose->size.width / 2;
+        double minY = pose->center.y - pose->size.height / 2;
+        if (minX < TLCoreRectGetMaxX(rect) && minX + pose->size.width > rect.origin.x
+                && minY < TLCoreRectGetMaxY(rect) && minY + pose->size.height > rect.origin.y) {
+            // fold in every interpolated field so none of them can be optimized away
+            transition->elementsVisible++;
+            transition->checksum += pose->center.x + pose->center.y + pose->size.width + pose->size.height + pose->alpha
+                    + pose->transform.a + pose->transform.b + pose->transform.c + pose->transform.d
+                    + pose->transform3D.m34 * 1000;
+        }
+    }
+}
+
+// per-frame metrics sink, installed with --metrics
+static TLCoreMetricsSink metricsSink;
+static uint64_t metricsFrameCount;
+
+// trace of the first run, recorded with --record
+static const char *recordPath;
+static TLCoreTrace *recordingTrace;
+
+static void TLBenchmarkFrame(TLBenchmarkTransition *transition, double progress)
+{
+    if (recordingTrace) {
+        // simulate a 60Hz display link driving the transition
+        double timestamp = (double)recordingTrace->eventCount / 2 / 60;
+        TLCoreTraceAppendEvent(recordingTrace, TLCoreTraceEventProgress, timestamp, progress, progress);
+        TLCoreTraceAppendEvent(recordingTrace, TLCoreTraceEventDisplayLink, timestamp, 1.0 / 60, 0);
+    }
+    if (!metricsSink.record) {
+        TLBenchmarkSetProgress(transition, progress);
+        double start = TLBenchmarkNow();
+        TLBenchmarkPrepareLayout(transition);
+        double prepareEnd = TLBenchmarkNow();
+        TLBenchmarkQueryVisibleRect(transition);
+        transition->interpolateNanoseconds += prepareEnd - start;
+        transition->queryNanoseconds += TLBenchmarkNow() - prepareEnd;
+        return;
+    }
+    TLCoreFrameMetrics metrics;
+    memset(&metrics, 0, sizeof(metrics));
+    metrics.frame = metricsFrameCount++;
+    metrics.progress = progress;
+    metrics.time = progress;
+    size_t interpolated = transition->elementsInterpolated;
+    size_t visible = transition->elementsVisible;
+    uint64_t start = TLCoreMetricsNow();
+    TLBenchmarkSetProgress(transition, progress);
+    uint64_t offsetEnd = TLCoreMetricsNow();
+    TLBenchmarkPrepareLayout(transition);
+    uint64_t prepareEnd = TLCoreMetricsNow();
+    TLBenchmarkQueryVisibleRect(transition);
+    uint64_t queryEnd = TLCoreMetricsNow();
+    metrics.elementsInterpolated = (uint32_t)(transition->elementsInterpolated - interpolated);
+    metrics.rectQueries = 1;
+    metrics.elementsReturned = (uint32_t)(transition->elementsVisible - visible);
+    metrics.contentOffsetNanoseconds = offsetEnd - start;
+    metrics.prepareLayoutNanoseconds = prepareEnd - offsetEnd;
+    metrics.rectQueryNanoseconds = queryEnd - prepareEnd;
+    metrics.totalNanoseconds = queryEnd - start;
+    transition->interpolateNanoseconds += prepareEnd - offsetEnd;
+    transition->queryNanoseconds += queryEnd - prepareEnd;
+    metricsSink.record(metricsSink.context, &metrics);
+}
+
+// Running
+
+static void TLBenchmarkRun(const TLBenchmarkConfig *config, TLBenchmarkMode mode, int frames)
+{
+    TLBenchmarkLayout currentLayout;
+    TLBenchmarkLayout nextLayout;
+    TLBenchmarkBuildLayout(&currentLayout, config, 0);
+    TLBenchmarkBuildLayout(&nextLayout, config, 1);
+
+    size_t setupAllocations = allocationCount;
+    size_t setupBytes = allocatedBytes;
+
+    double start = TLBenchmarkNow();
+
+    TLBenchmarkTransition transition;
+    memset(&transition, 0, sizeof(transition));
+    transition.currentLayout = &currentLayout;
+    transition.nextLayout = &nextLayout;
+    transition.poses = TLBenchmarkAlloc(currentLayout.count * sizeof(TLCorePose));
+
+    // center the middle element, like the Resize example does for a tapped cell
+    size_t placed = currentLayout.count / 2;
+    TLCorePose fromPose = currentLayout.poses[placed];
+    TLCorePose toPose = nextLayout.poses[placed];
+    TLCorePlacementContext context;
+    memset(&context, 0, sizeof(context));
+    context.placement = TLCorePlacementCenter;
+    context.defaultPlacementAnchor = true;
+    context.toSize = (TLCoreSize){TLBenchmarkViewportWidth, TLBenchmarkViewportHeight};
+    context.toContentSize = nextLayout.contentSize;
+    context.fromFrame = (TLCoreRect){{fromPose.center.x - fromPose.size.width / 2, fromPose.center.y - fromPose.size.height / 2}, fromPose.size};
+    context.toFrame = (TLCoreRect){{toPose.center.x - toPose.size.width / 2, toPose.center.y - toPose.size.height / 2}, toPose.size};
+    context.contentOffset = (TLCorePoint){0, fmax(0, context.fromFrame.origin.y - TLBenchmarkViewportHeight / 2)};
+    transition.fromContentOffset = context.contentOffset;
+    transition.contentOffset = context.contentOffset;
+    transition.toContentOffset = TLCoreContentOffsetForPlacement(&context);
+
+    if (recordPath) {
+        recordingTrace = TLCoreTraceCreate();
+        if (!recordingTrace || !TLCoreTraceSetElementCount(recordingTrace, (uint32_t)currentLayout.count)) {
+            fprintf(stderr, "out of memory recording trace\n");
+            exit(1);
+        }
+        memcpy(recordingTrace->fromPoses, currentLayout.poses, currentLayout.count * sizeof(TLCorePose));
+        memcpy(recordingTrace->toPoses, nextLayout.poses, nextLayout.count * sizeof(TLCorePose));
+        recordingTrace->viewportSize = context.toSize;
+        recordingTrace->fromContentOffset = transition.fromContentOffset;
+        recordingTrace->hasToContentOffset = true;
+        recordingTrace->toContentOffset = transition.toContentOffset;
+    }
+
+    // the placement solve and trace setup are reported apart from the frames
+    double setup = TLBenchmarkNow() - start;
+
+    int framesRun = 0;
+    int half = frames / 2 > 0 ? frames / 2 : 1;
+    switch (mode) {
+        case TLBenchmarkModeSweep:
+            for (int frame = 1; frame <= frames; frame++, framesRun++) {
+                TLBenchmarkFrame(&transition, (double)frame / frames);
+            }
+            break;
+        case TLBenchmarkModeReverse:
+            for (int frame = 1; frame <= half; frame++, framesRun++) {
+                TLBenchmarkFrame(&transition, 0.5 * frame / half);
+            }
+            for (int frame = half - 1; frame >= 0; frame--, framesRun++) {
+                TLBenchmarkFrame(&transition, 0.5 * frame / half);
+            }
+            break;
+        case TLBenchmarkModeCancel:
+        {
+            for (int frame = 1; frame <= half; frame++, framesRun++) {
+                TLBenchmarkFrame(&transition, 0.5 * frame / half);
+            }
+            if (recordingTrace) {
+                TLCoreTraceAppendEvent(recordingTrace, TLCoreTraceEventCancel, 0, 0, 0);
+            }
+            // cancelling in place snapshots the current poses into a static layout
+            // (`TLCancelLayout`) and queries it once more at the original offset
+            TLCorePose *snapshot = TLBenchmarkAlloc(currentLayout.count * sizeof(TLCorePose));
+            memcpy(snapshot, transition.poses, currentLayout.count * sizeof(TLCorePose));
+            TLCorePose *poses = transition.poses;
+            transition.poses = snapshot;
+            transition.contentOffset = transition.fromContentOffset;
+            double queryStart = TLBenchmarkNow();
+            TLBenchmarkQueryVisibleRect(&transition);
+            transition.queryNanoseconds += TLBenchmarkNow() - queryStart;
+            transition.poses = poses;
+            free(snapshot);
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (recordingTrace) {
+        FILE *file = fopen(recordPath, "wb");
+        if (!file || !TLCoreTraceWrite(recordingTrace, file)) {
+            perror(recordPath);
+        }
+        if (file) {
+            fclose(file);
+        }
+        TLCoreTraceDestroy(recordingTrace);
+        recordingTrace = NULL;
+        recordPath = NULL;
+    }
+    free(transition.poses);
+
+    size_t frameElements = transition.elementsInterpolated ? transition.elementsInterpolated : 1;
+    printf("{\"benchmark\":\"transition\",\"layout\":\"%s\",\"mode\":\"%s\",\"items\":%zu,\"elements\":%zu,"
+           "\"supplementary\":%s,\"transforms\":%s,\"frames\":%d,\"ns_per_element_frame\":%.3f,"
+           "\"setup_ms\":%.3f,\"interpolate_ms\":%.3f,\"query_ms\":%.3f,\"visible_per_frame\":%.1f,"
+           "\"allocations\":%zu,\"allocated_bytes\":%zu,\"peak_rss_kb\":%ld,\"checksum\":%.3f}\n",
+           TLBenchmarkLayoutNames[config->kind], TLBenchmarkModeNames[mode], config->items, currentLayout.count,
+           config->supplementary ? "true" : "false", config->transforms ? "true" : "false", framesRun,
+           transition.interpolateNanoseconds / frameElements, setup / 1e6,
+           transition.interpolateNanoseconds / 1e6, transition.queryNanoseconds / 1e6, framesRun ? (double)transition.elementsVisible / framesRun : 0,
+           allocationCount - setupAllocations, allocatedBytes - setupBytes,
+           TLBenchmarkPeakMemoryKB(), transition.checksum);
+    fflush(stdout);
+
+    free(currentLayout.poses);
+    free(nextLayout.poses);
+}
+
+// runs in a child process so that `peak_rss_kb` isn't inherited from earlier runs
+static bool TLBenchmarkRunInChild(const TLBenchmarkConfig *config, TLBenchmarkMode mode, int frames)
+{
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        TLBenchmarkRun(config, mode, frames);
+        fflush(NULL);
+        _exit(0);
+    }
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "%s %s run with %zu items failed\n",
+                TLBenchmarkLayoutNames[config->kind], TLBenchmarkModeNames[mode], config->items);
+        return false;
+    }
+    return true;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--items N[,N...]] [--frames N] [--layouts flow,grid,ragged] [--metrics FILE|-]\n"
+            "          [--record FILE]\n"
+            "\n"
+            "Runs 0->1 sweeps, reversals and cancel-in-place over synthetic layouts\n"
+            "with and without supplementary views and transforms. Prints one JSON\n"
+            "object per run. Defaults: --items 1000,10000,100000,1000000 --frames 60\n"
+            "--metrics logs per-frame metrics to FILE, or to stderr for '-'.\n"
+            "--record writes a trace of the first run to FILE for TLTransitionReplay.\n"
+            "'ns_per_element_frame' times only the interpolation, reported as\n"
+            "'interpolate_ms' next to the placement solve ('setup_ms') and the visible\n"
+            "rect queries ('query_ms'). Each run is forked into its own process so that\n"
+            "'peak_rss_kb' covers that run alone.\n"
+            "'allocations' and 'allocated_bytes' count only the benchmark's own buffers,\n"
+            "not allocations made inside the core.\n",
+            program);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t itemCounts[16] = {1000, 10000, 100000, 1000000};
+    int itemCountCount = 4;
+    int frames = 60;
+    bool layouts[TLBenchmarkLayoutCount] = {true, true, true};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--items") == 0 && i + 1 < argc) {
+            itemCountCount = 0;
+            for (char *token = strtok(argv[++i], ","); token && itemCountCount < 16; token = strtok(NULL, ",")) {
+                itemCounts[itemCountCount++] = strtoul(token, NULL, 10);
+            }
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            const char *path = argv[++i];
+            FILE *file = strcmp(path, "-") == 0 ? stderr : fopen(path, "w");
+            if (!file) {
+                perror(path);
+                return 1;
+            }
+            metricsSink = TLCoreMetricsLogSink(file);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--layouts") == 0 && i + 1 < argc) {
+            memset(layouts, 0, sizeof(layouts));
+            for (char *token = strtok(argv[++i], ","); token; token = strtok(NULL, ",")) {
+                for (int kind = 0; kind < TLBenchmarkLayoutCount; kind++) {
+                    if (strcmp(token, TLBenchmarkLayoutNames[kind]) == 0) {
+                        layouts[kind] = true;
+                    }
+                }
+            }
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (frames < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    for (int kind = 0; kind < TLBenchmarkLayoutCount; kind++) {
+        if (!layouts[kind]) {
+            continue;
+        }
+        for (int i = 0; i < itemCountCount; i++) {
+            for (int variant = 0; variant < 4; variant++) {
+                TLBenchmarkConfig config = {kind, itemCounts[i], variant & 1, variant & 2};
+                if (config.items == 0) {
+                    continue;
+                }
+                for (int mode = 0; mode < TLBenchmarkModeCount; mode++) {
+                    if (!TLBenchmarkRunInChild(&config, mode, frames)) {
+                        return 1;
+                    }
+                    // only the first run is recorded
+                    recordPath = NULL;
+                }
+            }
+        }
+    }
+    return 0;
+}
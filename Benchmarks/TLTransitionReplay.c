@@ -0,0 +1,156 @@
+//
+//  TLTransitionReplay.c
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+// Replays a transition trace recorded by `TLTransitionLayout` (see `tracePath`)
+// or by `TLTransitionBenchmark --record` through the portable core and prints
+// frame-time statistics as JSON. Per-frame output is stable across runs apart
+// from timings, so the output of two library versions can be diffed directly.
+
+#include "TLTransitionTrace.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    TLCoreFrameMetrics *frames;
+    size_t count;
+    size_t capacity;
+} TLReplayFrames;
+
+static void TLReplayRecord(void *context, const TLCoreFrameMetrics *metrics)
+{
+    TLReplayFrames *frames = context;
+    if (frames->count == frames->capacity) {
+        size_t capacity = frames->capacity ? frames->capacity * 2 : 256;
+        TLCoreFrameMetrics *resized = realloc(frames->frames, capacity * sizeof(TLCoreFrameMetrics));
+        if (!resized) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        frames->frames = resized;
+        frames->capacity = capacity;
+    }
+    frames->frames[frames->count++] = *metrics;
+}
+
+static int TLReplayCompare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--repeat N] [--frames] TRACE\n"
+            "\n"
+            "Replays TRACE N times (default 5) and reports the fastest time of each\n"
+            "frame across repeats. --frames also prints one JSON object per frame.\n",
+            program);
+}
+
+int main(int argc, char *argv[])
+{
+    int repeat = 5;
+    bool printFrames = false;
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--frames") == 0) {
+            printFrames = true;
+        } else if (!path && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!path || repeat < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return 1;
+    }
+    TLCoreTrace *trace = TLCoreTraceRead(file);
+    fclose(file);
+    if (!trace) {
+        fprintf(stderr, "%s: not a readable transition trace\n", path);
+        return 1;
+    }
+
+    // keep the fastest observation of each frame to filter out scheduling noise
+    TLReplayFrames best = {NULL, 0, 0};
+    for (int r = 0; r < repeat; r++) {
+        TLReplayFrames frames = {NULL, 0, 0};
+        TLCoreTraceReplay(trace, (TLCoreMetricsSink){TLReplayRecord, &frames});
+        if (r == 0) {
+            best = frames;
+            continue;
+        }
+        for (size_t f = 0; f < frames.count && f < best.count; f++) {
+            if (frames.frames[f].totalNanoseconds < best.frames[f].totalNanoseconds) {
+                best.frames[f] = frames.frames[f];
+            }
+        }
+        free(frames.frames);
+    }
+
+    uint64_t *totals = malloc((best.count ? best.count : 1) * sizeof(uint64_t));
+    uint64_t sum = 0;
+    uint64_t dropped = 0;
+    for (size_t f = 0; f < best.count; f++) {
+        const TLCoreFrameMetrics *metrics = &best.frames[f];
+        totals[f] = metrics->totalNanoseconds;
+        sum += metrics->totalNanoseconds;
+        dropped += metrics->droppedFrames;
+        if (printFrames) {
+            printf("{\"frame\":%" PRIu64 ",\"progress\":%.6f,\"time\":%.6f,\"elements\":%" PRIu32 ",\"returned\":%" PRIu32
+                   ",\"recorded_dropped\":%" PRIu32 ",\"prepare_ns\":%" PRIu64 ",\"rect_ns\":%" PRIu64 ",\"total_ns\":%" PRIu64 "}\n",
+                   metrics->frame, metrics->progress, metrics->time, metrics->elementsInterpolated, metrics->elementsReturned,
+                   metrics->droppedFrames, metrics->prepareLayoutNanoseconds, metrics->rectQueryNanoseconds,
+                   metrics->totalNanoseconds);
+        }
+    }
+    qsort(totals, best.count, sizeof(uint64_t), TLReplayCompare);
+
+    size_t count = best.count;
+    double elementFrames = (double)count * trace->elementCount;
+    printf("{\"trace\":\"%s\",\"elements\":%" PRIu32 ",\"events\":%zu,\"frames\":%zu,\"repeat\":%d,"
+           "\"recorded_dropped\":%" PRIu64 ",\"ns_per_element_frame\":%.3f,\"p50_frame_ns\":%" PRIu64
+           ",\"p95_frame_ns\":%" PRIu64 ",\"max_frame_ns\":%" PRIu64 "}\n",
+           path, trace->elementCount, trace->eventCount, count, repeat, dropped,
+           elementFrames > 0 ? sum / elementFrames : 0,
+           count ? totals[count / 2] : 0, count ? totals[count * 95 / 100] : 0, count ? totals[count - 1] : 0);
+
+    free(totals);
+    free(best.frames);
+    TLCoreTraceDestroy(trace);
+    return 0;
+}
@@ -7,12 +7,23 @@
 //
 
 #import "AppDelegate.h"
+#import "UpdatesBenchmark.h"
+#import "DataModelBenchmark.h"
+#import "ParallelBuildBenchmark.h"
 
 @implementation AppDelegate
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions
 {
     // Override point for customization after application launch.
+    // Launch with `-TLRunBenchmarks YES` to log benchmark results.
+    if ([[NSUserDefaults standardUserDefaults] boolForKey:@"TLRunBenchmarks"]) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [UpdatesBenchmark run];
+            [DataModelBenchmark run];
+            [ParallelBuildBenchmark run];
+        });
+    }
     return YES;
 }
 							
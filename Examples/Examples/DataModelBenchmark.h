@@ -0,0 +1,18 @@
+//
+//  DataModelBenchmark.h
+//  Examples
+//
+//  Created by Tim Moose on 10/19/15.
+//  Copyright (c) 2015 Tractable Labs. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Measures the memory footprint and lookup times of `TLIndexPathDataModel` on large
+ synthetic data sets, alongside the equivalent dictionary-based index for reference.
+ Results are logged.
+ */
+@interface DataModelBenchmark : NSObject
++ (void)run;
+@end
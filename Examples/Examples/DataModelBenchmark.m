@@ -0,0 +1,121 @@
+//
+//  DataModelBenchmark.m
+//  Examples
+//
+//  Created by Tim Moose on 10/19/15.
+//  Copyright (c) 2015 Tractable Labs. All rights reserved.
+//
+
+#import "DataModelBenchmark.h"
+#import <QuartzCore/QuartzCore.h>
+#import <mach/mach.h>
+#import <TLIndexPathTools/TLIndexPathTools.h>
+
+static const NSInteger kLookups = 100000;
+
+@implementation DataModelBenchmark
+
++ (void)run
+{
+    for (NSNumber *count in @[@10000, @100000]) {
+        NSInteger n = [count integerValue];
+        NSArray *items = [self itemsWithCount:n];
+        NSArray *indexPaths = [self randomIndexPathsWithCount:n];
+        
+        int64_t footprint = [self footprint];
+        CFTimeInterval start = CACurrentMediaTime();
+        TLIndexPathDataModel *dataModel = [[TLIndexPathDataModel alloc] initWithItems:items];
+        CFTimeInterval buildTime = CACurrentMediaTime() - start;
+        int64_t bytes = [self footprint] - footprint;
+        
+        __block id result;
+        CFTimeInterval itemAtIndexPath = [self timeLookups:^(NSInteger i) {
+            result = [dataModel itemAtIndexPath:indexPaths[i % indexPaths.count]];
+        }];
+        CFTimeInterval identifierAtIndexPath = [self timeLookups:^(NSInteger i) {
+            result = [dataModel identifierAtIndexPath:indexPaths[i % indexPaths.count]];
+        }];
+        CFTimeInterval indexPathForItem = [self timeLookups:^(NSInteger i) {
+            result = [dataModel indexPathForItem:items[(i * 7919) % n]];
+        }];
+        NSLog(@"DataModelBenchmark engine=table items=%ld buildMs=%.1f bytes=%lld bytesPerItem=%.1f itemAtIndexPathNs=%.0f identifierAtIndexPathNs=%.0f indexPathForItemNs=%.0f",
+              (long)n, buildTime * 1000, bytes, (double)bytes / n,
+              itemAtIndexPath * 1e9 / kLookups, identifierAtIndexPath * 1e9 / kLookups, indexPathForItem * 1e9 / kLookups);
+        dataModel = nil;
+        
+        // The dictionary-based index previously used by `TLIndexPathDataModel`
+        footprint = [self footprint];
+        start = CACurrentMediaTime();
+        NSMutableDictionary *itemsByIdentifier = [[NSMutableDictionary alloc] init];
+        NSMutableDictionary *identifiersByIndexPath = [[NSMutableDictionary alloc] init];
+        NSMutableDictionary *indexPathsByIdentifier = [[NSMutableDictionary alloc] init];
+        NSInteger row = 0;
+        for (id item in items) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:row++ inSection:0];
+            [itemsByIdentifier setObject:item forKey:item];
+            [identifiersByIndexPath setObject:item forKey:indexPath];
+            [indexPathsByIdentifier setObject:indexPath forKey:item];
+        }
+        buildTime = CACurrentMediaTime() - start;
+        bytes = [self footprint] - footprint;
+        
+        itemAtIndexPath = [self timeLookups:^(NSInteger i) {
+            NSIndexPath *indexPath = indexPaths[i % indexPaths.count];
+            NSIndexPath *key = [NSIndexPath indexPathForRow:indexPath.row inSection:indexPath.section];
+            result = [itemsByIdentifier objectForKey:[identifiersByIndexPath objectForKey:key]];
+        }];
+        identifierAtIndexPath = [self timeLookups:^(NSInteger i) {
+            NSIndexPath *indexPath = indexPaths[i % indexPaths.count];
+            NSIndexPath *key = [NSIndexPath indexPathForRow:indexPath.row inSection:indexPath.section];
+            result = [identifiersByIndexPath objectForKey:key];
+        }];
+        indexPathForItem = [self timeLookups:^(NSInteger i) {
+            result = [indexPathsByIdentifier objectForKey:items[(i * 7919) % n]];
+        }];
+        NSLog(@"DataModelBenchmark engine=dictionary items=%ld buildMs=%.1f bytes=%lld bytesPerItem=%.1f itemAtIndexPathNs=%.0f identifierAtIndexPathNs=%.0f indexPathForItemNs=%.0f",
+              (long)n, buildTime * 1000, bytes, (double)bytes / n,
+              itemAtIndexPath * 1e9 / kLookups, identifierAtIndexPath * 1e9 / kLookups, indexPathForItem * 1e9 / kLookups);
+    }
+}
+
++ (CFTimeInterval)timeLookups:(void(^)(NSInteger i))lookup
+{
+    CFTimeInterval start = CACurrentMediaTime();
+    @autoreleasepool {
+        for (NSInteger i = 0; i < kLookups; i++) {
+            lookup(i);
+        }
+    }
+    return CACurrentMediaTime() - start;
+}
+
++ (int64_t)footprint
+{
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.phys_footprint;
+}
+
++ (NSArray *)itemsWithCount:(NSInteger)count
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = 0; i < count; i++) {
+        [items addObject:[NSString stringWithFormat:@"item-%ld", (long)i]];
+    }
+    return items;
+}
+
++ (NSArray *)randomIndexPathsWithCount:(NSInteger)count
+{
+    srand48(count);
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:1000];
+    for (NSInteger i = 0; i < 1000; i++) {
+        [indexPaths addObject:[NSIndexPath indexPathForRow:(NSInteger)(drand48() * count) inSection:0]];
+    }
+    return indexPaths;
+}
+
+@end
@@ -0,0 +1,18 @@
+//
+//  ParallelBuildBenchmark.h
+//  Examples
+//
+//  Created by Tim Moose on 10/19/15.
+//  Copyright (c) 2015 Tractable Labs. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Measures how the build time of `TLIndexPathDataModel` scales with the number of threads
+ used to evaluate the identifier and section name blocks on large synthetic data sets.
+ Results are logged.
+ */
+@interface ParallelBuildBenchmark : NSObject
++ (void)run;
+@end
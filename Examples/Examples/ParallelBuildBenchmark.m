@@ -0,0 +1,74 @@
+//
+//  ParallelBuildBenchmark.m
+//  Examples
+//
+//  Created by Tim Moose on 10/19/15.
+//  Copyright (c) 2015 Tractable Labs. All rights reserved.
+//
+
+#import "ParallelBuildBenchmark.h"
+#import <QuartzCore/QuartzCore.h>
+#import <TLIndexPathTools/TLIndexPathTools.h>
+
+static const NSInteger kRuns = 5;
+
+@implementation ParallelBuildBenchmark
+
++ (void)run
+{
+    NSUInteger processors = [NSProcessInfo processInfo].activeProcessorCount;
+    NSMutableArray *concurrencies = [NSMutableArray array];
+    for (NSUInteger concurrency = 1; concurrency < processors; concurrency *= 2) {
+        [concurrencies addObject:@(concurrency)];
+    }
+    [concurrencies addObject:@(processors)];
+    
+    // The blocks parse the section and identifier out of strings of the form
+    // "section-<n>/item-<n>", which is representative of blocks that do some work.
+    NSString *(^sectionNameBlock)(id) = ^NSString *(NSString *item) {
+        return [item substringToIndex:[item rangeOfString:@"/"].location];
+    };
+    id(^identifierBlock)(id) = ^id(NSString *item) {
+        return @([[item substringFromIndex:[item rangeOfString:@"-" options:NSBackwardsSearch].location + 1] integerValue]);
+    };
+    
+    for (NSNumber *count in @[@100000, @500000]) {
+        NSInteger n = [count integerValue];
+        NSArray *items = [self itemsWithCount:n sections:100];
+        CFTimeInterval serialTime = 0;
+        for (NSNumber *concurrency in concurrencies) {
+            CFTimeInterval best = DBL_MAX;
+            NSInteger sections = 0;
+            for (NSInteger run = 0; run < kRuns; run++) {
+                @autoreleasepool {
+                    CFTimeInterval start = CACurrentMediaTime();
+                    TLIndexPathDataModel *dataModel = [[TLIndexPathDataModel alloc] initWithItems:items
+                                                                                 sectionNameBlock:sectionNameBlock
+                                                                                  identifierBlock:identifierBlock
+                                                                                      concurrency:[concurrency unsignedIntegerValue]];
+                    best = MIN(best, CACurrentMediaTime() - start);
+                    sections = dataModel.numberOfSections;
+                }
+            }
+            if ([concurrency unsignedIntegerValue] == 1) {
+                serialTime = best;
+            }
+            NSLog(@"ParallelBuildBenchmark items=%ld sections=%ld concurrency=%lu processors=%lu buildMs=%.1f speedup=%.2f",
+                  (long)n, (long)sections, (unsigned long)[concurrency unsignedIntegerValue], (unsigned long)processors,
+                  best * 1000, serialTime / best);
+        }
+    }
+}
+
++ (NSArray *)itemsWithCount:(NSInteger)count sections:(NSInteger)sections
+{
+    srand48(count);
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = 0; i < count; i++) {
+        NSInteger section = (NSInteger)(drand48() * sections);
+        [items addObject:[NSString stringWithFormat:@"section-%ld/item-%ld", (long)section, (long)i]];
+    }
+    return items;
+}
+
+@end
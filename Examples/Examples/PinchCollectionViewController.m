@@ -19,10 +19,14 @@
 @property (strong, nonatomic) UIPinchGestureRecognizer *pinch;
 @property (nonatomic) CGFloat initialScale;
 @property (nonatomic) BOOL isLayoutInTransition;
+@property (strong, nonatomic) TLLayoutSnapshotCache *snapshotCache;
 @end
 
 static const CGFloat kLargeLayoutScale = 2.5;
 
+// identifies the data for layout snapshots; change it whenever the items change
+static NSString * const kDataVersion = @"200-items";
+
 @implementation PinchCollectionViewController
 
 - (void)viewDidLoad
@@ -47,6 +51,11 @@ static const CGFloat kLargeLayoutScale = 2.5;
     }
     self.indexPathController.items = items;
     
+    // snapshots of the small and large layouts make repeat transitions skip querying
+    // the layouts and survive relaunches in the caches directory
+    NSString *caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    self.snapshotCache = [[TLLayoutSnapshotCache alloc] initWithDirectory:[caches stringByAppendingPathComponent:@"LayoutSnapshots"]];
+    
     self.colors = @[
                     [UIColor colorWithHexRGB:0xBF0C43],
                     [UIColor colorWithHexRGB:0xF9BA15],
@@ -81,6 +90,7 @@ static const CGFloat kLargeLayoutScale = 2.5;
 //                NSLog(@"did cancel");
                 self.collectionView.contentOffset = self.transitionLayout.fromContentOffset;
             }
+            [self cacheSnapshotsOfTransitionLayout:self.transitionLayout];
             self.transitionLayout = nil;
             self.isLayoutInTransition = NO;
         }];
@@ -128,6 +138,7 @@ static const CGFloat kLargeLayoutScale = 2.5;
     UICollectionViewLayout *toLayout = self.smallLayout == self.collectionView.collectionViewLayout ? self.largeLayout : self.smallLayout;
     self.transitionLayout = (TLTransitionLayout *)[self.collectionView startInteractiveTransitionToCollectionViewLayout:toLayout completion:^(BOOL completed, BOOL finish) {
         self.collectionView.contentOffset = self.transitionLayout.toContentOffset;
+        [self cacheSnapshotsOfTransitionLayout:self.transitionLayout];
         self.transitionLayout = nil;
         [[UIApplication sharedApplication] endIgnoringInteractionEvents];
     }];
@@ -137,7 +148,23 @@ static const CGFloat kLargeLayoutScale = 2.5;
 
 - (UICollectionViewTransitionLayout *)collectionView:(UICollectionView *)collectionView transitionLayoutForOldLayout:(UICollectionViewLayout *)fromLayout newLayout:(UICollectionViewLayout *)toLayout
 {
-    return [[TLTransitionLayout alloc] initWithCurrentLayout:fromLayout nextLayout:toLayout];
+    TLTransitionLayout *layout = [[TLTransitionLayout alloc] initWithCurrentLayout:fromLayout nextLayout:toLayout];
+    CGSize size = collectionView.bounds.size;
+    layout.currentLayoutSnapshot = [self.snapshotCache snapshotForLayoutNamed:[self nameForLayout:fromLayout] dataVersion:kDataVersion boundsSize:size];
+    layout.nextLayoutSnapshot = [self.snapshotCache snapshotForLayoutNamed:[self nameForLayout:toLayout] dataVersion:kDataVersion boundsSize:size];
+    layout.capturesLayoutSnapshots = YES;
+    return layout;
+}
+
+- (NSString *)nameForLayout:(UICollectionViewLayout *)layout
+{
+    return layout == self.largeLayout ? @"large" : @"small";
+}
+
+- (void)cacheSnapshotsOfTransitionLayout:(TLTransitionLayout *)layout
+{
+    [self.snapshotCache setSnapshot:layout.currentLayoutSnapshot forLayoutNamed:[self nameForLayout:layout.currentLayout] dataVersion:kDataVersion];
+    [self.snapshotCache setSnapshot:layout.nextLayoutSnapshot forLayoutNamed:[self nameForLayout:layout.nextLayout] dataVersion:kDataVersion];
 }
 
 @end
@@ -152,14 +152,20 @@
                                                  toContentInset:self.collectionView.contentInset];
     layout.toContentOffset = toOffset;
     __weak ResizeCollectionViewController *weakSelf = self;
-    [layout setUpdateLayoutAttributes:^UICollectionViewLayoutAttributes *(UICollectionViewLayoutAttributes *pose, UICollectionViewLayoutAttributes *fromPose, UICollectionViewLayoutAttributes *toPose, CGFloat progress) {
-        CGSize cellSize = pose.bounds.size;
-        UICollectionViewCell *cell = [self.collectionView cellForItemAtIndexPath:pose.indexPath];
-        if (cell) {
-            UILabel *label = (UILabel *)[cell viewWithTag:1];
-            [weakSelf updateLabelScale:label cellSize:cellSize];
+    __weak TLTransitionLayout *weakLayout = layout;
+    [layout setUpdatePoses:^(TLCorePose *poses, const TLCorePose *fromPoses, const TLCorePose *toPoses, const BOOL *visible, NSUInteger count, CGFloat progress) {
+        for (NSUInteger element = 0; element < count; element++) {
+            if (!visible[element]) {
+                continue;
+            }
+            NSString *kind;
+            NSIndexPath *indexPath = [weakLayout indexPathForElement:element kind:&kind];
+            UICollectionViewCell *cell = kind ? nil : [weakSelf.collectionView cellForItemAtIndexPath:indexPath];
+            if (cell) {
+                UILabel *label = (UILabel *)[cell viewWithTag:1];
+                [weakSelf updateLabelScale:label cellSize:CGSizeFromTLCoreSize(poses[element].size)];
+            }
         }
-        return nil;
     }];
 }
 
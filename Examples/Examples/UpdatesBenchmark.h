@@ -0,0 +1,17 @@
+//
+//  UpdatesBenchmark.h
+//  Examples
+//
+//  Created by Tim Moose on 10/19/15.
+//  Copyright (c) 2015 Tractable Labs. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Compares batch update operation counts and diff time of the `TLIndexPathUpdates`
+ move detection modes on synthetic feeds. Results are logged.
+ */
+@interface UpdatesBenchmark : NSObject
++ (void)run;
+@end
@@ -0,0 +1,79 @@
+//
+//  UpdatesBenchmark.m
+//  Examples
+//
+//  Created by Tim Moose on 10/19/15.
+//  Copyright (c) 2015 Tractable Labs. All rights reserved.
+//
+
+#import "UpdatesBenchmark.h"
+#import <QuartzCore/QuartzCore.h>
+#import <TLIndexPathTools/TLIndexPathTools.h>
+
+@implementation UpdatesBenchmark
+
++ (void)run
+{
+    for (NSNumber *count in @[@1000, @10000]) {
+        NSInteger n = [count integerValue];
+        NSArray *feed = [self feedWithCount:n start:0];
+        NSMutableArray *scenarios = [NSMutableArray array];
+
+        NSMutableArray *insertTop = [feed mutableCopy];
+        [insertTop insertObject:@"new-0" atIndex:0];
+        [scenarios addObject:@[@"insert top", insertTop]];
+
+        NSMutableArray *refresh = [feed mutableCopy];
+        [refresh removeObjectsInRange:NSMakeRange(n - 20, 20)];
+        [refresh insertObjects:[self feedWithCount:20 start:n] atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 20)]];
+        [scenarios addObject:@[@"refresh 20", refresh]];
+
+        NSMutableArray *deleteMiddle = [feed mutableCopy];
+        [deleteMiddle removeObjectAtIndex:n / 2];
+        [scenarios addObject:@[@"delete middle", deleteMiddle]];
+
+        NSMutableArray *swap = [feed mutableCopy];
+        [swap exchangeObjectAtIndex:1 withObjectAtIndex:n - 2];
+        [scenarios addObject:@[@"swap", swap]];
+
+        NSMutableArray *shuffle = [feed mutableCopy];
+        srand48(n);
+        for (NSInteger i = 0; i < n / 100; i++) {
+            NSUInteger from = (NSUInteger)(drand48() * n);
+            NSUInteger to = (NSUInteger)(drand48() * (n - 1));
+            id item = shuffle[from];
+            [shuffle removeObjectAtIndex:from];
+            [shuffle insertObject:item atIndex:to];
+        }
+        [scenarios addObject:@[@"shuffle 1%", shuffle]];
+
+        TLIndexPathDataModel *oldDataModel = [[TLIndexPathDataModel alloc] initWithItems:feed];
+        for (NSArray *scenario in scenarios) {
+            TLIndexPathDataModel *updatedDataModel = [[TLIndexPathDataModel alloc] initWithItems:scenario[1]];
+            for (NSNumber *mode in @[@(TLIndexPathUpdatesMoveDetectionIndexPath), @(TLIndexPathUpdatesMoveDetectionMinimal)]) {
+                CFTimeInterval start = CACurrentMediaTime();
+                TLIndexPathUpdates *updates = [[TLIndexPathUpdates alloc] initWithOldDataModel:oldDataModel
+                                                                             updatedDataModel:updatedDataModel
+                                                                  modificationComparatorBlock:nil
+                                                                                moveDetection:[mode integerValue]];
+                CFTimeInterval elapsed = CACurrentMediaTime() - start;
+                NSUInteger operations = updates.insertedItems.count + updates.deletedItems.count + updates.movedItems.count;
+                NSLog(@"UpdatesBenchmark items=%ld scenario=\"%@\" mode=%@ inserts=%lu deletes=%lu moves=%lu operations=%lu diffMs=%.3f",
+                      (long)n, scenario[0], [mode integerValue] == TLIndexPathUpdatesMoveDetectionMinimal ? @"minimal" : @"indexPath",
+                      (unsigned long)updates.insertedItems.count, (unsigned long)updates.deletedItems.count,
+                      (unsigned long)updates.movedItems.count, (unsigned long)operations, elapsed * 1000);
+            }
+        }
+    }
+}
+
++ (NSArray *)feedWithCount:(NSInteger)count start:(NSInteger)start
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSInteger i = start; i < start + count; i++) {
+        [items addObject:[NSString stringWithFormat:@"item-%ld", (long)i]];
+    }
+    return items;
+}
+
+@end
@@ -0,0 +1,71 @@
+//
+//  TLIndexPathDataModelMutationsTests.m
+//  Examples
+//
+//  Created by Tim Moose on 10/19/15.
+//  Copyright (c) 2015 Tractable Labs. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import <TLIndexPathTools/TLIndexPathTools.h>
+
+@interface TLIndexPathDataModelMutationsTests : XCTestCase
+@end
+
+@implementation TLIndexPathDataModelMutationsTests
+
+/*
+ Evaluates every identifier to a new object that's too long to be a tagged pointer, so
+ the data model's identifier table would be left holding the old data model's instances
+ if it didn't re-index rows whose identifiers were evaluated again.
+ */
+- (TLIndexPathDataModel *)dataModelWithItems:(NSArray *)items
+{
+    return [[TLIndexPathDataModel alloc] initWithItems:items sectionNameBlock:nil identifierBlock:^id(id item) {
+        return [NSString stringWithFormat:@"identifier for item %@", item[@"id"]];
+    }];
+}
+
+- (NSArray *)items
+{
+    return @[@{@"id" : @1}, @{@"id" : @2}, @{@"id" : @3}];
+}
+
+- (void)testMoveBackInPlaceOutlivesOldDataModel
+{
+    TLIndexPathDataModel *updatedDataModel;
+    id item;
+    @autoreleasepool {
+        NSArray *items = [self items];
+        item = items[1];
+        TLIndexPathDataModel *dataModel = [self dataModelWithItems:items];
+        TLIndexPathUpdates *updates = [dataModel updatesByPerformingMutations:^(TLIndexPathDataModelMutations *mutations) {
+            [mutations moveItem:item toIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]];
+        }];
+        updatedDataModel = updates.updatedDataModel;
+        XCTAssertEqual(updates.movedItems.count, 0);
+    }
+    XCTAssertEqualObjects([updatedDataModel indexPathForItem:item], [NSIndexPath indexPathForRow:1 inSection:0]);
+    XCTAssertEqualObjects([updatedDataModel itemForIdentifier:@"identifier for item 2"], item);
+    XCTAssertEqual(updatedDataModel.items.count, 3);
+}
+
+- (void)testDeleteAndInsertInPlaceOutlivesOldDataModel
+{
+    TLIndexPathDataModel *updatedDataModel;
+    id item;
+    @autoreleasepool {
+        NSArray *items = [self items];
+        item = items[0];
+        TLIndexPathDataModel *dataModel = [self dataModelWithItems:items];
+        updatedDataModel = [dataModel updatesByPerformingMutations:^(TLIndexPathDataModelMutations *mutations) {
+            [mutations deleteItem:item];
+            [mutations insertItem:item atIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+        }].updatedDataModel;
+    }
+    XCTAssertEqualObjects([updatedDataModel indexPathForItem:item], [NSIndexPath indexPathForRow:0 inSection:0]);
+    XCTAssertEqualObjects([updatedDataModel itemForIdentifier:@"identifier for item 1"], item);
+    XCTAssertEqualObjects([updatedDataModel itemAtIndexPath:[NSIndexPath indexPathForRow:2 inSection:0]], [self items][2]);
+}
+
+@end
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/Collapsible/TLCollapsibleHeaderView.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/Collapsible/TLCollapsibleHeaderView.h
\ No newline at end of file
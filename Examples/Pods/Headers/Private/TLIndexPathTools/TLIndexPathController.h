@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Controllers/TLIndexPathController.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Controllers/TLIndexPathController.h
\ No newline at end of file
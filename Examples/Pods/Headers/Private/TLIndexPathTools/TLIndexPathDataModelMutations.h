@@ -0,0 +1 @@
+../../../../TLIndexPathTools/TLIndexPathTools/Data Model/TLIndexPathDataModelMutations.h
\ No newline at end of file
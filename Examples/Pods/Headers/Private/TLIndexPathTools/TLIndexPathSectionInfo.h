@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Data Model/TLIndexPathSectionInfo.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Data Model/TLIndexPathSectionInfo.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/TLIndexPathTools.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/TLIndexPathTools.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/Tree/TLIndexPathTreeItem.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/Tree/TLIndexPathTreeItem.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Data Model/TLIndexPathUpdates.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Data Model/TLIndexPathUpdates.h
\ No newline at end of file
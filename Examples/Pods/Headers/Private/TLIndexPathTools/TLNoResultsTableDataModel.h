@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/No Results/TLNoResultsTableDataModel.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/No Results/TLNoResultsTableDataModel.h
\ No newline at end of file
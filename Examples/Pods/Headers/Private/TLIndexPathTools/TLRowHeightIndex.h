@@ -0,0 +1 @@
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/TLRowHeightIndex.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/Tree/TLTreeDataModel.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/Tree/TLTreeDataModel.h
\ No newline at end of file
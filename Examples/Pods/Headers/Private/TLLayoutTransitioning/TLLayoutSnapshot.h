@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/TLLayoutSnapshot.h
\ No newline at end of file
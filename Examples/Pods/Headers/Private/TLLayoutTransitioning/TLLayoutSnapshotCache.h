@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/TLLayoutSnapshotCache.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/Core/TLTransitionSnapshot.h
\ No newline at end of file
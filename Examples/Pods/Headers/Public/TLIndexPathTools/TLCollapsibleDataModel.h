@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/Collapsible/TLCollapsibleDataModel.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/Collapsible/TLCollapsibleDataModel.h
\ No newline at end of file
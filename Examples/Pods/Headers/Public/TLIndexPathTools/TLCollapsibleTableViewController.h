@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/Collapsible/TLCollapsibleTableViewController.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/Collapsible/TLCollapsibleTableViewController.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/View Controllers/TLCollectionViewController.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/View Controllers/TLCollectionViewController.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/TLDynamicHeightCell.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/TLDynamicHeightCell.h
\ No newline at end of file
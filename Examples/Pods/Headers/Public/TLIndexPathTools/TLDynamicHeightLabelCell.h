@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/TLDynamicHeightLabelCell.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/TLDynamicHeightLabelCell.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/View Controllers/TLDynamicSizeView.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/View Controllers/TLDynamicSizeView.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/View Controllers/TLTableViewController.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/View Controllers/TLTableViewController.h
\ No newline at end of file
@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/Tree/TLTreeTableViewController.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/Tree/TLTreeTableViewController.h
\ No newline at end of file
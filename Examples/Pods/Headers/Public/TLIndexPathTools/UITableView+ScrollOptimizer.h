@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/UITableView+ScrollOptimizer.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/UITableView+ScrollOptimizer.h
\ No newline at end of file
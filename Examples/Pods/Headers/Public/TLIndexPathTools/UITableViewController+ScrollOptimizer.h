@@ -1 +1 @@
-../../../TLIndexPathTools/TLIndexPathTools/Extensions/UITableViewController+ScrollOptimizer.h
\ No newline at end of file
+../../../../TLIndexPathTools/TLIndexPathTools/Extensions/UITableViewController+ScrollOptimizer.h
\ No newline at end of file
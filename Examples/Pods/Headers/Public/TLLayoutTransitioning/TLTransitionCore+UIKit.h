@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/TLTransitionCore+UIKit.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/Core/TLTransitionCore.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/Core/TLTransitionMetrics.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/TLTransitionSignpost.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../../../TLLayoutTransitioning/Core/TLTransitionTrace.h
\ No newline at end of file
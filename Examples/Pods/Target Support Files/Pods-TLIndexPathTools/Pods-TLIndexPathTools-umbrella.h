@@ -2,6 +2,7 @@
 
 #import "TLIndexPathController.h"
 #import "TLIndexPathDataModel.h"
+#import "TLIndexPathDataModelMutations.h"
 #import "TLIndexPathItem.h"
 #import "TLIndexPathSectionInfo.h"
 #import "TLIndexPathUpdates.h"
@@ -12,6 +13,7 @@
 #import "TLDynamicHeightCell.h"
 #import "TLDynamicHeightLabelCell.h"
 #import "TLIndexPathTreeItem.h"
+#import "TLRowHeightIndex.h"
 #import "TLTreeDataModel.h"
 #import "TLTreeTableViewController.h"
 #import "UITableView+ScrollOptimizer.h"
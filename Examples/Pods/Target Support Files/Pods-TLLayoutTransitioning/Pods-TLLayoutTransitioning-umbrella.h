@@ -3,6 +3,14 @@
 #import "TLLayoutTransitioning.h"
 #import "TLTransitionLayout.h"
 #import "UICollectionView+TLTransitioning.h"
+#import "TLTransitionCore.h"
+#import "TLTransitionCore+UIKit.h"
+#import "TLTransitionMetrics.h"
+#import "TLTransitionSignpost.h"
+#import "TLTransitionTrace.h"
+#import "TLTransitionSnapshot.h"
+#import "TLLayoutSnapshot.h"
+#import "TLLayoutSnapshotCache.h"
 
 FOUNDATION_EXPORT double TLLayoutTransitioningVersionNumber;
 FOUNDATION_EXPORT const unsigned char TLLayoutTransitioningVersionString[];
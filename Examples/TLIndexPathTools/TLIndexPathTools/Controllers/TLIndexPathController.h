@@ -242,6 +242,33 @@ extern NSString * kTLIndexPathUpdatesKey;
  */
 @property (nonatomic) BOOL ignoreDataModelChanges;
 
+/**
+ Determines whether data models and diffs are computed off the main thread.
+
+ When YES, setting `items` or `dataModel` returns immediately. The new data model
+ (when setting `items`) and the `TLIndexPathUpdates` are built on a private serial
+ queue and the finished updates are delivered to `controller:didUpdateDataModel:`
+ on the main queue. The `dataModel` and `items` properties continue to return the
+ last delivered values until then, so they stay consistent with the table or
+ collection view. Updates that are superseded before their work begins are coalesced
+ into the next update.
+
+ In this mode, `controller:willUpdateDataModel:withDataModel:` is called on the
+ private queue, so implementations must not touch UIKit. Core Data fetch results
+ are still converted to data models on the main queue, but are diffed in the background.
+ The `completion` block of `performBatchUpdates:completion:` is called after the
+ update is delivered, with `finished` equal to NO if the update was coalesced.
+
+ Default value is NO. This property should not be changed while updates are pending.
+ */
+@property (nonatomic) BOOL performsUpdatesAsynchronously;
+
+/**
+ The move detection used when computing updates. Default value is
+ `TLIndexPathUpdatesMoveDetectionIndexPath`.
+ */
+@property (nonatomic) TLIndexPathUpdatesMoveDetection moveDetection;
+
 #pragma mark - Accessing and updating data
 /** @name Accessing and updating data */
 
@@ -267,6 +294,20 @@ extern NSString * kTLIndexPathUpdatesKey;
  */
 @property (strong, nonatomic, nullable) TLIndexPathDataModel *dataModel;
 
+/**
+ Sets the data model to `updates.updatedDataModel` and delivers the given updates to
+ the delegate without diffing the data models. Use this with updates that were derived
+ incrementally, such as those returned by `[TLIndexPathDataModel updatesByPerformingMutations:]`.
+ 
+ The updates are recomputed by diffing, as if `dataModel` had been set, if
+ `updates.oldDataModel` isn't the current data model, if the delegate's
+ `controller:willUpdateDataModel:withDataModel:` returns a different data model,
+ during batch updates or when `performsUpdatesAsynchronously` is YES.
+ 
+ @param updates  the updates to apply
+ */
+- (void)setDataModelWithUpdates:(TLIndexPathUpdates *)updates;
+
 #pragma mark - Batch updates
 /** @name Batch updates */
 
@@ -331,6 +372,10 @@ extern NSString * kTLIndexPathUpdatesKey;
  result. If the controller is already fetched, it is not necessary to call
  `performFetch:` again after setting this property because the batch updates
  are processed immediately.
+ 
+ When the new predicate is stricter than the previous one, for example a `BEGINSWITH`
+ or `CONTAINS` comparison against a longer string, only the current result is
+ filtered rather than the full fetched result.
  */
 @property (strong, nonatomic, nullable) NSPredicate *inMemoryPredicate;
 
@@ -341,9 +386,28 @@ extern NSString * kTLIndexPathUpdatesKey;
  underlying fetched result. If the controller is already fetched, it is not necessary
  to call `performFetch:` again after setting this property because the batch
  updates are processed immediately.
+ 
+ Sort keys are extracted once per object and cached until the object changes, so
+ re-sorting does not repeat key-value coding lookups in every comparison.
  */
 @property (strong, nonatomic, nullable) NSArray *inMemorySortDescriptors;
 
+/**
+ The maximum ratio of changed objects to items for which fetched results changes are
+ applied incrementally. Default value is 0.1.
+ 
+ When the fetched results change, the inserted, deleted, moved and updated objects are
+ applied directly to the current data model. The in-memory predicate is only evaluated
+ on the changed objects and they are placed by binary search using the in-memory sort
+ descriptors, or the fetch request's sort descriptors if there are none. The updates
+ are derived from these changes rather than by diffing. If more objects change than
+ this ratio allows, or the changes add or remove sections or could change the order of
+ sections, a new data model is built from all fetched objects instead. Changes are
+ also applied by rebuilding during batch updates and when `performsUpdatesAsynchronously`
+ is YES. Set this to 0 to always rebuild.
+ */
+@property (nonatomic) double maximumIncrementalChangeRatio;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,964 @@
+//
+//  TLIndexPathController.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "TLIndexPathController.h"
+#import "TLIndexPathItem.h"
+#import "TLIndexPathUpdates.h"
+#import "TLIndexPathDataModelMutations.h"
+
+NSString * const TLIndexPathControllerChangedNotification = @"TLIndexPathControllerChangedNotification";
+NSString * kTLIndexPathControllerChangedNotification = @"kTLIndexPathControllerChangedNotification";
+NSString * kTLIndexPathUpdatesKey = @"kTLIndexPathUpdatesKey";
+
+@interface TLIndexPathDataModel (TLIndexPathController)
+- (NSString *)sectionNameForItem:(id)item;
+@end
+
+#pragma mark - Predicate refinement
+
+static NSStringCompareOptions TLStringCompareOptionsForPredicateOptions(NSComparisonPredicateOptions options)
+{
+    NSStringCompareOptions compareOptions = 0;
+    if (options & NSCaseInsensitivePredicateOption) {
+        compareOptions |= NSCaseInsensitiveSearch;
+    }
+    if (options & NSDiacriticInsensitivePredicateOption) {
+        compareOptions |= NSDiacriticInsensitiveSearch;
+    }
+    return compareOptions;
+}
+
+/*
+ Returns YES if every object matching `predicate` is known to match `previousPredicate`,
+ in which case filtering the objects that matched `previousPredicate` gives the same
+ result as filtering all objects. Recognizes equal predicates, AND and OR combinations
+ and BEGINSWITH and CONTAINS comparisons of the same key path against a string that
+ extends the previous string, such as a longer type-ahead prefix.
+ */
+static BOOL TLPredicateRefinesPredicate(NSPredicate *predicate, NSPredicate *previousPredicate)
+{
+    if (!previousPredicate || [predicate isEqual:previousPredicate]) {
+        return YES;
+    }
+    if (!predicate) {
+        return NO;
+    }
+    if ([previousPredicate isKindOfClass:[NSCompoundPredicate class]]) {
+        NSCompoundPredicate *previousCompound = (NSCompoundPredicate *)previousPredicate;
+        if (previousCompound.compoundPredicateType == NSAndPredicateType) {
+            for (NSPredicate *previousSubpredicate in previousCompound.subpredicates) {
+                if (!TLPredicateRefinesPredicate(predicate, previousSubpredicate)) {
+                    return NO;
+                }
+            }
+            return YES;
+        }
+        if (previousCompound.compoundPredicateType == NSOrPredicateType) {
+            for (NSPredicate *previousSubpredicate in previousCompound.subpredicates) {
+                if (TLPredicateRefinesPredicate(predicate, previousSubpredicate)) {
+                    return YES;
+                }
+            }
+        }
+        return NO;
+    }
+    if ([predicate isKindOfClass:[NSCompoundPredicate class]]) {
+        NSCompoundPredicate *compound = (NSCompoundPredicate *)predicate;
+        if (compound.compoundPredicateType == NSAndPredicateType) {
+            for (NSPredicate *subpredicate in compound.subpredicates) {
+                if (TLPredicateRefinesPredicate(subpredicate, previousPredicate)) {
+                    return YES;
+                }
+            }
+        }
+        return NO;
+    }
+    if (![predicate isKindOfClass:[NSComparisonPredicate class]] || ![previousPredicate isKindOfClass:[NSComparisonPredicate class]]) {
+        return NO;
+    }
+    NSComparisonPredicate *comparison = (NSComparisonPredicate *)predicate;
+    NSComparisonPredicate *previousComparison = (NSComparisonPredicate *)previousPredicate;
+    if (comparison.predicateOperatorType != previousComparison.predicateOperatorType
+        || comparison.comparisonPredicateModifier != previousComparison.comparisonPredicateModifier
+        || comparison.options != previousComparison.options
+        || ![comparison.leftExpression isEqual:previousComparison.leftExpression]
+        || comparison.rightExpression.expressionType != NSConstantValueExpressionType
+        || previousComparison.rightExpression.expressionType != NSConstantValueExpressionType) {
+        return NO;
+    }
+    id value = comparison.rightExpression.constantValue;
+    id previousValue = previousComparison.rightExpression.constantValue;
+    if (![value isKindOfClass:[NSString class]] || ![previousValue isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+    NSStringCompareOptions compareOptions = TLStringCompareOptionsForPredicateOptions(comparison.options);
+    switch (comparison.predicateOperatorType) {
+        case NSBeginsWithPredicateOperatorType:
+            return [value rangeOfString:previousValue options:compareOptions | NSAnchoredSearch].location != NSNotFound;
+        case NSContainsPredicateOperatorType:
+            return [value rangeOfString:previousValue options:compareOptions].location != NSNotFound;
+        default:
+            return NO;
+    }
+}
+
+@interface TLIndexPathController ()
+@property (strong, nonatomic) NSFetchedResultsController *backingController;
+@property (strong, nonatomic) TLIndexPathDataModel *oldDataModel;
+@property (nonatomic) BOOL performingBatchUpdate;
+@property (nonatomic) BOOL pendingConvertFetchedObjectsToDataModel;
+@property (strong, nonatomic) NSMutableArray *updatedItems;
+@property (strong, nonatomic) dispatch_queue_t updateQueue;
+@property (strong, nonatomic) TLIndexPathDataModel *(^pendingDataModelBlock)(void);
+@property (atomic) NSUInteger updateGeneration;
+// accessed only on `updateQueue`
+@property (strong, nonatomic) TLIndexPathDataModel *queuedDataModel;
+@property (strong, nonatomic) NSMutableArray *queuedUpdatedItems;
+// the data model most recently built from the fetched objects, to which fetched
+// results changes are applied incrementally. `nil` if it may be stale.
+@property (strong, nonatomic) TLIndexPathDataModel *fetchedDataModel;
+// objects reported by the fetched results controller since `controllerWillChangeContent:`.
+// Updated and moved objects are both treated as changed.
+@property (strong, nonatomic) NSMutableOrderedSet *insertedObjects;
+@property (strong, nonatomic) NSMutableOrderedSet *deletedObjects;
+@property (strong, nonatomic) NSMutableOrderedSet *changedObjects;
+// the filtered and sorted fetched objects from which `fetchedDataModel` was built and the
+// in-memory predicate and sort descriptors used. `nil` once the fetched objects change.
+@property (strong, nonatomic) NSArray *filteredObjects;
+@property (strong, nonatomic) NSPredicate *filteredObjectsPredicate;
+@property (strong, nonatomic) NSArray *filteredObjectsSortDescriptors;
+// sort keys extracted from each object for `sortKeyPaths`, so sorting doesn't go through KVC
+@property (strong, nonatomic) NSMapTable *sortKeysByObject;
+@property (copy, nonatomic) NSArray *sortKeyPaths;
+@end
+
+@implementation TLIndexPathController
+
+- (void)dealloc {
+    //the delegate property is an 'assign' property
+    //not technically needed because the FRC will dealloc when we do, but it's a good idea.
+    self.backingController.delegate = nil;
+}
+
+#pragma mark - Creating controllers
+
+- (instancetype)initWithItems:(NSArray *)items
+{
+    TLIndexPathDataModel *dataModel = [[TLIndexPathDataModel alloc] initWithItems:items sectionNameKeyPath:nil identifierKeyPath:nil];
+    return [self initWithDataModel:dataModel];
+}
+
+- (instancetype)initWithDataModel:(TLIndexPathDataModel *)dataModel
+{
+    if (self = [super init]) {
+        _dataModel = dataModel;
+        _maximumIncrementalChangeRatio = 0.1;
+    }
+    return self;
+}
+
+- (id)initWithFetchRequest:(NSFetchRequest *)fetchRequest managedObjectContext:(NSManagedObjectContext *)context sectionNameKeyPath:(NSString *)sectionNameKeyPath identifierKeyPath:(NSString *)identifierKeyPath cacheName:(NSString *)name
+{
+    TLIndexPathDataModel *dataModel = [[TLIndexPathDataModel alloc] initWithItems:@[] sectionNameKeyPath:sectionNameKeyPath identifierKeyPath:identifierKeyPath];
+    if (self = [self initWithDataModel:dataModel]) {
+        //initialize the backing controller with nil sectionNameKeyPath because we don't require
+        //items to be sorted by section, but NSFetchedResultsController does.
+        _backingController = [[NSFetchedResultsController alloc] initWithFetchRequest:fetchRequest managedObjectContext:context sectionNameKeyPath:sectionNameKeyPath cacheName:name];
+        _backingController.delegate = self;
+    }
+    return self;
+}
+
+#pragma mark - Configuration information
+
+- (void)setFetchRequest:(NSFetchRequest *)fetchRequest
+{
+    if (![self.fetchRequest isEqual:fetchRequest]) {
+        self.backingController = [[NSFetchedResultsController alloc]
+                                  initWithFetchRequest:fetchRequest
+                                  managedObjectContext:self.backingController.managedObjectContext
+                                  sectionNameKeyPath:self.backingController.sectionNameKeyPath
+                                  cacheName:self.backingController.cacheName];
+        self.backingController.delegate = self;
+    }
+}
+
+- (NSFetchRequest *)fetchRequest
+{
+    return self.backingController.fetchRequest;
+}
+
+- (void)setManagedObjectContext:(NSManagedObjectContext *)managedObjectContext
+{
+    if (![self.managedObjectContext isEqual:managedObjectContext]) {
+        self.backingController = [[NSFetchedResultsController alloc]
+                                  initWithFetchRequest:self.backingController.fetchRequest
+                                  managedObjectContext:managedObjectContext
+                                  sectionNameKeyPath:self.backingController.sectionNameKeyPath
+                                  cacheName:self.backingController.cacheName];
+        self.backingController.delegate = self;
+    }
+}
+
+- (NSManagedObjectContext *)managedObjectContext
+{
+    return self.backingController.managedObjectContext;
+}
+
+- (void)setCacheName:(NSString *)cacheName
+{
+    if (![self.cacheName isEqual:cacheName]) {
+        self.backingController = [[NSFetchedResultsController alloc]
+                                  initWithFetchRequest:self.backingController.fetchRequest
+                                  managedObjectContext:self.backingController.managedObjectContext
+                                  sectionNameKeyPath:self.backingController.sectionNameKeyPath
+                                  cacheName:cacheName];
+        self.backingController.delegate = self;
+    }
+}
+
+- (NSString *)cacheName
+{
+    return self.backingController.cacheName;
+}
+
++ (void)deleteCacheWithName:(NSString *)name
+{
+    [NSFetchedResultsController deleteCacheWithName:name];
+}
+
+- (void)setIgnoreFetchedResultsChanges:(BOOL)ignoreFetchedResultsChanges
+{
+    if (_ignoreFetchedResultsChanges != ignoreFetchedResultsChanges) {
+        _ignoreFetchedResultsChanges = ignoreFetchedResultsChanges;
+        //if fetch was ever performed, automatically re-perform fetch when
+        //ignoring is disabled.
+        if (NO == ignoreFetchedResultsChanges && self.isFetched) {
+            [self invalidateFilteredObjects];
+            self.dataModel = [self convertFetchedObjectsToDataModel];
+        }
+    }
+}
+
+#pragma mark - Accessing and updating
+
+- (NSArray *)items
+{
+    return self.dataModel.items;
+}
+
+- (void)setItems:(NSArray *)items
+{
+    if (items ==  nil) {
+        self.dataModel = nil;
+    }
+    
+    else {
+        id last = [items lastObject];
+        BOOL indexPathItems = [last isKindOfClass:[TLIndexPathItem class]];
+        NSString *sectionNameKeyPath = self.dataModel.sectionNameKeyPath;
+        NSString *identifierKeyPath = self.dataModel.identifierKeyPath;
+        TLIndexPathDataModel *(^dataModelBlock)(void) = ^TLIndexPathDataModel *{
+            if (indexPathItems) {
+                return [[TLIndexPathDataModel alloc] initWithItems:items];
+            }
+            return [[TLIndexPathDataModel alloc] initWithItems:items
+                                            sectionNameKeyPath:sectionNameKeyPath
+                                             identifierKeyPath:identifierKeyPath];
+        };
+        if (self.performsUpdatesAsynchronously) {
+            [self setPendingDataModelBlock:dataModelBlock];
+        } else {
+            self.dataModel = dataModelBlock();
+        }
+    }
+}
+
+- (void)setDataModel:(TLIndexPathDataModel *)dataModel
+{
+    if (self.performsUpdatesAsynchronously) {
+        [self setPendingDataModelBlock:^TLIndexPathDataModel *{
+            return dataModel;
+        }];
+        return;
+    }
+    
+    //any explicitly set data model overrides pending conversion of fetched objects
+    self.pendingConvertFetchedObjectsToDataModel = NO;
+    
+    //data model may get set multiple times during batch udpates,
+    //so make sure we remember the initial old data model (which will
+    //get cleared in `performUpdates` when the batch updates complete).
+    if (!self.oldDataModel) {
+        self.oldDataModel = _dataModel;
+    }
+    
+    _dataModel = dataModel;
+    
+    //perform udpates immediately unless we're in batch update mode
+    if (!self.performingBatchUpdate) {
+        [self dequeuePendingUpdates];
+    }
+}
+
+- (void)setDataModelWithUpdates:(TLIndexPathUpdates *)updates
+{
+    if (self.performingBatchUpdate || self.performsUpdatesAsynchronously || updates.oldDataModel != _dataModel) {
+        self.dataModel = updates.updatedDataModel;
+        return;
+    }
+    
+    self.pendingConvertFetchedObjectsToDataModel = NO;
+    
+    if ([self.delegate respondsToSelector:@selector(controller:willUpdateDataModel:withDataModel:)]) {
+        TLIndexPathDataModel *dataModel = [self.delegate controller:self willUpdateDataModel:_dataModel withDataModel:updates.updatedDataModel];
+        if (dataModel && dataModel != updates.updatedDataModel) {
+            updates = [[TLIndexPathUpdates alloc] initWithOldDataModel:_dataModel
+                                                      updatedDataModel:dataModel
+                                           modificationComparatorBlock:nil
+                                                         moveDetection:self.moveDetection];
+        }
+    }
+    
+    [self deliverUpdates:updates];
+}
+
+- (void)dequeuePendingUpdates
+{
+    [self dequeuePendingUpdatesWithCompletion:nil];
+}
+
+- (void)dequeuePendingUpdatesWithCompletion:(void (^)(BOOL finished))completion
+{
+    if (self.performsUpdatesAsynchronously) {
+        [self dequeuePendingUpdatesAsynchronouslyWithCompletion:completion];
+        return;
+    }
+    if ([self.delegate respondsToSelector:@selector(controller:willUpdateDataModel:withDataModel:)]) {
+        TLIndexPathDataModel *dataModel = [self.delegate controller:self willUpdateDataModel:self.oldDataModel withDataModel:self.dataModel];
+        if (dataModel) {
+            //bypass the property setter here because we don't need any of that logic
+            _dataModel = dataModel;
+        }
+    }
+    TLIndexPathUpdates *updates = [[TLIndexPathUpdates alloc] initWithOldDataModel:self.oldDataModel
+                                                                  updatedDataModel:self.dataModel
+                                                       modificationComparatorBlock:nil
+                                                                     moveDetection:self.moveDetection];
+    if ([self.updatedItems count]) {
+        // TODO this should probably check for duplicates
+        if (updates.modifiedItems) {
+            [self.updatedItems addObjectsFromArray:updates.modifiedItems];
+        }
+        #pragma clang diagnostic ignored "-Wundeclared-selector"
+        [updates performSelector:@selector(setModifiedItems:) withObject:self.updatedItems];
+        #pragma clang diagnostic pop
+        [self.updatedItems removeAllObjects];
+    }
+    if ([self.delegate respondsToSelector:@selector(controller:didUpdateDataModel:)] && !self.ignoreDataModelChanges) {
+        [self.delegate controller:self didUpdateDataModel:updates];
+    }
+    NSDictionary *info = @{kTLIndexPathUpdatesKey : updates};
+    [[NSNotificationCenter defaultCenter] postNotificationName:kTLIndexPathControllerChangedNotification object:self userInfo:info];
+    self.oldDataModel = nil;
+    if (completion) {
+        completion(YES);
+    }
+}
+
+#pragma mark - Asynchronous updates
+
+- (void)setPerformsUpdatesAsynchronously:(BOOL)performsUpdatesAsynchronously
+{
+    if (_performsUpdatesAsynchronously != performsUpdatesAsynchronously) {
+        _performsUpdatesAsynchronously = performsUpdatesAsynchronously;
+        if (performsUpdatesAsynchronously && !self.updateQueue) {
+            self.updateQueue = dispatch_queue_create("com.tractablelabs.TLIndexPathController.updates", DISPATCH_QUEUE_SERIAL);
+        }
+        // discard the background queue's notion of the current data model
+        // since the synchronous path may change it
+        dispatch_queue_t updateQueue = self.updateQueue;
+        dispatch_async(updateQueue, ^{
+            self.queuedDataModel = nil;
+        });
+    }
+}
+
+- (void)setPendingDataModelBlock:(TLIndexPathDataModel *(^)(void))pendingDataModelBlock
+{
+    //any explicitly set data model overrides pending conversion of fetched objects
+    self.pendingConvertFetchedObjectsToDataModel = NO;
+    _pendingDataModelBlock = pendingDataModelBlock;
+    //perform udpates immediately unless we're in batch update mode
+    if (!self.performingBatchUpdate) {
+        [self dequeuePendingUpdates];
+    }
+}
+
+/*
+ Builds the data model and updates on `updateQueue` and delivers them on the main queue.
+ Updates are delivered in the order they're computed and each one is diffed against
+ the previously computed data model. A request that has been superseded by the time
+ its work begins is skipped and its modified items are carried over to the next request.
+ */
+- (void)dequeuePendingUpdatesAsynchronouslyWithCompletion:(void (^)(BOOL finished))completion
+{
+    TLIndexPathDataModel *(^dataModelBlock)(void) = self.pendingDataModelBlock;
+    _pendingDataModelBlock = nil;
+    NSArray *updatedItems = [self.updatedItems copy] ?: @[];
+    [self.updatedItems removeAllObjects];
+    TLIndexPathDataModel *currentDataModel = _dataModel;
+    NSUInteger generation = self.updateGeneration + 1;
+    self.updateGeneration = generation;
+    TLIndexPathUpdatesMoveDetection moveDetection = self.moveDetection;
+    
+    __weak TLIndexPathController *weakSelf = self;
+    dispatch_async(self.updateQueue, ^{
+        TLIndexPathController *strongSelf = weakSelf;
+        if (!strongSelf) {
+            return;
+        }
+        if (!strongSelf.queuedUpdatedItems) {
+            strongSelf.queuedUpdatedItems = [NSMutableArray array];
+        }
+        [strongSelf.queuedUpdatedItems addObjectsFromArray:updatedItems];
+        
+        if (generation != strongSelf.updateGeneration) {
+            // superseded by a later update
+            if (completion) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    completion(NO);
+                });
+            }
+            return;
+        }
+        
+        TLIndexPathDataModel *oldDataModel = strongSelf.queuedDataModel ?: currentDataModel;
+        TLIndexPathDataModel *dataModel = dataModelBlock ? dataModelBlock() : oldDataModel;
+        id<TLIndexPathControllerDelegate> delegate = strongSelf.delegate;
+        if ([delegate respondsToSelector:@selector(controller:willUpdateDataModel:withDataModel:)]) {
+            TLIndexPathDataModel *replacementDataModel = [delegate controller:strongSelf willUpdateDataModel:oldDataModel withDataModel:dataModel];
+            if (replacementDataModel) {
+                dataModel = replacementDataModel;
+            }
+        }
+        TLIndexPathUpdates *updates = [[TLIndexPathUpdates alloc] initWithOldDataModel:oldDataModel
+                                                                      updatedDataModel:dataModel
+                                                           modificationComparatorBlock:nil
+                                                                         moveDetection:moveDetection];
+        if ([strongSelf.queuedUpdatedItems count]) {
+            NSMutableArray *modifiedItems = strongSelf.queuedUpdatedItems;
+            if (updates.modifiedItems) {
+                [modifiedItems addObjectsFromArray:updates.modifiedItems];
+            }
+            #pragma clang diagnostic ignored "-Wundeclared-selector"
+            [updates performSelector:@selector(setModifiedItems:) withObject:modifiedItems];
+            #pragma clang diagnostic pop
+            strongSelf.queuedUpdatedItems = nil;
+        }
+        strongSelf.queuedDataModel = dataModel;
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [strongSelf deliverUpdates:updates];
+            if (completion) {
+                completion(YES);
+            }
+        });
+    });
+}
+
+- (void)deliverUpdates:(TLIndexPathUpdates *)updates
+{
+    _dataModel = updates.updatedDataModel;
+    if ([self.delegate respondsToSelector:@selector(controller:didUpdateDataModel:)] && !self.ignoreDataModelChanges) {
+        [self.delegate controller:self didUpdateDataModel:updates];
+    }
+    NSDictionary *info = @{kTLIndexPathUpdatesKey : updates};
+    [[NSNotificationCenter defaultCenter] postNotificationName:kTLIndexPathControllerChangedNotification object:self userInfo:info];
+}
+
+#pragma mark - Batch updates
+
+- (void)performBatchUpdates:(void (^)(void))updates completion:(void (^)(BOOL))completion
+{
+    self.performingBatchUpdate = YES;
+    
+    if (updates) {
+        updates();
+    }
+    
+    if (self.pendingConvertFetchedObjectsToDataModel) {
+        self.dataModel = [self convertFetchedObjectsToDataModel];
+    }
+    
+    //the batch update is over by the time the completion runs, so data model changes
+    //made from it are applied rather than deferred. When updates are delivered
+    //synchronously, the completion runs before `dequeuePendingUpdatesWithCompletion:`
+    //returns, so the flag has to be reset there.
+    __block BOOL dequeuing = YES;
+    [self dequeuePendingUpdatesWithCompletion:^(BOOL finished) {
+        if (dequeuing) {
+            self.performingBatchUpdate = NO;
+        }
+        if (completion) {
+            completion(finished);
+        }
+    }];
+    dequeuing = NO;
+    
+    self.performingBatchUpdate = NO;
+}
+
+#pragma mark - Core Data Integration
+
+- (BOOL)performFetch:(NSError *__autoreleasing *)error
+{
+    BOOL result = [self.backingController performFetch:error];
+    [self invalidateFilteredObjects];
+    self.sortKeysByObject = nil;
+    if (self.performingBatchUpdate) {
+        self.pendingConvertFetchedObjectsToDataModel = YES;
+    } else {
+        self.dataModel = [self convertFetchedObjectsToDataModel];
+    }
+    self.isFetched = YES;
+    return result;
+}
+
+- (NSArray *)coreDataFetchedObjects
+{
+    return self.backingController.fetchedObjects;
+}
+
+- (void)setInMemoryPredicate:(NSPredicate *)inMemoryPredicate
+{
+    if (_inMemoryPredicate != inMemoryPredicate) {
+        _inMemoryPredicate = inMemoryPredicate;
+        if (self.performingBatchUpdate) {
+            self.pendingConvertFetchedObjectsToDataModel = YES;
+        } else {
+            self.dataModel = [self convertFetchedObjectsToDataModel];
+        }
+    }
+}
+
+- (void)setInMemorySortDescriptors:(NSArray *)inMemorySortDescriptors
+{
+    if (![_inMemorySortDescriptors isEqualToArray:inMemorySortDescriptors]) {
+        _inMemorySortDescriptors = inMemorySortDescriptors;
+        if (self.performingBatchUpdate) {
+            self.pendingConvertFetchedObjectsToDataModel = YES;
+        } else {
+            self.dataModel = [self convertFetchedObjectsToDataModel];
+        }
+    }
+}
+
+- (TLIndexPathDataModel *)convertFetchedObjectsToDataModel {
+    NSArray *sortedFilteredItems;
+    NSPredicate *predicate = self.inMemoryPredicate;
+    NSArray *sortDescriptors = self.inMemorySortDescriptors;
+    BOOL sortUnchanged = sortDescriptors == self.filteredObjectsSortDescriptors || [sortDescriptors isEqualToArray:self.filteredObjectsSortDescriptors];
+    BOOL predicateUnchanged = predicate == self.filteredObjectsPredicate || [predicate isEqual:self.filteredObjectsPredicate];
+    if (self.filteredObjects && sortUnchanged && TLPredicateRefinesPredicate(predicate, self.filteredObjectsPredicate)) {
+        //a stricter predicate only needs to filter the current result, which is already sorted
+        sortedFilteredItems = predicateUnchanged ? self.filteredObjects : [self.filteredObjects filteredArrayUsingPredicate:predicate];
+    } else if (self.filteredObjects && sortDescriptors && predicateUnchanged) {
+        //only the sort order changed
+        sortedFilteredItems = [self sortedObjects:self.filteredObjects usingDescriptors:sortDescriptors];
+    } else {
+        NSArray *filteredItems = predicate ? [self.coreDataFetchedObjects filteredArrayUsingPredicate:predicate] : self.coreDataFetchedObjects;
+        sortedFilteredItems = sortDescriptors ? [self sortedObjects:filteredItems usingDescriptors:sortDescriptors] : filteredItems;
+    }
+    self.filteredObjects = sortedFilteredItems;
+    self.filteredObjectsPredicate = predicate;
+    self.filteredObjectsSortDescriptors = sortDescriptors;
+    
+    TLIndexPathDataModel *dataModel = [[TLIndexPathDataModel alloc] initWithItems:sortedFilteredItems
+                                                               sectionNameKeyPath:self.backingController.sectionNameKeyPath
+                                                                identifierKeyPath:self.dataModel.identifierKeyPath];
+    self.fetchedDataModel = dataModel;
+    return dataModel;
+}
+
+- (void)invalidateFilteredObjects
+{
+    self.filteredObjects = nil;
+    self.filteredObjectsPredicate = nil;
+    self.filteredObjectsSortDescriptors = nil;
+}
+
+/*
+ Returns the values of the sort descriptors' key paths for the object, with `NSNull` in
+ place of nil. Values of plain attribute key paths are cached per object until the sort
+ key paths change or the fetched results controller reports the object changed. Key
+ paths that cross relationships, such as `department.name`, can change without the
+ object being reported, so objects sorted by them are evaluated every time.
+ */
+- (NSArray *)sortKeysForObject:(id)object usingDescriptors:(NSArray *)sortDescriptors
+{
+    NSMutableArray *keyPaths = [NSMutableArray arrayWithCapacity:sortDescriptors.count];
+    BOOL cacheable = YES;
+    for (NSSortDescriptor *sortDescriptor in sortDescriptors) {
+        [keyPaths addObject:sortDescriptor.key ? sortDescriptor.key : [NSNull null]];
+        if ([sortDescriptor.key rangeOfString:@"."].location != NSNotFound) {
+            cacheable = NO;
+        }
+    }
+    if (!self.sortKeysByObject || ![keyPaths isEqualToArray:self.sortKeyPaths]) {
+        self.sortKeysByObject = [NSMapTable strongToStrongObjectsMapTable];
+        self.sortKeyPaths = keyPaths;
+    }
+    
+    NSArray *objectKeys = cacheable ? [self.sortKeysByObject objectForKey:object] : nil;
+    if (!objectKeys) {
+        NSMutableArray *extractedKeys = [[NSMutableArray alloc] initWithCapacity:keyPaths.count];
+        for (id keyPath in keyPaths) {
+            id key = keyPath == [NSNull null] ? object : [object valueForKeyPath:keyPath];
+            [extractedKeys addObject:key ? key : [NSNull null]];
+        }
+        objectKeys = extractedKeys;
+        if (cacheable) {
+            [self.sortKeysByObject setObject:objectKeys forKey:object];
+        }
+    }
+    return objectKeys;
+}
+
+/*
+ Compares keys returned by `sortKeysForObject:usingDescriptors:` the same way the sort
+ descriptors would compare the objects.
+ */
+static NSComparisonResult TLCompareSortKeys(NSArray *keys1, NSArray *keys2, NSArray *sortDescriptors)
+{
+    NSUInteger descriptorIndex = 0;
+    for (NSSortDescriptor *sortDescriptor in sortDescriptors) {
+        id key1 = keys1[descriptorIndex];
+        id key2 = keys2[descriptorIndex];
+        descriptorIndex++;
+        NSComparisonResult result;
+        if (key1 == [NSNull null] || key2 == [NSNull null]) {
+            //nil sorts before any value, as with `NSSortDescriptor`
+            result = key1 == key2 ? NSOrderedSame : key1 == [NSNull null] ? NSOrderedAscending : NSOrderedDescending;
+        } else if (sortDescriptor.comparator) {
+            result = sortDescriptor.comparator(key1, key2);
+        } else {
+            SEL selector = sortDescriptor.selector;
+            result = ((NSComparisonResult (*)(id, SEL, id))[key1 methodForSelector:selector])(key1, selector, key2);
+        }
+        if (result != NSOrderedSame) {
+            return sortDescriptor.ascending ? result : (NSComparisonResult)-result;
+        }
+    }
+    return NSOrderedSame;
+}
+
+/*
+ Stable sort equivalent to `sortedArrayUsingDescriptors:` that evaluates each sort
+ descriptor's key path once per object. See `sortKeysForObject:usingDescriptors:`.
+ */
+- (NSArray *)sortedObjects:(NSArray *)objects usingDescriptors:(NSArray *)sortDescriptors
+{
+    NSUInteger count = objects.count;
+    NSMutableArray *keys = [[NSMutableArray alloc] initWithCapacity:count];
+    for (id object in objects) {
+        [keys addObject:[self sortKeysForObject:object usingDescriptors:sortDescriptors]];
+    }
+    
+    NSUInteger *indexes = malloc(MAX(count, 1) * sizeof(NSUInteger));
+    for (NSUInteger index = 0; index < count; index++) {
+        indexes[index] = index;
+    }
+    mergesort_b(indexes, count, sizeof(NSUInteger), ^int(const void *index1, const void *index2) {
+        return (int)TLCompareSortKeys(keys[*(const NSUInteger *)index1], keys[*(const NSUInteger *)index2], sortDescriptors);
+    });
+    
+    NSMutableArray *sortedObjects = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [sortedObjects addObject:objects[indexes[index]]];
+    }
+    free(indexes);
+    return sortedObjects;
+}
+
+/*
+ Applies fetched results changes to `fetchedDataModel` without re-filtering, re-sorting
+ or diffing all of the fetched objects. Deleted objects are removed and inserted objects
+ that pass the in-memory predicate are inserted at the row found by binary search. A
+ changed object stays where it is if it's still in order with its neighbors, in which
+ case it's only reported as modified. Otherwise, it's removed and inserted again and
+ reported as moved if its index path changes. Returns nil if the changes can't be
+ applied incrementally, in which case the data model must be rebuilt.
+ */
+- (TLIndexPathUpdates *)updatesByApplyingInsertedObjects:(NSArray *)insertedObjects deletedObjects:(NSArray *)deletedObjects changedObjects:(NSArray *)changedObjects updatedObjects:(NSArray *)updatedObjects
+{
+    TLIndexPathDataModel *dataModel = self.fetchedDataModel;
+    NSArray *sortDescriptors = self.inMemorySortDescriptors ? self.inMemorySortDescriptors : self.fetchRequest.sortDescriptors;
+    NSUInteger changeCount = insertedObjects.count + deletedObjects.count + changedObjects.count;
+    if (!dataModel || self.performingBatchUpdate || self.performsUpdatesAsynchronously || sortDescriptors.count == 0
+        || changeCount > self.maximumIncrementalChangeRatio * dataModel.items.count) {
+        return nil;
+    }
+    
+    //with in-memory sorting, sections are ordered by their first items, so changing
+    //the first item of a section could reorder the sections
+    BOOL sectionsOrderedByFirstItem = self.inMemorySortDescriptors.count && dataModel.numberOfSections > 1;
+    //compare the same keys the full sort uses so both paths agree on the order
+    NSComparator comparator = ^NSComparisonResult(id object1, id object2) {
+        return TLCompareSortKeys([self sortKeysForObject:object1 usingDescriptors:sortDescriptors],
+                                 [self sortKeysForObject:object2 usingDescriptors:sortDescriptors],
+                                 sortDescriptors);
+    };
+    
+    //an object that can't be found by identifier is either filtered out, in which case
+    //it wasn't visible, or visible under an identifier that has since changed, such as a
+    //temporary object ID, in which case it can't be located without rebuilding. The
+    //visible objects are only collected the first time this needs to be decided.
+    NSPredicate *predicate = self.inMemoryPredicate;
+    __block NSHashTable *visibleObjects;
+    BOOL (^isFilteredOut)(id) = ^BOOL(id object) {
+        if (!predicate) {
+            return NO;
+        }
+        if (!visibleObjects) {
+            visibleObjects = [[NSHashTable alloc] initWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality capacity:dataModel.items.count];
+            for (id item in dataModel.items) {
+                [visibleObjects addObject:item];
+            }
+        }
+        return ![visibleObjects containsObject:object];
+    };
+    
+    NSMutableArray *objectsToRemove = [NSMutableArray array];
+    NSMutableArray *objectsToInsert = [NSMutableArray arrayWithArray:insertedObjects];
+    NSHashTable *departingObjects = [NSHashTable hashTableWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality];
+    NSMutableDictionary *changedRowsBySection = [NSMutableDictionary dictionary];
+    
+    for (id object in deletedObjects) {
+        NSIndexPath *indexPath = [dataModel indexPathForItem:object];
+        if (!indexPath || [dataModel itemAtIndexPath:indexPath] != object) {
+            if (isFilteredOut(object)) {
+                continue;
+            }
+            return nil;
+        }
+        [objectsToRemove addObject:object];
+        [departingObjects addObject:object];
+    }
+    
+    for (id object in changedObjects) {
+        NSIndexPath *indexPath = [dataModel indexPathForItem:object];
+        if (!indexPath || [dataModel itemAtIndexPath:indexPath] != object) {
+            if (isFilteredOut(object)) {
+                //may pass the predicate now
+                [objectsToInsert addObject:object];
+                continue;
+            }
+            return nil;
+        }
+        if (predicate && ![predicate evaluateWithObject:object]) {
+            [objectsToRemove addObject:object];
+            [departingObjects addObject:object];
+        } else if (![[dataModel sectionNameForItem:object] isEqualToString:[dataModel sectionNameForSection:indexPath.section]]) {
+            [objectsToRemove addObject:object];
+            [objectsToInsert addObject:object];
+            [departingObjects addObject:object];
+        } else {
+            NSMutableIndexSet *rows = changedRowsBySection[@(indexPath.section)];
+            if (!rows) {
+                rows = [NSMutableIndexSet indexSet];
+                changedRowsBySection[@(indexPath.section)] = rows;
+            }
+            [rows addIndex:indexPath.row];
+        }
+    }
+    
+    //a changed object stays in place if it's still in order with the nearest objects on
+    //either side that stay in place. Rows are checked in ascending order, so objects on
+    //the left have been settled and changed objects on the right are skipped.
+    NSSet *changedObjectSet = [NSSet setWithArray:changedObjects];
+    NSMutableIndexSet *touchedSections = [NSMutableIndexSet indexSet];
+    for (NSNumber *sectionNumber in changedRowsBySection) {
+        NSInteger section = [sectionNumber integerValue];
+        NSArray *items = [dataModel sectionInfoForSection:section].objects;
+        NSIndexSet *rows = changedRowsBySection[sectionNumber];
+        for (NSUInteger row = [rows firstIndex]; row != NSNotFound; row = [rows indexGreaterThanIndex:row]) {
+            id object = items[row];
+            id previousObject;
+            for (NSInteger index = (NSInteger)row - 1; index >= 0 && !previousObject; index--) {
+                if (![departingObjects containsObject:items[index]]) {
+                    previousObject = items[index];
+                }
+            }
+            id nextObject;
+            for (NSUInteger index = row + 1; index < items.count && !nextObject; index++) {
+                if (![departingObjects containsObject:items[index]] && ![changedObjectSet containsObject:items[index]]) {
+                    nextObject = items[index];
+                }
+            }
+            if ((!previousObject || comparator(previousObject, object) != NSOrderedDescending)
+                && (!nextObject || comparator(object, nextObject) != NSOrderedDescending)) {
+                [touchedSections addIndex:section];
+            } else {
+                [objectsToRemove addObject:object];
+                [objectsToInsert addObject:object];
+                [departingObjects addObject:object];
+            }
+        }
+    }
+    
+    TLIndexPathDataModelMutations *mutations = [[TLIndexPathDataModelMutations alloc] initWithDataModel:dataModel];
+    
+    for (id object in objectsToRemove) {
+        [touchedSections addIndex:[dataModel indexPathForItem:object].section];
+        [mutations deleteItem:object];
+    }
+    
+    for (id object in objectsToInsert) {
+        if (predicate && ![predicate evaluateWithObject:object]) {
+            continue;
+        }
+        NSInteger section = [dataModel sectionForSectionName:[dataModel sectionNameForItem:object]];
+        if (section == NSNotFound) {
+            //new sections are placed by rebuilding
+            return nil;
+        }
+        NSArray *items = [mutations itemsInSection:section];
+        NSUInteger row = [items indexOfObject:object
+                                inSortedRange:NSMakeRange(0, items.count)
+                                      options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                              usingComparator:comparator];
+        [mutations insertItem:object atIndexPath:[NSIndexPath indexPathForRow:row inSection:section]];
+        [touchedSections addIndex:section];
+    }
+    
+    //empty sections are removed by rebuilding, as are sections whose first item changed
+    //when sections are ordered by their first items
+    for (NSUInteger section = [touchedSections firstIndex]; section != NSNotFound; section = [touchedSections indexGreaterThanIndex:section]) {
+        NSArray *items = [mutations itemsInSection:section];
+        if (items.count == 0) {
+            return nil;
+        }
+        if (sectionsOrderedByFirstItem) {
+            id firstItem = [items firstObject];
+            if (firstItem != [[dataModel sectionInfoForSection:section].objects firstObject] || [changedObjectSet containsObject:firstItem]) {
+                return nil;
+            }
+        }
+    }
+    
+    TLIndexPathUpdates *updates = [mutations updates];
+    NSMutableArray *modifiedItems = [NSMutableArray arrayWithArray:updates.modifiedItems];
+    for (id object in updatedObjects) {
+        if ([dataModel containsItem:object] && [updates.updatedDataModel containsItem:object] && ![modifiedItems containsObject:object]) {
+            [modifiedItems addObject:object];
+        }
+    }
+    return [[TLIndexPathUpdates alloc] initWithOldDataModel:updates.oldDataModel
+                                           updatedDataModel:updates.updatedDataModel
+                                       insertedSectionNames:updates.insertedSectionNames
+                                              insertedItems:updates.insertedItems
+                                               deletedItems:updates.deletedItems
+                                                 movedItems:updates.movedItems
+                                              modifiedItems:modifiedItems];
+}
+
+- (NSMutableArray *)updatedItems
+{
+    if (!_updatedItems) {
+        _updatedItems = [NSMutableArray array];
+    }
+    return _updatedItems;
+}
+
+#pragma mark - NSFetchedResultsControllerDelegate
+
+- (void)controllerWillChangeContent:(NSFetchedResultsController *)controller
+{
+    [self.updatedItems removeAllObjects];
+    self.insertedObjects = [NSMutableOrderedSet orderedSet];
+    self.deletedObjects = [NSMutableOrderedSet orderedSet];
+    self.changedObjects = [NSMutableOrderedSet orderedSet];
+}
+
+- (void)controllerDidChangeContent:(NSFetchedResultsController *)controller
+{
+    [self.changedObjects minusOrderedSet:self.insertedObjects];
+    [self.changedObjects minusOrderedSet:self.deletedObjects];
+    NSArray *insertedObjects = [self.insertedObjects array];
+    NSArray *deletedObjects = [self.deletedObjects array];
+    NSArray *changedObjects = [self.changedObjects array];
+    NSArray *updatedObjects = [self.updatedItems copy];
+    self.insertedObjects = nil;
+    self.deletedObjects = nil;
+    self.changedObjects = nil;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self invalidateFilteredObjects];
+        if (!self.ignoreFetchedResultsChanges) {
+            TLIndexPathUpdates *updates = [self updatesByApplyingInsertedObjects:insertedObjects
+                                                                  deletedObjects:deletedObjects
+                                                                  changedObjects:changedObjects
+                                                                  updatedObjects:updatedObjects];
+            if (updates) {
+                //updated objects have already been reported as modified
+                [self.updatedItems removeAllObjects];
+                self.fetchedDataModel = updates.updatedDataModel;
+                [self setDataModelWithUpdates:updates];
+            } else {
+                self.dataModel = [self convertFetchedObjectsToDataModel];
+            }
+        } else {
+            //changes that are ignored make the fetched data model stale
+            self.fetchedDataModel = nil;
+        }
+    });
+}
+
+- (void)controller:(NSFetchedResultsController *)controller didChangeObject:(id)anObject atIndexPath:(NSIndexPath *)indexPath forChangeType:(NSFetchedResultsChangeType)type newIndexPath:(NSIndexPath *)newIndexPath
+{
+    if (type != NSFetchedResultsChangeInsert) {
+        [self.sortKeysByObject removeObjectForKey:anObject];
+    }
+    switch (type) {
+        case NSFetchedResultsChangeInsert:
+            [self.insertedObjects addObject:anObject];
+            break;
+        case NSFetchedResultsChangeDelete:
+            [self.deletedObjects addObject:anObject];
+            break;
+        case NSFetchedResultsChangeUpdate:
+            [self.updatedItems addObject:anObject];
+            [self.changedObjects addObject:anObject];
+            break;
+        case NSFetchedResultsChangeMove:
+            [self.changedObjects addObject:anObject];
+            break;
+    }
+}
+
+- (NSString *)controller:(NSFetchedResultsController *)controller sectionIndexTitleForSectionName:(NSString *)sectionName
+{
+    return sectionName;
+}
+
+@end
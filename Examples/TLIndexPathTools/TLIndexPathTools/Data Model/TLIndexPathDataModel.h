@@ -137,6 +137,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 extern NSString * TLIndexPathDataModelNilSectionName;
 
+@class TLIndexPathDataModelMutations;
+@class TLIndexPathUpdates;
+
 @interface TLIndexPathDataModel : NSObject
 
 #pragma mark - Creating data models
@@ -182,6 +185,25 @@ extern NSString * TLIndexPathDataModelNilSectionName;
  */
 - (id)initWithItems:(NSArray *)items sectionNameBlock:(NSString *(^ __nullable)(id item))sectionNameBlock identifierBlock:(id(^ __nullable)(id item))identifierBlock;
 
+/**
+ Same as `initWithItems:sectionNameBlock:identifierBlock:`, but evaluates the blocks
+ on contiguous chunks of items concurrently. The results are merged in item order, so
+ section ordering and duplicate handling are the same as for the serial initializer.
+ This can significantly reduce the time to build data models with a large number of
+ items when the blocks are expensive.
+ 
+ The blocks, and the default identification rules if they return `nil`, must be safe
+ to call from multiple threads. In particular, don't use this with managed objects
+ unless they can be accessed from any thread.
+ 
+ @param items  the itmes that make up the data model
+ @param sectionNameBlock  block that returns the section name for the given item
+ @param identifierBlock  block that returns the identifier for the given item
+ @param concurrency  the maximum number of threads to use. Specifying 0 will use
+ one thread per active processor.
+ */
+- (id)initWithItems:(NSArray *)items sectionNameBlock:(NSString *(^ __nullable)(id item))sectionNameBlock identifierBlock:(id(^ __nullable)(id item))identifierBlock concurrency:(NSUInteger)concurrency;
+
 /**
  Use this initializer to explicitly specify sections by providing an array of
  `TLIndexPathSectionInfo` objects. This initializer can be used to generate empty sections
@@ -348,6 +370,23 @@ extern NSString * TLIndexPathDataModelNilSectionName;
  */
 - (id __nullable)currentVersionOfItem:(id)anotherVersionOfItem;
 
+#pragma mark - Mutating data models
+/** @name Mutating data models */
+
+/**
+ Applies the insert, delete, move and replace operations performed in the given block
+ and returns the resulting updates. The mutated data model is available through the
+ `updatedDataModel` property of the returned updates. The receiver is not modified.
+ 
+ This is more efficient than building a new data model from the full items array
+ when only a few items change because untouched sections are shared with the receiver
+ and the updates are derived from the operations rather than by diffing.
+ See `TLIndexPathDataModelMutations`.
+ 
+ @param mutations  block that performs the operations
+ */
+- (TLIndexPathUpdates *)updatesByPerformingMutations:(void(^)(TLIndexPathDataModelMutations *mutations))mutations;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -0,0 +1,979 @@
+//
+//  TLIndexPathDataModel.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "TLIndexPathDataModel.h"
+#import <CoreData/CoreData.h>
+#import <objc/runtime.h>
+#import "TLIndexPathItem.h"
+#import "TLIndexPathSectionInfo.h"
+#import "TLIndexPathDataModelMutations.h"
+
+const NSString *TLIndexPathDataModelNilSectionName = @"__TLIndexPathDataModelNilSectionName__";
+
+#pragma mark - Identifier table
+
+/*
+ An open-addressing hash table mapping identifiers to index paths, with the section
+ and row packed into 64 bits. Keys aren't retained by the table. They're owned by
+ the data model's per-section identifier arrays, which outlive the table. Uses linear
+ probing with backward shift deletion, so no tombstones are needed, and stores the
+ key hashes to avoid calling `isEqual:` on mismatched slots.
+ */
+typedef struct {
+    __unsafe_unretained id *keys;
+    NSUInteger *hashes;
+    uint64_t *values;
+    NSUInteger mask;
+    NSUInteger count;
+} TLIdentifierTable;
+
+static inline uint64_t TLPackIndexPath(NSInteger section, NSInteger row)
+{
+    return ((uint64_t)(uint32_t)section << 32) | (uint32_t)row;
+}
+
+static inline NSInteger TLUnpackSection(uint64_t value)
+{
+    return (NSInteger)(value >> 32);
+}
+
+static inline NSInteger TLUnpackRow(uint64_t value)
+{
+    return (NSInteger)(uint32_t)value;
+}
+
+static inline NSUInteger TLIdentifierTableSlotForHash(const TLIdentifierTable *table, NSUInteger hash)
+{
+    // `hash` is often a poorly distributed value, such as a pointer or small integer
+    uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (NSUInteger)h & table->mask;
+}
+
+static void TLIdentifierTableInit(TLIdentifierTable *table, NSUInteger count)
+{
+    // keep the load factor at or below 0.5
+    NSUInteger capacity = 8;
+    while (capacity < count * 2) {
+        capacity <<= 1;
+    }
+    table->keys = (__unsafe_unretained id *)calloc(capacity, sizeof(id));
+    table->hashes = calloc(capacity, sizeof(NSUInteger));
+    table->values = calloc(capacity, sizeof(uint64_t));
+    table->mask = capacity - 1;
+    table->count = 0;
+}
+
+static void TLIdentifierTableFree(TLIdentifierTable *table)
+{
+    free(table->keys);
+    free(table->hashes);
+    free(table->values);
+    table->keys = NULL;
+    table->hashes = NULL;
+    table->values = NULL;
+    table->count = 0;
+}
+
+/*
+ Returns the slot containing `key` or, if `key` isn't present, the empty slot
+ where it would be inserted.
+ */
+static NSUInteger TLIdentifierTableFind(const TLIdentifierTable *table, id key, NSUInteger hash)
+{
+    NSUInteger slot = TLIdentifierTableSlotForHash(table, hash);
+    while (table->keys[slot]) {
+        id candidate = table->keys[slot];
+        if (candidate == key || (table->hashes[slot] == hash && [candidate isEqual:key])) {
+            break;
+        }
+        slot = (slot + 1) & table->mask;
+    }
+    return slot;
+}
+
+static BOOL TLIdentifierTableGet(const TLIdentifierTable *table, id key, uint64_t *value)
+{
+    if (!key || !table->keys) {
+        return NO;
+    }
+    NSUInteger slot = TLIdentifierTableFind(table, key, [key hash]);
+    if (!table->keys[slot]) {
+        return NO;
+    }
+    if (value) {
+        *value = table->values[slot];
+    }
+    return YES;
+}
+
+static void TLIdentifierTableInsert(TLIdentifierTable *table, __unsafe_unretained id key, NSUInteger hash, uint64_t value, NSUInteger slot)
+{
+    table->keys[slot] = key;
+    table->hashes[slot] = hash;
+    table->values[slot] = value;
+    table->count++;
+}
+
+static void TLIdentifierTableGrow(TLIdentifierTable *table)
+{
+    TLIdentifierTable old = *table;
+    TLIdentifierTableInit(table, (old.mask + 1));
+    for (NSUInteger i = 0; i <= old.mask; i++) {
+        if (old.keys[i]) {
+            NSUInteger slot = TLIdentifierTableFind(table, old.keys[i], old.hashes[i]);
+            TLIdentifierTableInsert(table, old.keys[i], old.hashes[i], old.values[i], slot);
+        }
+    }
+    TLIdentifierTableFree(&old);
+}
+
+/*
+ Adds `key` unless it's already present, in which case `NO` is returned.
+ */
+static BOOL TLIdentifierTableAdd(TLIdentifierTable *table, __unsafe_unretained id key, uint64_t value)
+{
+    if ((table->count + 1) * 2 > table->mask + 1) {
+        TLIdentifierTableGrow(table);
+    }
+    NSUInteger hash = [key hash];
+    NSUInteger slot = TLIdentifierTableFind(table, key, hash);
+    if (table->keys[slot]) {
+        return NO;
+    }
+    TLIdentifierTableInsert(table, key, hash, value, slot);
+    return YES;
+}
+
+static void TLIdentifierTableRemove(TLIdentifierTable *table, id key)
+{
+    NSUInteger slot = TLIdentifierTableFind(table, key, [key hash]);
+    if (!table->keys[slot]) {
+        return;
+    }
+    // shift back any following entries that would become unreachable
+    NSUInteger next = slot;
+    while (YES) {
+        next = (next + 1) & table->mask;
+        if (!table->keys[next]) {
+            break;
+        }
+        NSUInteger ideal = TLIdentifierTableSlotForHash(table, table->hashes[next]);
+        BOOL reachable = slot <= next ? (slot < ideal && ideal <= next) : (slot < ideal || ideal <= next);
+        if (!reachable) {
+            table->keys[slot] = table->keys[next];
+            table->hashes[slot] = table->hashes[next];
+            table->values[slot] = table->values[next];
+            slot = next;
+        }
+    }
+    table->keys[slot] = nil;
+    table->count--;
+}
+
+static void TLIdentifierTableCopy(TLIdentifierTable *table, const TLIdentifierTable *source)
+{
+    NSUInteger capacity = source->mask + 1;
+    table->keys = (__unsafe_unretained id *)malloc(capacity * sizeof(id));
+    table->hashes = malloc(capacity * sizeof(NSUInteger));
+    table->values = malloc(capacity * sizeof(uint64_t));
+    memcpy((void *)table->keys, (const void *)source->keys, capacity * sizeof(id));
+    memcpy(table->hashes, source->hashes, capacity * sizeof(NSUInteger));
+    memcpy(table->values, source->values, capacity * sizeof(uint64_t));
+    table->mask = source->mask;
+    table->count = source->count;
+}
+
+#pragma mark - Key path accessors
+
+/*
+ The getter for a single key path component, resolved for one class. The getter is
+ called directly when the class implements an object-returning method named after the
+ key, doesn't implement a `get<Key>` method that KVC would prefer and doesn't customize
+ `valueForKey:` beyond what `NSManagedObject` does. Otherwise `implementation` is `NULL`
+ and the component falls back to `valueForKey:`.
+ */
+@interface TLKeyPathGetter : NSObject
+@property (assign, nonatomic, readonly) Class itemClass;
+@property (assign, nonatomic, readonly) SEL selector;
+@property (assign, nonatomic, readonly) IMP implementation;
+- (id)initWithClass:(Class)itemClass key:(NSString *)key;
+@end
+
+@implementation TLKeyPathGetter
+
+- (id)initWithClass:(Class)itemClass key:(NSString *)key
+{
+    if (self = [super init]) {
+        _itemClass = itemClass;
+        IMP valueForKey = class_getMethodImplementation(itemClass, @selector(valueForKey:));
+        if (valueForKey != [NSObject instanceMethodForSelector:@selector(valueForKey:)]
+            && valueForKey != [NSManagedObject instanceMethodForSelector:@selector(valueForKey:)]) {
+            return self;
+        }
+        NSString *capitalizedKey = [[[key substringToIndex:1] uppercaseString] stringByAppendingString:[key substringFromIndex:1]];
+        if ([itemClass instancesRespondToSelector:NSSelectorFromString([@"get" stringByAppendingString:capitalizedKey])]) {
+            return self;
+        }
+        SEL selector = NSSelectorFromString(key);
+        if (![itemClass instancesRespondToSelector:selector]) {
+            return self;
+        }
+        Method method = class_getInstanceMethod(itemClass, selector);
+        char returnType[8];
+        method_getReturnType(method, returnType, sizeof(returnType));
+        if (method_getNumberOfArguments(method) == 2 && returnType[0] == _C_ID) {
+            _selector = selector;
+            _implementation = method_getImplementation(method);
+        }
+    }
+    return self;
+}
+
+@end
+
+@interface TLKeyPathComponent : NSObject
+@property (copy, nonatomic, readonly) NSString *key;
+// the most recently resolved getter, checked before `gettersByClass`. Replaced
+// atomically so that components can be shared by data models built on different threads.
+@property (strong, atomic) TLKeyPathGetter *getter;
+// getters resolved so far, keyed by class, so that items of mixed classes don't
+// resolve their getters again on every call. Guarded by `@synchronized (self)`.
+@property (strong, nonatomic, readonly) NSMapTable *gettersByClass;
+- (id)initWithKey:(NSString *)key;
+- (id)valueForObject:(id)object;
+@end
+
+@implementation TLKeyPathComponent
+
+- (id)initWithKey:(NSString *)key
+{
+    if (self = [super init]) {
+        _key = [key copy];
+        _gettersByClass = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality
+                                                valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    return self;
+}
+
+- (id)valueForObject:(id)object
+{
+    Class itemClass = object_getClass(object);
+    TLKeyPathGetter *getter = self.getter;
+    if (getter.itemClass != itemClass) {
+        @synchronized (self) {
+            getter = [self.gettersByClass objectForKey:itemClass];
+            if (!getter) {
+                getter = [[TLKeyPathGetter alloc] initWithClass:itemClass key:self.key];
+                [self.gettersByClass setObject:getter forKey:itemClass];
+            }
+        }
+        self.getter = getter;
+    }
+    IMP implementation = getter.implementation;
+    if (implementation) {
+        return ((id (*)(id, SEL))implementation)(object, getter.selector);
+    }
+    return [object valueForKey:self.key];
+}
+
+@end
+
+/*
+ Evaluates a key path as a chain of resolved getters instead of parsing the key path
+ with `valueForKeyPath:` on every call. Key paths containing collection operators or
+ empty components are evaluated with `valueForKeyPath:`. Accessors are cached by key
+ path and don't catch exceptions, which are handled once per batch of items by
+ `TLIndexPathDataModel`.
+ */
+@interface TLKeyPathAccessor : NSObject
++ (TLKeyPathAccessor *)accessorForKeyPath:(NSString *)keyPath;
+- (id)initWithKeyPath:(NSString *)keyPath;
+- (id)valueForObject:(id)object;
+@end
+
+@implementation TLKeyPathAccessor
+{
+    NSString *_keyPath;
+    NSArray *_components;
+}
+
++ (TLKeyPathAccessor *)accessorForKeyPath:(NSString *)keyPath
+{
+    static NSCache *accessorsByKeyPath;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        accessorsByKeyPath = [[NSCache alloc] init];
+    });
+    TLKeyPathAccessor *accessor = [accessorsByKeyPath objectForKey:keyPath];
+    if (!accessor) {
+        accessor = [[TLKeyPathAccessor alloc] initWithKeyPath:keyPath];
+        [accessorsByKeyPath setObject:accessor forKey:[keyPath copy]];
+    }
+    return accessor;
+}
+
+- (id)initWithKeyPath:(NSString *)keyPath
+{
+    if (self = [super init]) {
+        _keyPath = [keyPath copy];
+        NSMutableArray *components = [NSMutableArray array];
+        for (NSString *key in [keyPath componentsSeparatedByString:@"."]) {
+            if (key.length == 0 || [key hasPrefix:@"@"]) {
+                components = nil;
+                break;
+            }
+            [components addObject:[[TLKeyPathComponent alloc] initWithKey:key]];
+        }
+        _components = components;
+    }
+    return self;
+}
+
+- (id)valueForObject:(id)object
+{
+    if (!_components) {
+        return [object valueForKeyPath:_keyPath];
+    }
+    id value = object;
+    for (TLKeyPathComponent *component in _components) {
+        value = [component valueForObject:value];
+        if (!value) {
+            break;
+        }
+    }
+    return value;
+}
+
+@end
+
+@interface TLIndexPathDataModel ()
+{
+    TLIdentifierTable _indexPathsByIdentifier;
+}
+@property (strong, nonatomic) NSString *(^sectionNameBlock)(id item);
+@property (strong, nonatomic) id(^identifierBlock)(id item);
+@property (strong, nonatomic) NSMutableDictionary *sectionInfosBySectionName;
+// per-section arrays of identifiers with `NSNull` marking items that can't be
+// looked up by identifier (duplicates)
+@property (strong, nonatomic) NSArray *identifiersBySection;
+@end
+
+@implementation TLIndexPathDataModel
+
+@synthesize identifierKeyPath = _identifierKeyPath;
+@synthesize sectionNameKeyPath = _sectionNameKeyPath;
+@synthesize numberOfSections = _sectionCount;
+@synthesize items = _items;
+@synthesize sectionNames = _sectionNames;
+@synthesize sections = _sections;
+
+#pragma mark - Creating data models
+
+- (id)init
+{
+    return [self initWithItems:@[] sectionNameKeyPath:nil identifierKeyPath:nil];
+}
+
+- (id)initWithItems:(NSArray *)items
+{
+    return [self initWithItems:items sectionNameKeyPath:nil identifierKeyPath:nil];
+}
+
+- (id)initWithItems:(NSArray *)items sectionNameKeyPath:(NSString *)sectionNameKeyPath identifierKeyPath:(NSString *)identifierKeyPath
+{
+    NSString *(^sectionNameBlock)(id item);
+    if (sectionNameKeyPath) {
+        TLKeyPathAccessor *accessor = [TLKeyPathAccessor accessorForKeyPath:sectionNameKeyPath];
+        sectionNameBlock = ^NSString *(id item) {
+            return [accessor valueForObject:item];
+        };
+    }
+    id(^identifierBlock)(id item);
+    if (identifierKeyPath) {
+        TLKeyPathAccessor *accessor = [TLKeyPathAccessor accessorForKeyPath:identifierKeyPath];
+        identifierBlock = ^id(id item) {
+            return [accessor valueForObject:item];
+        };
+    }
+    
+    if (self = [self initWithItems:items sectionNameBlock:sectionNameBlock identifierBlock:identifierBlock]) {
+        _identifierKeyPath = identifierKeyPath;
+        _sectionNameKeyPath = sectionNameKeyPath;
+    }
+    return self;
+}
+
+- (id)initWithItems:(NSArray *)items sectionNameBlock:(NSString *(^)(id))sectionNameBlock identifierBlock:(id (^)(id))identifierBlock
+{
+    return [self initWithItems:items sectionNameBlock:sectionNameBlock identifierBlock:identifierBlock concurrency:1];
+}
+
+- (id)initWithItems:(NSArray *)items sectionNameBlock:(NSString *(^)(id))sectionNameBlock identifierBlock:(id (^)(id))identifierBlock concurrency:(NSUInteger)concurrency
+{
+    NSMutableDictionary *itemsBySectionName = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary *identifiersBySectionName = [[NSMutableDictionary alloc] init];
+    NSMutableArray *sectionNames = [NSMutableArray array];
+    
+    NSArray *itemIdentifiers;
+    NSArray *itemSectionNames;
+    [TLIndexPathDataModel evaluateItems:items sectionNameBlock:sectionNameBlock identifierBlock:identifierBlock
+                            concurrency:concurrency identifiers:&itemIdentifiers sectionNames:&itemSectionNames];
+    
+    //group items by section name and remove any duplicate identifiers. This is done
+    //in item order so the first of any duplicates is kept. The identifiers are retained
+    //by `itemIdentifiers` for as long as the table is in use.
+    TLIdentifierTable identifierTable;
+    TLIdentifierTableInit(&identifierTable, items.count);
+    NSUInteger index = 0;
+    for (id item in items) {
+        id identifier = itemIdentifiers[index];
+        NSString *sectionName = itemSectionNames[index];
+        index++;
+        if (!identifier) { continue; }
+        if (!TLIdentifierTableAdd(&identifierTable, identifier, 0)) {
+            NSLog(@"WARNING: TLIndexPathDataModel - duplicate identifier '%@'. Duplicate item ignored.", identifier);
+            continue;
+        }
+        NSMutableArray *sectionItems = [itemsBySectionName objectForKey:sectionName];
+        NSMutableArray *sectionIdentifiers = [identifiersBySectionName objectForKey:sectionName];
+        if (!sectionItems) {
+            sectionItems = [NSMutableArray array];
+            sectionIdentifiers = [NSMutableArray array];
+            [itemsBySectionName setObject:sectionItems forKey:sectionName];
+            [identifiersBySectionName setObject:sectionIdentifiers forKey:sectionName];
+            [sectionNames addObject:sectionName];
+        }
+        [sectionItems addObject:item];
+        [sectionIdentifiers addObject:identifier];
+    }
+    TLIdentifierTableFree(&identifierTable);
+    
+    //create section infos
+    NSMutableArray *sectionInfos = [NSMutableArray arrayWithCapacity:sectionNames.count];
+    NSMutableArray *identifiersBySection = [NSMutableArray arrayWithCapacity:sectionNames.count];
+    for (NSString *sectionName in sectionNames) {
+        NSArray *sectionItems = [itemsBySectionName objectForKey:sectionName];
+        TLIndexPathSectionInfo *sectionInfo = [[TLIndexPathSectionInfo alloc] initWithItems:sectionItems name:sectionName indexTitle:sectionName];
+        [sectionInfos addObject:sectionInfo];
+        [identifiersBySection addObject:[identifiersBySectionName objectForKey:sectionName]];
+    }
+    
+    //pass the identifiers along so they aren't evaluated a second time
+    if (self = [self initWithSectionInfos:sectionInfos sectionNameBlock:sectionNameBlock identifierBlock:identifierBlock identifiersBySection:identifiersBySection]) {
+//        _sectionNames = sectionNames;//TODO
+    }
+    return self;
+}
+
+- (id)initWithSectionInfos:(NSArray *)sectionInfos identifierKeyPath:(NSString *)identifierKeyPath
+{
+    id(^identifierBlock)(id item);
+    if (identifierKeyPath) {
+        TLKeyPathAccessor *accessor = [TLKeyPathAccessor accessorForKeyPath:identifierKeyPath];
+        identifierBlock = ^id(id item) {
+            return [accessor valueForObject:item];
+        };
+    }
+    
+    if (self = [self initWithSectionInfos:sectionInfos sectionNameBlock:nil identifierBlock:identifierBlock identifiersBySection:nil]) {
+        _identifierKeyPath = identifierKeyPath;
+    }
+    return self;
+}
+
+/*
+ `identifiersBySection` optionally provides identifiers that have already been evaluated
+ for every item. Otherwise the identifiers are evaluated a section at a time.
+ */
+- (id)initWithSectionInfos:(NSArray *)sectionInfos sectionNameBlock:(NSString *(^)(id))sectionNameBlock identifierBlock:(id (^)(id))identifierBlock identifiersBySection:(NSArray *)precomputedIdentifiersBySection
+{
+    //if there are no sections, insert an empty section to keep UICollectionView
+    //happy. If we don't do this, UICollectionView will crash on the first
+    //update because it internally thinks there is 1 section when the
+    //UICollectionView controller reports zero sections.
+    if (sectionInfos.count == 0) {
+        TLIndexPathSectionInfo *sectionInfo = [[TLIndexPathSectionInfo alloc]
+                                               initWithItems:@[]
+                                               name:[TLIndexPathDataModelNilSectionName copy]
+                                               indexTitle:nil];
+        sectionInfos = @[sectionInfo];
+    }
+    
+    if (self = [super init]) {
+        
+        _identifierBlock = identifierBlock;
+        _sectionNameBlock = sectionNameBlock;
+        
+        NSUInteger count = 0;
+        for (id<NSFetchedResultsSectionInfo>sectionInfo in sectionInfos) {
+            count += sectionInfo.objects.count;
+        }
+        
+        NSMutableArray *identifiedItems = [[NSMutableArray alloc] initWithCapacity:count];
+        NSMutableArray *sectionNames = [[NSMutableArray alloc] init];
+        NSMutableArray *identifiersBySection = [[NSMutableArray alloc] initWithCapacity:sectionInfos.count];
+        
+        TLIdentifierTableInit(&_indexPathsByIdentifier, count);
+        _sectionInfosBySectionName = [[NSMutableDictionary alloc] init];
+        _identifiersBySection = identifiersBySection;
+        _sectionNames = sectionNames;
+        _sections = sectionInfos;
+        _items = identifiedItems;
+        
+        NSInteger section = 0;
+        for (id<NSFetchedResultsSectionInfo>sectionInfo in sectionInfos) {
+            
+            NSInteger row = 0;
+            NSMutableArray *identifiers = [[NSMutableArray alloc] initWithCapacity:sectionInfo.objects.count];
+            NSArray *sectionIdentifiers = section < (NSInteger)precomputedIdentifiersBySection.count ? precomputedIdentifiersBySection[section] : [TLIndexPathDataModel valuesForItems:sectionInfo.objects block:identifierBlock];
+            
+            for (id item in sectionInfo.objects) {
+                
+                id identifier = sectionIdentifiers[row];
+                if (identifier == [NSNull null]) {
+                    identifier = [TLIndexPathDataModel defaultIdentifierForItem:item];
+                }
+                //we can't remove duplicate items because section infos are
+                //immutable. So the strategy will be to make duplicate items behave
+                //just like any other item with the exception that they cannot be
+                //looked up by identifier. TODO this needs to be tested.
+                if (identifier && TLIdentifierTableAdd(&_indexPathsByIdentifier, identifier, TLPackIndexPath(section, row))) {
+                    [identifiedItems addObject:item];
+                    [identifiers addObject:identifier];
+                } else {
+                    if (identifier) {
+                        NSLog(@"WARNING: TLIndexPathDataModel - duplicate identifier '%@'. This will cause some data model APIs to return nil.", identifier);
+                    }
+                    [identifiers addObject:[NSNull null]];
+                }
+                
+                row++;
+            }
+            
+            [identifiersBySection addObject:identifiers];
+            [_sectionInfosBySectionName setObject:sectionInfo forKey:sectionInfo.name];
+            [sectionNames addObject:sectionInfo.name];
+            
+            section++;
+        }
+        
+        _sectionCount = sectionInfos.count;
+    }
+    
+    return self;
+}
+
+/*
+ Creates a data model derived from `dataModel` in which only the sections named in
+ `identifiersBySectionName` have changed. The identifier table is copied from `dataModel`,
+ the identifier arrays of unchanged sections are shared and only the rows of the changed
+ sections that differ from `dataModel` are re-indexed, using the given identifiers instead
+ of re-evaluating them. Existing sections must keep their indexes. The leading rows of a
+ changed section are only treated as unchanged while both the items and the identifier
+ instances match `dataModel`, so that every key in the table is retained by this data model.
+ */
+- (id)initWithDataModel:(TLIndexPathDataModel *)dataModel sectionInfos:(NSArray *)sectionInfos identifiersBySectionName:(NSDictionary *)identifiersBySectionName
+{
+    if (self = [super init]) {
+        
+        _identifierBlock = dataModel.identifierBlock;
+        _sectionNameBlock = dataModel.sectionNameBlock;
+        _identifierKeyPath = dataModel.identifierKeyPath;
+        _sectionNameKeyPath = dataModel.sectionNameKeyPath;
+        
+        TLIdentifierTableCopy(&_indexPathsByIdentifier, &dataModel->_indexPathsByIdentifier);
+        _sectionInfosBySectionName = [dataModel.sectionInfosBySectionName mutableCopy];
+        NSMutableArray *identifiersBySection = [dataModel.identifiersBySection mutableCopy];
+        
+        //find the first row of each changed section that differs from the old data model
+        //and remove the old entries from that row on. This must be done for all sections
+        //before adding new entries because items may have moved between sections.
+        NSMutableDictionary *firstChangedRowsBySectionName = [[NSMutableDictionary alloc] init];
+        for (NSString *sectionName in identifiersBySectionName) {
+            NSInteger section = [dataModel sectionForSectionName:sectionName];
+            NSInteger firstChangedRow = 0;
+            if (section != NSNotFound) {
+                NSArray *oldItems = [dataModel sectionInfoForSection:section].objects;
+                NSArray *items = [sectionInfos[section] objects];
+                NSArray *oldIdentifiers = dataModel.identifiersBySection[section];
+                NSArray *identifiers = identifiersBySectionName[sectionName];
+                //the table doesn't retain its keys, so a row is only unchanged if it also
+                //has the same identifier instance. An item that was removed and inserted
+                //again in place may have had its identifier evaluated to a new object.
+                NSInteger count = MIN(MIN(oldItems.count, items.count), identifiers.count);
+                while (firstChangedRow < count && oldItems[firstChangedRow] == items[firstChangedRow]
+                       && oldIdentifiers[firstChangedRow] == identifiers[firstChangedRow]) {
+                    firstChangedRow++;
+                }
+                for (NSInteger row = firstChangedRow; row < oldItems.count; row++) {
+                    id identifier = oldIdentifiers[row];
+                    if (identifier != [NSNull null]) {
+                        TLIdentifierTableRemove(&_indexPathsByIdentifier, identifier);
+                    }
+                }
+            }
+            [firstChangedRowsBySectionName setObject:@(firstChangedRow) forKey:sectionName];
+        }
+        
+        NSMutableArray *items = [[NSMutableArray alloc] initWithCapacity:dataModel.items.count];
+        NSMutableArray *sectionNames = [[NSMutableArray alloc] initWithCapacity:sectionInfos.count];
+        
+        NSInteger section = 0;
+        for (id<NSFetchedResultsSectionInfo>sectionInfo in sectionInfos) {
+            NSArray *identifiers = [identifiersBySectionName objectForKey:sectionInfo.name];
+            if (identifiers) {
+                NSMutableArray *sectionIdentifiers = [identifiers mutableCopy];
+                for (NSInteger row = [[firstChangedRowsBySectionName objectForKey:sectionInfo.name] integerValue]; row < sectionIdentifiers.count; row++) {
+                    id identifier = sectionIdentifiers[row];
+                    if (identifier == [NSNull null] || !TLIdentifierTableAdd(&_indexPathsByIdentifier, identifier, TLPackIndexPath(section, row))) {
+                        [sectionIdentifiers replaceObjectAtIndex:row withObject:[NSNull null]];
+                    }
+                }
+                if (section < identifiersBySection.count) {
+                    [identifiersBySection replaceObjectAtIndex:section withObject:sectionIdentifiers];
+                } else {
+                    [identifiersBySection addObject:sectionIdentifiers];
+                }
+                [_sectionInfosBySectionName setObject:sectionInfo forKey:sectionInfo.name];
+            }
+            //as in the designated initializer, items without a usable identifier
+            //are kept in their sections but not in `items`
+            NSArray *sectionIdentifiers = identifiersBySection[section];
+            NSInteger row = 0;
+            for (id item in sectionInfo.objects) {
+                if (sectionIdentifiers[row] != [NSNull null]) {
+                    [items addObject:item];
+                }
+                row++;
+            }
+            [sectionNames addObject:sectionInfo.name];
+            section++;
+        }
+        
+        _sections = sectionInfos;
+        _sectionNames = sectionNames;
+        _identifiersBySection = identifiersBySection;
+        _items = items;
+        _sectionCount = sectionInfos.count;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    TLIdentifierTableFree(&_indexPathsByIdentifier);
+}
+
+#pragma mark - Data model content
+
+- (NSArray *)indexPaths
+{
+    NSMutableArray *indexPaths = [[NSMutableArray alloc] initWithCapacity:self.items.count];
+    NSInteger section = 0;
+    for (NSArray *identifiers in self.identifiersBySection) {
+        NSInteger row = 0;
+        for (id identifier in identifiers) {
+            if (identifier != [NSNull null]) {
+                [indexPaths addObject:[NSIndexPath indexPathForRow:row inSection:section]];
+            }
+            row++;
+        }
+        section++;
+    }
+    return indexPaths;
+}
+
+- (NSInteger)numberOfRowsInSection:(NSInteger)section
+{
+    id<NSFetchedResultsSectionInfo>sectionInfo = [self sectionInfoForSection:section];
+    return sectionInfo ? [sectionInfo objects].count : NSNotFound;
+}
+
+- (NSString *)sectionNameForSection:(NSInteger)section
+{
+    id<NSFetchedResultsSectionInfo>sectionInfo = [self sectionInfoForSection:section];
+    return [sectionInfo name];
+}
+
+- (NSInteger)sectionForSectionName:(NSString *)sectionName
+{
+    id<NSFetchedResultsSectionInfo>sectionInfo = [self.sectionInfosBySectionName objectForKey:sectionName];
+    return sectionInfo ? [self.sections indexOfObject:sectionInfo] : NSNotFound;
+}
+
+- (NSString *)sectionTitleForSection:(NSInteger)section
+{
+    NSString *sectionName = [self sectionNameForSection:section];
+    if ([TLIndexPathDataModelNilSectionName isEqualToString:sectionName]) {
+        return nil;
+    }
+    return sectionName;
+}
+
+- (TLIndexPathSectionInfo *)sectionInfoForSection:(NSInteger)section
+{
+    if (self.sections.count <= section) {
+        return nil;
+    }
+    return self.sections[section];
+}
+
+- (id)itemAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (![self identifierAtIndexPath:indexPath]) {
+        return nil;
+    }
+    return [self.sections[indexPath.section] objects][indexPath.row];
+}
+
+/*
+ Index paths are used only for their section and row, so `UIMutableIndexPath`
+ instances passed in by `UITableView` work without being normalized.
+ */
+- (id)identifierAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (!indexPath || indexPath.section < 0 || indexPath.section >= self.identifiersBySection.count) {
+        return nil;
+    }
+    NSArray *identifiers = self.identifiersBySection[indexPath.section];
+    if (indexPath.row < 0 || indexPath.row >= identifiers.count) {
+        return nil;
+    }
+    id identifier = identifiers[indexPath.row];
+    return identifier == [NSNull null] ? nil : identifier;
+}
+
+- (NSArray *)identifiersInSection:(NSInteger)section
+{
+    return self.identifiersBySection[section];
+}
+
+- (BOOL)containsItem:(id)item
+{
+    return TLIdentifierTableGet(&_indexPathsByIdentifier, [self identifierForItem:item], NULL);
+}
+
+- (NSIndexPath *)indexPathForItem:(id)item
+{
+    return [self indexPathForIdentifier:[self identifierForItem:item]];
+}
+
+- (NSIndexPath *)indexPathForIdentifier:(id)identifier
+{
+    uint64_t value;
+    if (!TLIdentifierTableGet(&_indexPathsByIdentifier, identifier, &value)) {
+        return nil;
+    }
+    return [NSIndexPath indexPathForRow:TLUnpackRow(value) inSection:TLUnpackSection(value)];
+}
+
+- (id)identifierForItem:(id)item
+{
+    return [[self class] identifierForItem:item identifierBlock:self.identifierBlock];
+}
+
++ (id)identifierForItem:(id)item identifierBlock:(id (^)(id))identifierBlock
+{
+    id identifier;
+    if (identifierBlock) {
+        @try {
+            identifier = identifierBlock(item);
+        }
+        @catch (NSException *exception) {
+        }
+    }
+    return identifier ? identifier : [self defaultIdentifierForItem:item];
+}
+
++ (id)defaultIdentifierForItem:(id)item
+{
+    id identifier;
+    if ([item isKindOfClass:[TLIndexPathItem class]]) {
+        identifier = ((TLIndexPathItem *)item).identifier;
+    }
+    if (!identifier && [item isKindOfClass:[NSManagedObject class]]) {
+        identifier = ((NSManagedObject *)item).objectID;
+    }
+    if (!identifier && [item conformsToProtocol:@protocol(NSCopying)]) {
+        identifier = item;
+    }
+    if (!identifier) {
+        identifier = [NSString stringWithFormat:@"%p", item];
+    }
+    return identifier;
+}
+
+/*
+ Evaluates the identifier and section name of each item, applying the default rules
+ where the blocks return nil or raise. The items are split into at most `concurrency`
+ contiguous chunks (or one per active processor if `concurrency` is 0) that are evaluated
+ in parallel and then concatenated in order.
+ */
++ (void)evaluateItems:(NSArray *)items sectionNameBlock:(NSString *(^)(id))sectionNameBlock identifierBlock:(id (^)(id))identifierBlock concurrency:(NSUInteger)concurrency identifiers:(NSArray **)identifiers sectionNames:(NSArray **)sectionNames
+{
+    static const NSUInteger kMinimumChunkSize = 1024;
+    if (concurrency == 0) {
+        concurrency = [NSProcessInfo processInfo].activeProcessorCount;
+    }
+    NSUInteger count = items.count;
+    NSUInteger chunks = MAX(1, MIN(concurrency, count / kMinimumChunkSize));
+    
+    NSMutableArray *chunkIdentifiers = [[NSMutableArray alloc] initWithCapacity:chunks];
+    NSMutableArray *chunkSectionNames = [[NSMutableArray alloc] initWithCapacity:chunks];
+    for (NSUInteger chunk = 0; chunk < chunks; chunk++) {
+        [chunkIdentifiers addObject:[NSMutableArray array]];
+        [chunkSectionNames addObject:[NSMutableArray array]];
+    }
+    
+    void(^evaluateChunk)(size_t) = ^(size_t chunk) {
+        @autoreleasepool {
+            NSUInteger start = count * chunk / chunks;
+            NSUInteger end = count * (chunk + 1) / chunks;
+            NSArray *chunkItems = chunks == 1 ? items : [items subarrayWithRange:NSMakeRange(start, end - start)];
+            NSArray *blockIdentifiers = [self valuesForItems:chunkItems block:identifierBlock];
+            NSArray *blockSectionNames = [self valuesForItems:chunkItems block:sectionNameBlock];
+            NSMutableArray *resolvedIdentifiers = chunkIdentifiers[chunk];
+            NSMutableArray *resolvedSectionNames = chunkSectionNames[chunk];
+            NSUInteger index = 0;
+            for (id item in chunkItems) {
+                id identifier = blockIdentifiers[index];
+                id sectionName = blockSectionNames[index];
+                [resolvedIdentifiers addObject:identifier == [NSNull null] ? [self defaultIdentifierForItem:item] : identifier];
+                [resolvedSectionNames addObject:sectionName == [NSNull null] ? [self defaultSectionNameForItem:item] : sectionName];
+                index++;
+            }
+        }
+    };
+    if (chunks == 1) {
+        evaluateChunk(0);
+        *identifiers = chunkIdentifiers[0];
+        *sectionNames = chunkSectionNames[0];
+        return;
+    }
+    dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), evaluateChunk);
+    
+    NSMutableArray *allIdentifiers = [[NSMutableArray alloc] initWithCapacity:count];
+    NSMutableArray *allSectionNames = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger chunk = 0; chunk < chunks; chunk++) {
+        [allIdentifiers addObjectsFromArray:chunkIdentifiers[chunk]];
+        [allSectionNames addObjectsFromArray:chunkSectionNames[chunk]];
+    }
+    *identifiers = allIdentifiers;
+    *sectionNames = allSectionNames;
+}
+
+/*
+ Evaluates `block` for each item, returning `NSNull` in place of nil values and values
+ of items that raise an exception, or `NSNull` for every item if `block` is nil. The
+ exception handler is set up once for the whole batch. If an item raises, the remaining
+ items are evaluated individually.
+ */
++ (NSArray *)valuesForItems:(NSArray *)items block:(id (^)(id))block
+{
+    NSMutableArray *values = [[NSMutableArray alloc] initWithCapacity:items.count];
+    if (!block) {
+        for (NSUInteger index = 0; index < items.count; index++) {
+            [values addObject:[NSNull null]];
+        }
+        return values;
+    }
+    @try {
+        for (id item in items) {
+            id value = block(item);
+            [values addObject:value ? value : [NSNull null]];
+        }
+    }
+    @catch (NSException *exception) {
+        [values addObject:[NSNull null]];
+        for (NSUInteger index = values.count; index < items.count; index++) {
+            id value;
+            @try {
+                value = block(items[index]);
+            }
+            @catch (NSException *e) {
+            }
+            [values addObject:value ? value : [NSNull null]];
+        }
+    }
+    return values;
+}
+
+- (id)itemForIdentifier:(id)identifier
+{
+    uint64_t value;
+    if (!TLIdentifierTableGet(&_indexPathsByIdentifier, identifier, &value)) {
+        return nil;
+    }
+    return [self.sections[TLUnpackSection(value)] objects][TLUnpackRow(value)];
+}
+
+- (id)currentVersionOfItem:(id)anotherVersionOfItem
+{
+    id identifier = [self identifierForItem:anotherVersionOfItem];
+    id item = [self itemForIdentifier:identifier];
+    return item;
+}
+
+- (NSString *)sectionNameForItem:(id)item
+{
+    return [[self class] sectionNameForItem:item sectionNameBlock:self.sectionNameBlock];
+}
+
++ (NSString *)sectionNameForItem:(id)item sectionNameBlock:(NSString *(^)(id))sectionNameBlock
+{
+    NSString *sectionName;
+    if (sectionNameBlock) {
+        @try {
+            sectionName = sectionNameBlock(item);
+        } @catch(NSException *e) {
+        }
+    }
+    return sectionName ? sectionName : [self defaultSectionNameForItem:item];
+}
+
++ (NSString *)defaultSectionNameForItem:(id)item
+{
+    NSString *sectionName;
+    if ([item isKindOfClass:[TLIndexPathItem class]]) {
+        sectionName = ((TLIndexPathItem *)item).sectionName;
+    }
+    if (!sectionName) {
+        sectionName = [TLIndexPathDataModelNilSectionName copy];
+    }
+    return sectionName;
+}
+
+#pragma mark - Mutating data models
+
+- (TLIndexPathUpdates *)updatesByPerformingMutations:(void (^)(TLIndexPathDataModelMutations *))mutations
+{
+    TLIndexPathDataModelMutations *dataModelMutations = [[TLIndexPathDataModelMutations alloc] initWithDataModel:self];
+    mutations(dataModelMutations);
+    return [dataModelMutations updates];
+}
+
+@end
@@ -0,0 +1,138 @@
+//
+//  TLIndexPathDataModelMutations.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+#import "TLIndexPathDataModel.h"
+#import "TLIndexPathUpdates.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Records insert, delete, move and replace operations against an existing data model
+ and produces the updated data model along with the corresponding `TLIndexPathUpdates`.
+ This is an alternative to building a new data model from the full items array and
+ diffing it against the old one, which is O(n) twice even when only one item changes.
+ 
+ Sections that aren't touched by any operation are shared with the original data model
+ and only the affected rows of the touched sections are re-indexed. The updates are
+ derived from the applied operations rather than by diffing, so only items that were
+ explicitly moved (or whose section changed) are reported as moved. Items that shift
+ as a result of inserts and deletes are not, and neither are items that are moved back
+ to the index path they started at between the same neighbors.
+ 
+ Operations are applied in order and each one sees the result of the previous ones,
+ so index paths are interpreted relative to the current working state. Invalid
+ operations (e.g. deleting an item that isn't in the data model or inserting a
+ duplicate identifier) are ignored with a warning, consistent with how the data model
+ handles duplicate identifiers.
+ 
+ Mutations are typically performed through `[TLIndexPathDataModel updatesByPerformingMutations:]`:
+ 
+    TLIndexPathUpdates *updates = [self.dataModel updatesByPerformingMutations:^(TLIndexPathDataModelMutations *mutations) {
+        [mutations insertItem:newItem atIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]];
+        [mutations deleteItem:staleItem];
+    }];
+    self.dataModel = updates.updatedDataModel;
+    [updates performBatchUpdatesOnTableView:self.tableView withRowAnimation:UITableViewRowAnimationFade];
+ 
+ Sections are never removed, even if they become empty. New sections are only created
+ by `appendItem:` and are added after the existing sections.
+ */
+
+@interface TLIndexPathDataModelMutations : NSObject
+
+/**
+ Creates a mutations object for the given data model.
+ 
+ @param dataModel  the data model to be mutated
+ */
+- (instancetype)initWithDataModel:(TLIndexPathDataModel *)dataModel;
+
+/**
+ The data model the mutations are applied to.
+ */
+@property (strong, nonatomic, readonly) TLIndexPathDataModel *dataModel;
+
+/**
+ Inserts the item at the given index path. The section must already exist and the
+ row may be equal to the number of rows in the section to insert at the end.
+ 
+ @param item  the item to insert
+ @param indexPath  the index path the item should have after insertion
+ */
+- (void)insertItem:(id)item atIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ Inserts the item at the end of the section determined by the data model's section name
+ rules, creating the section after the existing sections if it doesn't exist.
+ 
+ @param item  the item to insert
+ */
+- (void)appendItem:(id)item;
+
+/**
+ Deletes the item with the same identifier as the given item.
+ 
+ @param item  the item to delete
+ */
+- (void)deleteItem:(id)item;
+
+/**
+ Moves the item with the same identifier as the given item to the given index path.
+ The section must already exist.
+ 
+ @param item  the item to move
+ @param indexPath  the index path the item should have after the move
+ */
+- (void)moveItem:(id)item toIndexPath:(NSIndexPath *)indexPath;
+
+/**
+ Replaces the item with the same identifier as `item` with `newItem` at the same
+ index path. If the identifiers match, the new item is reported as modified unless
+ it is equal to the item being replaced. Otherwise, the replacement is reported
+ as a delete and an insert.
+ 
+ @param item  the item to replace
+ @param newItem  the replacement item
+ */
+- (void)replaceItem:(id)item withItem:(id)newItem;
+
+/**
+ Returns the items of the given section as of the operations performed so far. The
+ returned array may be the working copy of the section, so it is only valid until the
+ next operation is performed.
+ 
+ @param section  the section, which may be one that was created by `appendItem:`
+ */
+- (NSArray *)itemsInSection:(NSInteger)section;
+
+/**
+ Returns the updates for the operations performed so far. The `updatedDataModel`
+ of the returned updates is the mutated data model.
+ */
+- (TLIndexPathUpdates *)updates;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,349 @@
+//
+//  TLIndexPathDataModelMutations.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import "TLIndexPathDataModelMutations.h"
+#import "TLIndexPathSectionInfo.h"
+
+@interface TLIndexPathDataModel (TLIndexPathDataModelMutations)
+- (id)initWithDataModel:(TLIndexPathDataModel *)dataModel sectionInfos:(NSArray *)sectionInfos identifiersBySectionName:(NSDictionary *)identifiersBySectionName;
+- (NSString *)sectionNameForItem:(id)item;
+- (NSArray *)identifiersInSection:(NSInteger)section;
+@end
+
+@interface TLIndexPathDataModelMutations ()
+@property (strong, nonatomic) NSMutableArray *sectionNames;
+@property (strong, nonatomic) NSMutableSet *insertedSectionNames;
+// working copies of the touched sections
+@property (strong, nonatomic) NSMutableDictionary *itemsBySectionName;
+@property (strong, nonatomic) NSMutableDictionary *identifiersBySectionName;
+// current section name of every item touched by an operation, `NSNull` if removed
+@property (strong, nonatomic) NSMutableDictionary *sectionNamesByIdentifier;
+@property (strong, nonatomic) NSMutableOrderedSet *touchedIdentifiers;
+@property (strong, nonatomic) NSMutableSet *movedIdentifiers;
+@end
+
+@implementation TLIndexPathDataModelMutations
+
+- (instancetype)initWithDataModel:(TLIndexPathDataModel *)dataModel
+{
+    if (self = [super init]) {
+        _dataModel = dataModel;
+        _sectionNames = [dataModel.sectionNames mutableCopy];
+        _insertedSectionNames = [[NSMutableSet alloc] init];
+        _itemsBySectionName = [[NSMutableDictionary alloc] init];
+        _identifiersBySectionName = [[NSMutableDictionary alloc] init];
+        _sectionNamesByIdentifier = [[NSMutableDictionary alloc] init];
+        _touchedIdentifiers = [[NSMutableOrderedSet alloc] init];
+        _movedIdentifiers = [[NSMutableSet alloc] init];
+    }
+    return self;
+}
+
+#pragma mark - Operations
+
+- (void)insertItem:(id)item atIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath.section >= self.sectionNames.count) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - invalid section %ld. Insert ignored.", (long)indexPath.section);
+        return;
+    }
+    NSString *sectionName = self.sectionNames[indexPath.section];
+    if (indexPath.row > [[self identifiersForSectionName:sectionName] count]) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - invalid row %ld. Insert ignored.", (long)indexPath.row);
+        return;
+    }
+    [self insertItem:item row:indexPath.row sectionName:sectionName];
+}
+
+- (void)appendItem:(id)item
+{
+    NSString *sectionName = [self.dataModel sectionNameForItem:item];
+    if (![self.sectionNames containsObject:sectionName]) {
+        [self.sectionNames addObject:sectionName];
+        [self.insertedSectionNames addObject:sectionName];
+        [self.itemsBySectionName setObject:[NSMutableArray array] forKey:sectionName];
+        [self.identifiersBySectionName setObject:[NSMutableArray array] forKey:sectionName];
+    }
+    [self insertItem:item row:[[self identifiersForSectionName:sectionName] count] sectionName:sectionName];
+}
+
+- (void)deleteItem:(id)item
+{
+    id identifier = [self.dataModel identifierForItem:item];
+    NSString *sectionName = [self sectionNameForIdentifier:identifier];
+    if (!sectionName) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - item '%@' not found. Delete ignored.", identifier);
+        return;
+    }
+    [self removeIdentifier:identifier sectionName:sectionName];
+}
+
+- (void)moveItem:(id)item toIndexPath:(NSIndexPath *)indexPath
+{
+    id identifier = [self.dataModel identifierForItem:item];
+    NSString *sectionName = [self sectionNameForIdentifier:identifier];
+    if (!sectionName) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - item '%@' not found. Move ignored.", identifier);
+        return;
+    }
+    if (indexPath.section >= self.sectionNames.count) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - invalid section %ld. Move ignored.", (long)indexPath.section);
+        return;
+    }
+    NSString *updatedSectionName = self.sectionNames[indexPath.section];
+    NSInteger count = [[self identifiersForSectionName:updatedSectionName] count];
+    if ([updatedSectionName isEqualToString:sectionName]) {
+        count--;
+    }
+    if (indexPath.row > count) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - invalid row %ld. Move ignored.", (long)indexPath.row);
+        return;
+    }
+    id currentItem = [self removeIdentifier:identifier sectionName:sectionName];
+    [self insertItem:currentItem row:indexPath.row sectionName:updatedSectionName];
+    [self.movedIdentifiers addObject:identifier];
+}
+
+- (void)replaceItem:(id)item withItem:(id)newItem
+{
+    id identifier = [self.dataModel identifierForItem:item];
+    NSString *sectionName = [self sectionNameForIdentifier:identifier];
+    if (!sectionName) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - item '%@' not found. Replace ignored.", identifier);
+        return;
+    }
+    id newIdentifier = [self.dataModel identifierForItem:newItem];
+    if (![newIdentifier isEqual:identifier] && [self sectionNameForIdentifier:newIdentifier]) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - duplicate identifier '%@'. Replace ignored.", newIdentifier);
+        return;
+    }
+    NSMutableArray *identifiers = [self identifiersForSectionName:sectionName];
+    NSUInteger row = [identifiers indexOfObject:identifier];
+    [[self.itemsBySectionName objectForKey:sectionName] replaceObjectAtIndex:row withObject:newItem];
+    [identifiers replaceObjectAtIndex:row withObject:newIdentifier];
+    [self.sectionNamesByIdentifier setObject:[NSNull null] forKey:identifier];
+    [self.sectionNamesByIdentifier setObject:sectionName forKey:newIdentifier];
+    [self.touchedIdentifiers addObject:identifier];
+    [self.touchedIdentifiers addObject:newIdentifier];
+}
+
+- (NSArray *)itemsInSection:(NSInteger)section
+{
+    NSString *sectionName = self.sectionNames[section];
+    NSArray *items = [self.itemsBySectionName objectForKey:sectionName];
+    if (!items) {
+        items = [self.dataModel sectionInfoForSection:section].objects;
+    }
+    return items;
+}
+
+#pragma mark - Updates
+
+- (TLIndexPathUpdates *)updates
+{
+    TLIndexPathDataModel *oldDataModel = self.dataModel;
+    
+    NSMutableArray *sectionInfos = [NSMutableArray arrayWithCapacity:self.sectionNames.count];
+    for (NSString *sectionName in self.sectionNames) {
+        NSArray *items = [self.itemsBySectionName objectForKey:sectionName];
+        NSInteger section = [oldDataModel sectionForSectionName:sectionName];
+        id<NSFetchedResultsSectionInfo> oldSectionInfo = section == NSNotFound ? nil : [oldDataModel sectionInfoForSection:section];
+        if (!items) {
+            // untouched sections are shared with the old data model
+            [sectionInfos addObject:oldSectionInfo];
+        } else {
+            NSString *indexTitle = oldSectionInfo ? oldSectionInfo.indexTitle : sectionName;
+            TLIndexPathSectionInfo *sectionInfo = [[TLIndexPathSectionInfo alloc] initWithItems:[items copy] name:sectionName indexTitle:indexTitle];
+            [sectionInfos addObject:sectionInfo];
+        }
+    }
+    
+    TLIndexPathDataModel *updatedDataModel = [[TLIndexPathDataModel alloc] initWithDataModel:oldDataModel
+                                                                               sectionInfos:sectionInfos
+                                                                   identifiersBySectionName:self.identifiersBySectionName];
+
+    NSMutableArray *insertedItems = [[NSMutableArray alloc] init];
+    NSMutableArray *deletedItems = [[NSMutableArray alloc] init];
+    NSMutableArray *movedItems = [[NSMutableArray alloc] init];
+    NSMutableArray *modifiedItems = [[NSMutableArray alloc] init];
+    
+    for (id identifier in self.touchedIdentifiers) {
+        id oldItem = [oldDataModel itemForIdentifier:identifier];
+        id updatedItem = [updatedDataModel itemForIdentifier:identifier];
+        if (oldItem && updatedItem) {
+            NSIndexPath *oldIndexPath = [oldDataModel indexPathForIdentifier:identifier];
+            NSIndexPath *updatedIndexPath = [updatedDataModel indexPathForIdentifier:identifier];
+            NSString *oldSectionName = [oldDataModel sectionNameForSection:oldIndexPath.section];
+            NSString *updatedSectionName = [updatedDataModel sectionNameForSection:updatedIndexPath.section];
+            if (![oldSectionName isEqualToString:updatedSectionName]
+                || ([self.movedIdentifiers containsObject:identifier] && [self identifier:identifier changedPositionFromIndexPath:oldIndexPath toIndexPath:updatedIndexPath inDataModel:updatedDataModel])) {
+                [movedItems addObject:updatedItem];
+            }
+            if (![oldItem isEqual:updatedItem]) {
+                [modifiedItems addObject:updatedItem];
+            }
+        } else if (oldItem) {
+            [deletedItems addObject:oldItem];
+        } else if (updatedItem) {
+            // Don't insert items in inserted sections
+            if (![self.insertedSectionNames containsObject:[self sectionNameForIdentifier:identifier]]) {
+                [insertedItems addObject:updatedItem];
+            }
+        }
+    }
+    
+    NSMutableArray *insertedSectionNames = [[NSMutableArray alloc] init];
+    for (NSString *sectionName in self.sectionNames) {
+        if ([self.insertedSectionNames containsObject:sectionName]) {
+            [insertedSectionNames addObject:sectionName];
+        }
+    }
+
+    return [[TLIndexPathUpdates alloc] initWithOldDataModel:oldDataModel
+                                           updatedDataModel:updatedDataModel
+                                       insertedSectionNames:insertedSectionNames
+                                              insertedItems:insertedItems
+                                               deletedItems:deletedItems
+                                                 movedItems:movedItems
+                                              modifiedItems:modifiedItems];
+}
+
+/*
+ An item that was removed and inserted again is only reported as moved if it ended up
+ at a different index path or between different neighbors. Otherwise, the removal and
+ insertion cancel out and reporting a move would only animate it in place.
+ */
+- (BOOL)identifier:(id)identifier changedPositionFromIndexPath:(NSIndexPath *)oldIndexPath toIndexPath:(NSIndexPath *)updatedIndexPath inDataModel:(TLIndexPathDataModel *)updatedDataModel
+{
+    if (oldIndexPath.section != updatedIndexPath.section || oldIndexPath.row != updatedIndexPath.row) {
+        return YES;
+    }
+    NSArray *oldIdentifiers = [self.dataModel identifiersInSection:oldIndexPath.section];
+    NSArray *updatedIdentifiers = [updatedDataModel identifiersInSection:updatedIndexPath.section];
+    for (NSInteger row = oldIndexPath.row - 1; row <= oldIndexPath.row + 1; row += 2) {
+        id oldNeighbor = row >= 0 && row < (NSInteger)oldIdentifiers.count ? oldIdentifiers[row] : nil;
+        id updatedNeighbor = row >= 0 && row < (NSInteger)updatedIdentifiers.count ? updatedIdentifiers[row] : nil;
+        if (oldNeighbor != updatedNeighbor && ![oldNeighbor isEqual:updatedNeighbor]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+#pragma mark - Working state
+
+- (NSString *)sectionNameForIdentifier:(id)identifier
+{
+    if (!identifier) {
+        return nil;
+    }
+    id sectionName = [self.sectionNamesByIdentifier objectForKey:identifier];
+    if (sectionName) {
+        return sectionName == [NSNull null] ? nil : sectionName;
+    }
+    NSIndexPath *indexPath = [self.dataModel indexPathForIdentifier:identifier];
+    return indexPath ? [self.dataModel sectionNameForSection:indexPath.section] : nil;
+}
+
+/*
+ Returns the working identifiers for the given section, copying the section
+ out of the data model the first time it is touched.
+ */
+- (NSMutableArray *)identifiersForSectionName:(NSString *)sectionName
+{
+    NSMutableArray *identifiers = [self.identifiersBySectionName objectForKey:sectionName];
+    if (!identifiers) {
+        NSInteger section = [self.dataModel sectionForSectionName:sectionName];
+        id<NSFetchedResultsSectionInfo> sectionInfo = [self.dataModel sectionInfoForSection:section];
+        NSMutableArray *items = [NSMutableArray arrayWithArray:sectionInfo.objects];
+        // reuse the data model's identifiers rather than re-evaluating them. Items
+        // that can't be looked up by identifier remain marked with `NSNull`.
+        identifiers = [NSMutableArray arrayWithArray:[self.dataModel identifiersInSection:section]];
+        [self.itemsBySectionName setObject:items forKey:sectionName];
+        [self.identifiersBySectionName setObject:identifiers forKey:sectionName];
+    }
+    return identifiers;
+}
+
+- (void)insertItem:(id)item row:(NSInteger)row sectionName:(NSString *)sectionName
+{
+    id identifier = [self.dataModel identifierForItem:item];
+    if (!identifier) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - item '%@' has no identifier. Insert ignored.", item);
+        return;
+    }
+    if ([self sectionNameForIdentifier:identifier]) {
+        NSLog(@"WARNING: TLIndexPathDataModelMutations - duplicate identifier '%@'. Insert ignored.", identifier);
+        return;
+    }
+    NSMutableArray *identifiers = [self identifiersForSectionName:sectionName];
+    [[self.itemsBySectionName objectForKey:sectionName] insertObject:item atIndex:row];
+    [identifiers insertObject:identifier atIndex:row];
+    [self.sectionNamesByIdentifier setObject:sectionName forKey:identifier];
+    [self.touchedIdentifiers addObject:identifier];
+    // an item that is removed and inserted again is reported as moved
+    if ([self.dataModel itemForIdentifier:identifier]) {
+        [self.movedIdentifiers addObject:identifier];
+    }
+}
+
+/*
+ Returns the working row of the identifier in the given section. Identifiers are unique
+ in the working state, so the row recorded in the data model's identifier table is used
+ if it still holds the identifier. Otherwise, the item has usually only shifted by the
+ few rows inserted or removed ahead of it, so the search proceeds outward from there.
+ */
+- (NSUInteger)rowForIdentifier:(id)identifier identifiers:(NSArray *)identifiers sectionName:(NSString *)sectionName
+{
+    NSInteger count = identifiers.count;
+    NSIndexPath *indexPath = [self.dataModel indexPathForIdentifier:identifier];
+    NSInteger hint = 0;
+    if (indexPath && [[self.dataModel sectionNameForSection:indexPath.section] isEqualToString:sectionName]) {
+        hint = MIN(indexPath.row, count - 1);
+    }
+    for (NSInteger offset = 0; offset <= MAX(hint, count - 1 - hint); offset++) {
+        if (hint + offset < count && [identifiers[hint + offset] isEqual:identifier]) {
+            return hint + offset;
+        }
+        if (offset > 0 && hint - offset >= 0 && [identifiers[hint - offset] isEqual:identifier]) {
+            return hint - offset;
+        }
+    }
+    return NSNotFound;
+}
+
+- (id)removeIdentifier:(id)identifier sectionName:(NSString *)sectionName
+{
+    NSMutableArray *identifiers = [self identifiersForSectionName:sectionName];
+    NSMutableArray *items = [self.itemsBySectionName objectForKey:sectionName];
+    NSUInteger row = [self rowForIdentifier:identifier identifiers:identifiers sectionName:sectionName];
+    id item = items[row];
+    [items removeObjectAtIndex:row];
+    [identifiers removeObjectAtIndex:row];
+    [self.sectionNamesByIdentifier setObject:[NSNull null] forKey:identifier];
+    [self.touchedIdentifiers addObject:identifier];
+    return item;
+}
+
+@end
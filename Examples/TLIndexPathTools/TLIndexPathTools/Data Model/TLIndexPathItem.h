@@ -40,6 +40,16 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ Optional protocol for `TLIndexPathItem` data that can report a version or fingerprint
+ of its content, such as a revision counter or a digest computed when the data was
+ created. When comparing data, two items whose data both conform are considered equal
+ if their content versions are equal, without calling `isEqual:` or `hash` on the data.
+ */
+@protocol TLIndexPathItemContentVersioning <NSObject>
+- (NSUInteger)contentVersion;
+@end
+
 @interface TLIndexPathItem : NSObject
 @property (strong, nonatomic) id identifier;
 @property (strong, nonatomic, nullable) NSString *sectionName;
@@ -51,6 +61,12 @@ NS_ASSUME_NONNULL_BEGIN
  This affects whether or not the corresponding cell is reloaded in a batch update.
  Specifically, if the value is YES, the `hash` and `isEqual` methods take into
  account the value of `data`. The default value is NO.
+ 
+ The hash is computed once and cached until one of the item's properties is set, and
+ `isEqual:` returns `NO` early when the cached hashes differ. Because of this, `data`
+ should not be mutated in place once the item has been hashed. Assign new data or
+ create a new item instead. If `data` conforms to `TLIndexPathItemContentVersioning`,
+ its content version is used in place of its `hash` and `isEqual:`.
  */
 @property (nonatomic) BOOL shouldCompareData;
 
@@ -24,6 +24,10 @@
 #import "TLIndexPathItem.h"
 
 @implementation TLIndexPathItem
+{
+    // zero until computed. A single word, so concurrent readers see either zero or the hash.
+    NSUInteger _cachedHash;
+}
 
 - (id)initWithIdentifier:(id)identifier sectionName:(NSString *)sectionName cellIdentifier:(NSString *)cellIdentifier data:(id)data
 {
@@ -47,16 +51,58 @@
     return identifiers;
 }
 
+#pragma mark - Invalidating the cached hash
+
+- (void)setIdentifier:(id)identifier
+{
+    _identifier = identifier;
+    _cachedHash = 0;
+}
+
+- (void)setSectionName:(NSString *)sectionName
+{
+    _sectionName = sectionName;
+    _cachedHash = 0;
+}
+
+- (void)setCellIdentifier:(NSString *)cellIdentifier
+{
+    _cellIdentifier = cellIdentifier;
+    _cachedHash = 0;
+}
+
+- (void)setData:(id)data
+{
+    _data = data;
+    _cachedHash = 0;
+}
+
+- (void)setShouldCompareData:(BOOL)shouldCompareData
+{
+    _shouldCompareData = shouldCompareData;
+    _cachedHash = 0;
+}
+
+#pragma mark - Equality
+
 - (NSUInteger)hash
 {
+    NSUInteger cachedHash = _cachedHash;
+    if (cachedHash) {
+        return cachedHash;
+    }
     NSInteger hash = 0;
     hash += 31 * hash + [self.identifier hash];
     hash += 31 * hash + [self.sectionName hash];
     hash += 31 * hash + [self.cellIdentifier hash];
     if (self.shouldCompareData) {
-        hash += 31 * hash + [self.data hash];
+        id data = self.data;
+        hash += 31 * hash + ([data conformsToProtocol:@protocol(TLIndexPathItemContentVersioning)] ? [data contentVersion] : [data hash]);
     }
-    return hash;
+    // zero is reserved for "not computed"
+    cachedHash = hash ? (NSUInteger)hash : 1;
+    _cachedHash = cachedHash;
+    return cachedHash;
 }
 
 - (BOOL)isEqual:(id)object
@@ -65,11 +111,19 @@
     if (object == nil) return NO;
     if (![object isKindOfClass:[TLIndexPathItem class]]) return NO;
     TLIndexPathItem *other = (TLIndexPathItem *)object;
+    if ([self hash] != [other hash]) return NO;
     if (![TLIndexPathItem nilSafeObject:self.identifier isEqual:other.identifier]) return NO;
     if (![TLIndexPathItem nilSafeObject:self.sectionName isEqual:other.sectionName]) return NO;
     if (![TLIndexPathItem nilSafeObject:self.cellIdentifier isEqual:other.cellIdentifier]) return NO;
     if (self.shouldCompareData) {
-        if (![TLIndexPathItem nilSafeObject:self.data isEqual:other.data]) return NO;
+        id data = self.data;
+        id otherData = other.data;
+        if ([data conformsToProtocol:@protocol(TLIndexPathItemContentVersioning)]
+            && [otherData conformsToProtocol:@protocol(TLIndexPathItemContentVersioning)]) {
+            if ([data contentVersion] != [otherData contentVersion]) return NO;
+        } else if (![TLIndexPathItem nilSafeObject:data isEqual:otherData]) {
+            return NO;
+        }
     }
     return YES;
 }
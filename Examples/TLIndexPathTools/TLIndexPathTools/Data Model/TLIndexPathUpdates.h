@@ -0,0 +1,216 @@
+//
+//  TLIndexPathUpdates.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import <UIKit/UIKit.h>
+#import "TLIndexPathDataModel.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Determines how `TLIndexPathUpdates` decides which retained items are reported as moved.
+ */
+typedef NS_ENUM(NSInteger, TLIndexPathUpdatesMoveDetection) {
+
+    /**
+     An item is reported as moved whenever its index path changes, unless the only
+     change is that its section moved. This is the default behavior. Note that a single
+     insert at the top of a section results in every following item being reported
+     as moved.
+     */
+    TLIndexPathUpdatesMoveDetectionIndexPath,
+
+    /**
+     Within a section, only the minimal set of items needed to reproduce the new order
+     is reported as moved. The items kept in place are the longest increasing subsequence
+     of old rows taken in new order, so items that merely shift due to inserts and deletes
+     are not reported. Items that change sections are always reported as moved. This
+     minimizes the number of animated batch update operations.
+     */
+    TLIndexPathUpdatesMoveDetectionMinimal,
+};
+
+/**
+ Determines how the `performBatchUpdates*` methods apply the changes to the view.
+ */
+typedef NS_ENUM(NSInteger, TLIndexPathUpdatesStrategy) {
+
+    /**
+     The strategy is chosen by estimating the cost of the update from the number of
+     operations and how many of them fall within the visible range. See
+     `maximumBatchUpdateCost`. This is the default strategy.
+     */
+    TLIndexPathUpdatesStrategyAutomatic,
+
+    /**
+     All inserts, deletes, moves and reloads are performed as one animated batch update.
+     */
+    TLIndexPathUpdatesStrategyBatchUpdates,
+
+    /**
+     All changes are performed as one batch update, but only those within the visible
+     range are animated. The remaining operations are performed without animation.
+     */
+    TLIndexPathUpdatesStrategyVisibleBatchUpdates,
+
+    /**
+     The view is updated with `reloadData` without animation.
+     */
+    TLIndexPathUpdatesStrategyReloadData,
+};
+
+/**
+ Takes two versions of a data model and computes the changes, i.e. the inserts,
+ moves, deletes and modifications. A variety of `performBatchUpdatesOn*` methods
+ are provided for performing batch updates on the table or collection view.
+ */
+
+@interface TLIndexPathUpdates : NSObject
+
+#pragma mark - Creating updates
+
+/**
+ * Takes two versions of a data model and computes the changes, i.e. the inserts,
+ * moves, deletes and modifications.
+ *
+ * @param oldDataModel                The previous data model.
+ * @param updatedDataModel            The updated data model.
+ * @return A newly initialized TLIndexPathUpdates object.
+ * @see initWithOldDataModel:updatedDataModel:modificationComparatorBlock:
+ */
+- (id)initWithOldDataModel:(TLIndexPathDataModel * __nullable)oldDataModel updatedDataModel:(TLIndexPathDataModel * __nullable)updatedDataModel;
+
+/**
+ * Takes two versions of a data model and computes the changes, i.e. the inserts,
+ * moves, deletes and modifications.
+ *
+ * @param oldDataModel                The previous data model.
+ * @param updatedDataModel            The updated data model.
+ * @param modificationComparatorBlock A block which is used to determine if an old data model object has been modified. This is passed two objects and should return `NO` if the objects are to be considered the same, or `YES` if modifications have occurred. This block can be `nil`.
+ *
+ * @return A newly initialized TLIndexPathUpdates object.
+ * @see initWithOldDataModel:updatedDataModel:
+ */
+- (id)initWithOldDataModel:(TLIndexPathDataModel * __nullable)oldDataModel updatedDataModel:(TLIndexPathDataModel * __nullable)updatedDataModel modificationComparatorBlock:(BOOL(^ __nullable)(id item1, id item2))modificationComparatorBlock;
+
+/**
+ * Takes two versions of a data model and computes the changes, i.e. the inserts,
+ * moves, deletes and modifications, using the specified move detection.
+ *
+ * @param oldDataModel                The previous data model.
+ * @param updatedDataModel            The updated data model.
+ * @param modificationComparatorBlock A block which is used to determine if an old data model object has been modified. This block can be `nil`.
+ * @param moveDetection               Determines which retained items are reported as moved.
+ *
+ * @return A newly initialized TLIndexPathUpdates object.
+ * @see TLIndexPathUpdatesMoveDetection
+ */
+- (id)initWithOldDataModel:(TLIndexPathDataModel * __nullable)oldDataModel updatedDataModel:(TLIndexPathDataModel * __nullable)updatedDataModel modificationComparatorBlock:(BOOL(^ __nullable)(id item1, id item2))modificationComparatorBlock moveDetection:(TLIndexPathUpdatesMoveDetection)moveDetection;
+
+/**
+ * Creates updates from changes that are already known, such as those produced by
+ * `TLIndexPathDataModelMutations`, without diffing the data models. The changes
+ * must be consistent with the two data models. Item index paths are looked up in
+ * `oldDataModel` for deleted items and in `updatedDataModel` for inserted items.
+ *
+ * @param oldDataModel                The previous data model.
+ * @param updatedDataModel            The updated data model.
+ * @param insertedSectionNames        The names of sections that only exist in the updated data model.
+ * @param insertedItems               The inserted items, excluding those in inserted sections.
+ * @param deletedItems                The deleted items.
+ * @param movedItems                  The items to be reported as moved.
+ * @param modifiedItems               The modified items.
+ *
+ * @return A newly initialized TLIndexPathUpdates object.
+ * @see TLIndexPathDataModelMutations
+ */
+- (id)initWithOldDataModel:(TLIndexPathDataModel *)oldDataModel updatedDataModel:(TLIndexPathDataModel *)updatedDataModel insertedSectionNames:(NSArray *)insertedSectionNames insertedItems:(NSArray *)insertedItems deletedItems:(NSArray *)deletedItems movedItems:(NSArray *)movedItems modifiedItems:(NSArray *)modifiedItems;
+
+#pragma mark - Performing batch updates
+
+- (void)performBatchUpdatesOnTableView:(UITableView *)tableView withRowAnimation:(UITableViewRowAnimation)animation;
+- (void)performBatchUpdatesOnTableView:(UITableView *)tableView withRowAnimation:(UITableViewRowAnimation)animation completion:(void(^  __nullable)(BOOL finished))completion;
+- (void)performBatchUpdatesOnCollectionView:(UICollectionView *)collectionView;
+- (void)performBatchUpdatesOnCollectionView:(UICollectionView *)collectionView completion:(void(^ __nullable)(BOOL finished))completion;
+
+#pragma mark - Customizing batch update behavior
+
+/*
+ If `NO`, modified items will be ignored in the `performBatchUpdates*` methods.
+ This can be useful for updating modified items with custom animation.
+ Default value is `YES`.
+ */
+@property (nonatomic) BOOL updateModifiedItems;
+
+/**
+ If set, modified items are reconfigured in place within the batch update instead of
+ being reloaded in a separate pass after it. The block is called with the visible cell
+ displaying each modified item and the item's index path in `updatedDataModel`. It should
+ return `NO` if the cell can't be reused for the updated item, for example because the
+ item's cell identifier changed, in which case the item is reloaded as usual. Modified
+ items without a visible cell are left alone since their cells are configured when they
+ next appear. Ignored if `updateModifiedItems` is `NO`.
+ */
+@property (copy, nonatomic, nullable) BOOL (^reconfigureCellBlock)(id cell, NSIndexPath *indexPath);
+
+/**
+ Determines how the `performBatchUpdates*` methods apply the changes. Default value is
+ `TLIndexPathUpdatesStrategyAutomatic`.
+ */
+@property (nonatomic) TLIndexPathUpdatesStrategy strategy;
+
+/**
+ The maximum estimated cost of a batch update when using `TLIndexPathUpdatesStrategyAutomatic`.
+ Default value is 2000.
+ 
+ Each animated operation (an insert, delete, move or reload within the visible range,
+ or any section operation) is estimated to cost 4, while an operation performed without
+ animation costs 1. A full animated batch update is performed if its cost fits within
+ this limit. Otherwise, a batch update animating only visible changes is performed if
+ its cost fits. Otherwise, the view is updated with `reloadData`, which avoids the
+ multi-second stalls and internal inconsistency exceptions UIKit can produce when
+ thousands of operations are applied at once.
+ */
+@property (nonatomic) NSUInteger maximumBatchUpdateCost;
+
+/**
+ The strategy used by the most recent call to one of the `performBatchUpdates*` methods.
+ This is never `TLIndexPathUpdatesStrategyAutomatic` once changes have been performed.
+ */
+@property (readonly, nonatomic) TLIndexPathUpdatesStrategy performedStrategy;
+
+#pragma mark - Comparing data models
+
+@property (strong, readonly, nonatomic, nullable) TLIndexPathDataModel *oldDataModel;
+@property (strong, readonly, nonatomic, nullable) TLIndexPathDataModel *updatedDataModel;
+@property (readonly, nonatomic) BOOL hasChanges;
+@property (readonly, nonatomic) TLIndexPathUpdatesMoveDetection moveDetection;
+@property (copy, readonly, nonatomic) NSArray *insertedSectionNames;
+@property (copy, readonly, nonatomic) NSArray *deletedSectionNames;
+@property (copy, readonly, nonatomic) NSArray *movedSectionNames;
+@property (copy, readonly, nonatomic) NSArray *insertedItems;
+@property (copy, readonly, nonatomic) NSArray *deletedItems;
+@property (copy, readonly, nonatomic) NSArray *movedItems;
+@property (copy, readonly, nonatomic) NSArray *modifiedItems;
+@end
+
+NS_ASSUME_NONNULL_END
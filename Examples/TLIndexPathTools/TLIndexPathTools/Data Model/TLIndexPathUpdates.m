@@ -31,8 +31,115 @@
 @interface TLIndexPathUpdates ()
 @property (copy, readwrite, nonatomic) NSArray *modifiedItems;
 @property (readwrite, nonatomic) BOOL hasChanges;
+@property (readwrite, nonatomic) TLIndexPathUpdatesStrategy performedStrategy;
 @end
 
+// estimated cost of an animated operation relative to one performed without animation
+static const NSUInteger TLIndexPathUpdatesAnimatedOperationCost = 4;
+
+static const NSUInteger TLIndexPathUpdatesDefaultMaximumBatchUpdateCost = 2000;
+
+/*
+ Returns YES if `indexPath` falls between the first and last visible index paths.
+ Index paths of inserted items are in updated coordinates, so this is an estimate.
+ */
+static BOOL TLIndexPathIsInVisibleRange(NSIndexPath *indexPath, NSIndexPath *firstVisibleIndexPath, NSIndexPath *lastVisibleIndexPath)
+{
+    return indexPath && firstVisibleIndexPath
+        && [indexPath compare:firstVisibleIndexPath] != NSOrderedAscending
+        && [indexPath compare:lastVisibleIndexPath] != NSOrderedDescending;
+}
+
+static void TLGetVisibleRange(NSArray *visibleIndexPaths, NSIndexPath * __strong *firstVisibleIndexPath, NSIndexPath * __strong *lastVisibleIndexPath)
+{
+    *firstVisibleIndexPath = nil;
+    *lastVisibleIndexPath = nil;
+    for (NSIndexPath *indexPath in visibleIndexPaths) {
+        if (!*firstVisibleIndexPath || [indexPath compare:*firstVisibleIndexPath] == NSOrderedAscending) {
+            *firstVisibleIndexPath = indexPath;
+        }
+        if (!*lastVisibleIndexPath || [indexPath compare:*lastVisibleIndexPath] == NSOrderedDescending) {
+            *lastVisibleIndexPath = indexPath;
+        }
+    }
+}
+
+/*
+ Passes `indexPaths` to `update` with `visibleStyle`, or, when the styles differ, splits
+ them into visible and offscreen groups passed with their respective styles.
+ */
+static void TLPerformGroupedUpdates(NSArray *indexPaths, NSIndexPath *firstVisibleIndexPath, NSIndexPath *lastVisibleIndexPath, NSInteger visibleStyle, NSInteger offscreenStyle, void (^update)(NSArray *indexPaths, NSInteger style))
+{
+    if (visibleStyle == offscreenStyle) {
+        update(indexPaths, visibleStyle);
+        return;
+    }
+    NSMutableArray *visibleIndexPaths = [[NSMutableArray alloc] init];
+    NSMutableArray *offscreenIndexPaths = [[NSMutableArray alloc] init];
+    for (NSIndexPath *indexPath in indexPaths) {
+        if (TLIndexPathIsInVisibleRange(indexPath, firstVisibleIndexPath, lastVisibleIndexPath)) {
+            [visibleIndexPaths addObject:indexPath];
+        } else {
+            [offscreenIndexPaths addObject:indexPath];
+        }
+    }
+    if (visibleIndexPaths.count) {
+        update(visibleIndexPaths, visibleStyle);
+    }
+    if (offscreenIndexPaths.count) {
+        update(offscreenIndexPaths, offscreenStyle);
+    }
+}
+
+/*
+ `TLPerformGroupedUpdates` for collection views, where the only style is whether
+ the update is animated.
+ */
+static void TLPerformGroupedAnimatedUpdates(NSArray *indexPaths, NSIndexPath *firstVisibleIndexPath, NSIndexPath *lastVisibleIndexPath, BOOL visibleAnimated, BOOL offscreenAnimated, void (^update)(NSArray *indexPaths, BOOL animated))
+{
+    TLPerformGroupedUpdates(indexPaths, firstVisibleIndexPath, lastVisibleIndexPath, visibleAnimated ? 1 : 0, offscreenAnimated ? 1 : 0, ^(NSArray *groupIndexPaths, NSInteger style) {
+        update(groupIndexPaths, style != 0);
+    });
+}
+
+/*
+ Marks the members of one longest strictly increasing subsequence of `values`
+ in `members` using patience sorting, O(n log n).
+ */
+static void TLLongestIncreasingSubsequence(const NSInteger *values, NSUInteger count, BOOL *members)
+{
+    if (count == 0) {
+        return;
+    }
+    // `tails[k]` is the index of the smallest tail value of an increasing
+    // subsequence of length k + 1
+    NSUInteger *tails = malloc(count * sizeof(NSUInteger));
+    NSUInteger *predecessors = malloc(count * sizeof(NSUInteger));
+    NSUInteger length = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        NSUInteger low = 0;
+        NSUInteger high = length;
+        while (low < high) {
+            NSUInteger mid = (low + high) / 2;
+            if (values[tails[mid]] < values[i]) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        predecessors[i] = low > 0 ? tails[low - 1] : NSNotFound;
+        tails[low] = i;
+        if (low == length) {
+            length++;
+        }
+    }
+    for (NSUInteger i = tails[length - 1]; i != NSNotFound; i = predecessors[i]) {
+        members[i] = YES;
+    }
+    free(predecessors);
+    free(tails);
+}
+
 @implementation TLIndexPathUpdates
 
 - (id)initWithOldDataModel:(TLIndexPathDataModel *)oldDataModel updatedDataModel:(TLIndexPathDataModel *)updatedDataModel
@@ -41,14 +148,21 @@
 }
 
 - (id)initWithOldDataModel:(TLIndexPathDataModel * __nullable)oldDataModel updatedDataModel:(TLIndexPathDataModel * __nullable)updatedDataModel modificationComparatorBlock:(BOOL(^ __nullable)(id item1, id item2))modificationComparatorBlock
+{
+    return [self initWithOldDataModel:oldDataModel updatedDataModel:updatedDataModel modificationComparatorBlock:modificationComparatorBlock moveDetection:TLIndexPathUpdatesMoveDetectionIndexPath];
+}
+
+- (id)initWithOldDataModel:(TLIndexPathDataModel * __nullable)oldDataModel updatedDataModel:(TLIndexPathDataModel * __nullable)updatedDataModel modificationComparatorBlock:(BOOL(^ __nullable)(id item1, id item2))modificationComparatorBlock moveDetection:(TLIndexPathUpdatesMoveDetection)moveDetection
 {
     if (self = [super init]) {
         
         _hasChanges = NO;
+        _moveDetection = moveDetection;
         
         _oldDataModel = oldDataModel;
         _updatedDataModel = updatedDataModel;
         _updateModifiedItems = YES;
+        _maximumBatchUpdateCost = TLIndexPathUpdatesDefaultMaximumBatchUpdateCost;
         
         NSMutableArray *insertedSectionNames = [[NSMutableArray alloc] init];
         NSMutableArray *deletedSectionNames = [[NSMutableArray alloc] init];
@@ -104,6 +218,11 @@
             if ([updatedDataModel containsItem:item]) {
                 NSIndexPath *updatedIndexPath = [updatedDataModel indexPathForItem:item];
                 NSString *updatedSectionName = [updatedDataModel sectionNameForSection:updatedIndexPath.section];
+                // With minimal move detection, items that stay in the same section
+                // are resolved per section below
+                if (moveDetection == TLIndexPathUpdatesMoveDetectionMinimal && [updatedSectionName isEqualToString:sectionName]) {
+                    continue;
+                }
                 // can't rely on isEqual, so must use compare
                 if ([oldIndexPath compare:updatedIndexPath] != NSOrderedSame || ![updatedSectionName isEqualToString:sectionName]) {
                     // Don't move items in moved sections
@@ -127,6 +246,17 @@
             }
         }
         
+        // Minimal moves within sections
+        if (moveDetection == TLIndexPathUpdatesMoveDetectionMinimal) {
+            for (id<NSFetchedResultsSectionInfo>sectionInfo in updatedDataModel.sections) {
+                NSString *sectionName = sectionInfo.name;
+                if (![oldSectionNames containsObject:sectionName] || [movedSectionNames containsObject:sectionName]) {
+                    continue;
+                }
+                [self addMinimalMovesForItems:sectionInfo.objects inSectionNamed:sectionName toArray:movedItems];
+            }
+        }
+
         // Inserted and modified items
         for (id item in updatedDataModel.items) {
             id oldItem = [oldDataModel currentVersionOfItem:item];
@@ -160,6 +290,137 @@
     return self;
 }
 
+- (id)initWithOldDataModel:(TLIndexPathDataModel *)oldDataModel updatedDataModel:(TLIndexPathDataModel *)updatedDataModel insertedSectionNames:(NSArray *)insertedSectionNames insertedItems:(NSArray *)insertedItems deletedItems:(NSArray *)deletedItems movedItems:(NSArray *)movedItems modifiedItems:(NSArray *)modifiedItems
+{
+    if (self = [super init]) {
+        _moveDetection = TLIndexPathUpdatesMoveDetectionMinimal;
+        _oldDataModel = oldDataModel;
+        _updatedDataModel = updatedDataModel;
+        _updateModifiedItems = YES;
+        _maximumBatchUpdateCost = TLIndexPathUpdatesDefaultMaximumBatchUpdateCost;
+        _insertedSectionNames = [insertedSectionNames copy];
+        _deletedSectionNames = @[];
+        _movedSectionNames = @[];
+        _insertedItems = [insertedItems copy];
+        _deletedItems = [deletedItems copy];
+        _movedItems = [movedItems copy];
+        _modifiedItems = [modifiedItems copy];
+        _hasChanges = _insertedSectionNames.count + _insertedItems.count + _deletedItems.count
+            + _movedItems.count + _modifiedItems.count > 0;
+    }
+    return self;
+}
+
+/*
+ Keeps the items whose old rows form the longest increasing subsequence when taken
+ in updated order and reports the remaining retained items as moved. Items that
+ are not reported shift into place as a side effect of the other operations.
+ */
+- (void)addMinimalMovesForItems:(NSArray *)updatedItems inSectionNamed:(NSString *)sectionName toArray:(NSMutableArray *)movedItems
+{
+    NSUInteger capacity = updatedItems.count;
+    if (capacity == 0) {
+        return;
+    }
+    NSMutableArray *retainedItems = [[NSMutableArray alloc] initWithCapacity:capacity];
+    NSInteger *oldRows = malloc(capacity * sizeof(NSInteger));
+    NSUInteger count = 0;
+    for (id item in updatedItems) {
+        NSIndexPath *oldIndexPath = [self.oldDataModel indexPathForItem:item];
+        if (!oldIndexPath) {
+            continue;
+        }
+        NSString *oldSectionName = [self.oldDataModel sectionNameForSection:oldIndexPath.section];
+        if (![oldSectionName isEqualToString:sectionName]) {
+            continue;
+        }
+        [retainedItems addObject:item];
+        oldRows[count++] = oldIndexPath.row;
+    }
+    BOOL *stationary = calloc(MAX(count, 1), sizeof(BOOL));
+    TLLongestIncreasingSubsequence(oldRows, count, stationary);
+    for (NSUInteger i = 0; i < count; i++) {
+        if (!stationary[i]) {
+            [movedItems addObject:retainedItems[i]];
+        }
+    }
+    free(stationary);
+    free(oldRows);
+}
+
+/*
+ Resolves `strategy` using the cost model described for `maximumBatchUpdateCost`. Items
+ are only checked against the visible range when the full animated batch doesn't fit.
+ */
+- (TLIndexPathUpdatesStrategy)strategyForFirstVisibleIndexPath:(NSIndexPath *)firstVisibleIndexPath lastVisibleIndexPath:(NSIndexPath *)lastVisibleIndexPath visibleOperationCount:(NSUInteger *)visibleOperationCount
+{
+    NSUInteger sectionOperationCount = self.insertedSectionNames.count + self.deletedSectionNames.count + self.movedSectionNames.count;
+    NSUInteger reloadCount = self.updateModifiedItems && !self.reconfigureCellBlock ? self.modifiedItems.count : 0;
+    NSUInteger operationCount = sectionOperationCount + self.insertedItems.count + self.deletedItems.count + self.movedItems.count + reloadCount;
+    *visibleOperationCount = operationCount;
+
+    if (self.strategy == TLIndexPathUpdatesStrategyBatchUpdates || self.strategy == TLIndexPathUpdatesStrategyReloadData) {
+        return self.strategy;
+    }
+    if (self.strategy == TLIndexPathUpdatesStrategyAutomatic) {
+        if (operationCount * TLIndexPathUpdatesAnimatedOperationCost <= self.maximumBatchUpdateCost) {
+            return TLIndexPathUpdatesStrategyBatchUpdates;
+        }
+        if (operationCount > self.maximumBatchUpdateCost) {
+            return TLIndexPathUpdatesStrategyReloadData;
+        }
+    }
+
+    // section operations are always counted as visible
+    NSUInteger visibleCount = sectionOperationCount;
+    for (id item in self.insertedItems) {
+        visibleCount += TLIndexPathIsInVisibleRange([self.updatedDataModel indexPathForItem:item], firstVisibleIndexPath, lastVisibleIndexPath);
+    }
+    for (id item in self.deletedItems) {
+        visibleCount += TLIndexPathIsInVisibleRange([self.oldDataModel indexPathForItem:item], firstVisibleIndexPath, lastVisibleIndexPath);
+    }
+    for (id item in self.movedItems) {
+        visibleCount += TLIndexPathIsInVisibleRange([self.oldDataModel indexPathForItem:item], firstVisibleIndexPath, lastVisibleIndexPath)
+            || TLIndexPathIsInVisibleRange([self.updatedDataModel indexPathForItem:item], firstVisibleIndexPath, lastVisibleIndexPath);
+    }
+    if (reloadCount) {
+        for (id item in self.modifiedItems) {
+            visibleCount += TLIndexPathIsInVisibleRange([self.updatedDataModel indexPathForItem:item], firstVisibleIndexPath, lastVisibleIndexPath);
+        }
+    }
+    *visibleOperationCount = visibleCount;
+
+    if (self.strategy == TLIndexPathUpdatesStrategyVisibleBatchUpdates
+        || visibleCount * TLIndexPathUpdatesAnimatedOperationCost + operationCount - visibleCount <= self.maximumBatchUpdateCost) {
+        return TLIndexPathUpdatesStrategyVisibleBatchUpdates;
+    }
+    return TLIndexPathUpdatesStrategyReloadData;
+}
+
+/*
+ Reconfigures the visible cells of modified items with `reconfigureCellBlock` and returns
+ the modified items that still need to be reloaded. Must be called before any other batch
+ update operation because `cellForIndexPath` looks cells up by their old index paths.
+ */
+- (NSArray *)reconfigureModifiedItemsWithCellForIndexPath:(id (^)(NSIndexPath *indexPath))cellForIndexPath
+{
+    if (!self.updateModifiedItems) {
+        return @[];
+    }
+    if (!self.reconfigureCellBlock) {
+        return self.modifiedItems;
+    }
+    NSMutableArray *reloadedItems = [[NSMutableArray alloc] init];
+    for (id item in self.modifiedItems) {
+        NSIndexPath *oldIndexPath = [self.oldDataModel indexPathForItem:item];
+        id cell = oldIndexPath ? cellForIndexPath(oldIndexPath) : nil;
+        if (cell && !self.reconfigureCellBlock(cell, [self.updatedDataModel indexPathForItem:item])) {
+            [reloadedItems addObject:item];
+        }
+    }
+    return reloadedItems;
+}
+
 - (void)performBatchUpdatesOnTableView:(UITableView *)tableView withRowAnimation:(UITableViewRowAnimation)animation
 {
     [self performBatchUpdatesOnTableView:tableView withRowAnimation:animation completion:nil];
@@ -168,6 +429,7 @@
 - (void)performBatchUpdatesOnTableView:(UITableView *)tableView withRowAnimation:(UITableViewRowAnimation)animation completion:(void (^)(BOOL))completion
 {
     if (!self.oldDataModel) {
+        self.performedStrategy = TLIndexPathUpdatesStrategyReloadData;
         [tableView reloadData];
         if (completion) {
             completion(YES);
@@ -175,32 +437,57 @@
         return;
     }
 
+    NSIndexPath *firstVisibleIndexPath;
+    NSIndexPath *lastVisibleIndexPath;
+    TLGetVisibleRange([tableView indexPathsForVisibleRows], &firstVisibleIndexPath, &lastVisibleIndexPath);
+    NSUInteger visibleOperationCount;
+    TLIndexPathUpdatesStrategy strategy = [self strategyForFirstVisibleIndexPath:firstVisibleIndexPath lastVisibleIndexPath:lastVisibleIndexPath visibleOperationCount:&visibleOperationCount];
+    self.performedStrategy = strategy;
+
+    if (strategy == TLIndexPathUpdatesStrategyReloadData) {
+        [tableView reloadData];
+        if (completion) {
+            completion(YES);
+        }
+        return;
+    }
+
+    UITableViewRowAnimation offscreenAnimation = strategy == TLIndexPathUpdatesStrategyVisibleBatchUpdates ? UITableViewRowAnimationNone : animation;
+
+    __block NSArray *reloadedItems = @[];
+
     [CATransaction begin];
 
     [CATransaction setCompletionBlock: ^{
-        
+
         //modified items have to be reloaded after all other batch updates
         //because, otherwise, the table view will throw an exception about
         //duplicate animations being applied to cells. This doesn't always look
         //nice, but it is better than a crash.
-        
-        if (self.modifiedItems.count && self.updateModifiedItems) {
+
+        if (reloadedItems.count) {
             NSMutableArray *indexPaths = [[NSMutableArray alloc] init];
-            for (id item in self.modifiedItems) {
+            for (id item in reloadedItems) {
                 NSIndexPath *indexPath = [self.updatedDataModel indexPathForItem:item];
                 [indexPaths addObject:indexPath];
             }
-            [tableView reloadRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+            TLPerformGroupedUpdates(indexPaths, firstVisibleIndexPath, lastVisibleIndexPath, animation, offscreenAnimation, ^(NSArray *rowIndexPaths, NSInteger rowAnimation) {
+                [tableView reloadRowsAtIndexPaths:rowIndexPaths withRowAnimation:rowAnimation];
+            });
         }
-        
+
         if (completion) {
             completion(YES);
         }
-        
+
     }];
 
     [tableView beginUpdates];
-    
+
+    reloadedItems = [self reconfigureModifiedItemsWithCellForIndexPath:^id(NSIndexPath *indexPath) {
+        return [tableView cellForRowAtIndexPath:indexPath];
+    }];
+
     if (self.insertedSectionNames.count) {
         NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
         for (NSString *sectionName in self.insertedSectionNames) {
@@ -209,7 +496,7 @@
         }
         [tableView insertSections:indexSet withRowAnimation:animation];
     }
-    
+
     if (self.deletedSectionNames.count) {
         NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
         for (NSString *sectionName in self.deletedSectionNames) {
@@ -218,7 +505,7 @@
         }
         [tableView deleteSections:indexSet withRowAnimation:animation];
     }
-    
+
 //    // TODO Disable reordering sections because it may cause duplicate animations
 //    // when a item is inserted, deleted, or moved in that section. Need to figure
 //    // out how to avoid the duplicate animation.
@@ -229,34 +516,40 @@
 //            [tableView moveSection:oldSection toSection:updatedSection];
 //        }
 //    }
-    
+
     if (self.insertedItems.count) {
         NSMutableArray *indexPaths = [[NSMutableArray alloc] init];
         for (id item in self.insertedItems) {
             NSIndexPath *indexPath = [self.updatedDataModel indexPathForItem:item];
             [indexPaths addObject:indexPath];
         }
-        [tableView insertRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+        TLPerformGroupedUpdates(indexPaths, firstVisibleIndexPath, lastVisibleIndexPath, animation, offscreenAnimation, ^(NSArray *rowIndexPaths, NSInteger rowAnimation) {
+            [tableView insertRowsAtIndexPaths:rowIndexPaths withRowAnimation:rowAnimation];
+        });
     }
-    
+
     if (self.deletedItems.count) {
         NSMutableArray *indexPaths = [[NSMutableArray alloc] init];
         for (id item in self.deletedItems) {
             NSIndexPath *indexPath = [self.oldDataModel indexPathForItem:item];
             [indexPaths addObject:indexPath];
         }
-        [tableView deleteRowsAtIndexPaths:indexPaths withRowAnimation:animation];
+        TLPerformGroupedUpdates(indexPaths, firstVisibleIndexPath, lastVisibleIndexPath, animation, offscreenAnimation, ^(NSArray *rowIndexPaths, NSInteger rowAnimation) {
+            [tableView deleteRowsAtIndexPaths:rowIndexPaths withRowAnimation:rowAnimation];
+        });
     }
-    
+
     if (self.movedItems.count) {
         for (id item in self.movedItems) {
             NSIndexPath *oldIndexPath = [self.oldDataModel indexPathForItem:item];
             NSIndexPath *updatedIndexPath = [self.updatedDataModel indexPathForItem:item];
-            
+
             NSString *oldSectionName = [self.oldDataModel sectionNameForSection:oldIndexPath.section];
             NSString *updatedSectionName = [self.updatedDataModel sectionNameForSection:updatedIndexPath.section];
             BOOL oldSectionDeleted = [self.deletedSectionNames containsObject:oldSectionName];
             BOOL updatedSectionInserted = [self.insertedSectionNames containsObject:updatedSectionName];
+            UITableViewRowAnimation oldAnimation = TLIndexPathIsInVisibleRange(oldIndexPath, firstVisibleIndexPath, lastVisibleIndexPath) ? animation : offscreenAnimation;
+            UITableViewRowAnimation updatedAnimation = TLIndexPathIsInVisibleRange(updatedIndexPath, firstVisibleIndexPath, lastVisibleIndexPath) ? animation : offscreenAnimation;
             // `UITableView` doesn't support moving an item out of a deleted section
             // or moving an item into an inserted section. So we use inserts and/or deletes
             // as a workaround. A better workaround can be employed in client code by
@@ -268,19 +561,19 @@
             if (oldSectionDeleted && updatedSectionInserted) {
                 // don't need to do anything
             } else if (oldSectionDeleted) {
-                [tableView insertRowsAtIndexPaths:@[updatedIndexPath] withRowAnimation:animation];
+                [tableView insertRowsAtIndexPaths:@[updatedIndexPath] withRowAnimation:updatedAnimation];
             } else if (updatedSectionInserted) {
-                [tableView deleteRowsAtIndexPaths:@[oldIndexPath] withRowAnimation:animation];
-                [tableView insertRowsAtIndexPaths:@[updatedIndexPath] withRowAnimation:animation];
+                [tableView deleteRowsAtIndexPaths:@[oldIndexPath] withRowAnimation:oldAnimation];
+                [tableView insertRowsAtIndexPaths:@[updatedIndexPath] withRowAnimation:updatedAnimation];
             } else {
                 [tableView moveRowAtIndexPath:oldIndexPath toIndexPath:updatedIndexPath];
             }
 
         }
     }
-    
+
     [tableView endUpdates];
-    
+
     [CATransaction commit];
 }
 
@@ -297,29 +590,45 @@
         }
         return;
     }
-    
+
     //TODO this entire block of code seems to be unnecessary as of iOS 6.1.3 (it is
     //here to work around a crash on the first batch update when the collection view is
     //starting with zero items). Need to do more testing before removing.
     if (self.oldDataModel.items.count == 0) {
-        [collectionView reloadData];
-        //asking the collection view how many items it has in each section
-        //resolves a bug where the collection view can sometimes be confused
-        //about the number of items it has after reloadData, leading to an
-        //internal inconsistency exception on subsequent batch updates. (The scenario
-        //that this fixed for me was when the first insert had only 1 item. On the next
-        //insert, however many items were being inserted, the collection view thought
-        //it already had that many items, causing the next insert to crash.)
-        for (int i = 0; i < collectionView.numberOfSections; i++) {
-            [collectionView numberOfItemsInSection:i];
+        self.performedStrategy = TLIndexPathUpdatesStrategyReloadData;
+        [self reloadCollectionView:collectionView];
+        if (completion) {
+            completion(YES);
         }
+        return;
+    }
+
+    NSIndexPath *firstVisibleIndexPath;
+    NSIndexPath *lastVisibleIndexPath;
+    TLGetVisibleRange([collectionView indexPathsForVisibleItems], &firstVisibleIndexPath, &lastVisibleIndexPath);
+    NSUInteger visibleOperationCount;
+    TLIndexPathUpdatesStrategy strategy = [self strategyForFirstVisibleIndexPath:firstVisibleIndexPath lastVisibleIndexPath:lastVisibleIndexPath visibleOperationCount:&visibleOperationCount];
+    self.performedStrategy = strategy;
+
+    if (strategy == TLIndexPathUpdatesStrategyReloadData) {
+        [self reloadCollectionView:collectionView];
         if (completion) {
             completion(YES);
         }
         return;
     }
 
-    [collectionView performBatchUpdates:^{
+    // `UICollectionView` has no per-operation animation, so only a batch without any
+    // visible operations can be performed silently
+    BOOL visibleOnly = strategy == TLIndexPathUpdatesStrategyVisibleBatchUpdates;
+
+    __block NSArray *reloadedItems = @[];
+
+    void (^updates)(void) = ^{
+
+        reloadedItems = [self reconfigureModifiedItemsWithCellForIndexPath:^id(NSIndexPath *indexPath) {
+            return [collectionView cellForItemAtIndexPath:indexPath];
+        }];
 
         if (self.insertedSectionNames.count) {
             NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
@@ -329,7 +638,7 @@
             }
             [collectionView insertSections:indexSet];
         }
-        
+
         if (self.deletedSectionNames.count) {
             NSMutableIndexSet *indexSet = [[NSMutableIndexSet alloc] init];
             for (NSString *sectionName in self.deletedSectionNames) {
@@ -338,7 +647,7 @@
             }
             [collectionView deleteSections:indexSet];
         }
-        
+
         if (self.movedSectionNames.count) {
             for (NSString *sectionName in self.movedSectionNames) {
                 NSInteger oldSection = [self.oldDataModel sectionForSectionName:sectionName];
@@ -346,7 +655,7 @@
                 [collectionView moveSection:oldSection toSection:updatedSection];
             }
         }
-        
+
         if (self.insertedItems.count) {
             NSMutableArray *indexPaths = [[NSMutableArray alloc] init];
             for (id item in self.insertedItems) {
@@ -355,7 +664,7 @@
             }
             [collectionView insertItemsAtIndexPaths:indexPaths];
         }
-        
+
         if (self.deletedItems.count) {
             NSMutableArray *indexPaths = [[NSMutableArray alloc] init];
             for (id item in self.deletedItems) {
@@ -364,7 +673,7 @@
             }
             [collectionView deleteItemsAtIndexPaths:indexPaths];
         }
-        
+
         for (id item in self.movedItems) {
             NSIndexPath *oldIndexPath = [self.oldDataModel indexPathForItem:item];
             NSIndexPath *updatedIndexPath = [self.updatedDataModel indexPathForItem:item];
@@ -392,25 +701,58 @@
             }
         }
 
-    } completion:^(BOOL finished) {
+    };
+
+    void (^updatesCompletion)(BOOL) = ^(BOOL finished) {
 
         // Doing this in the batch updates can result in poor looking animation when
         // an item is moving and reloading at the same time. The resulting animation
         // can show to versions of the cell, one version remains in the original spot
         // and fades out, while the other version slides to the new location.
-        if (self.modifiedItems.count && self.updateModifiedItems) {
+        if (reloadedItems.count) {
             NSMutableArray *indexPaths = [[NSMutableArray alloc] init];
-            for (id item in self.modifiedItems) {
+            for (id item in reloadedItems) {
                 NSIndexPath *indexPath = [self.updatedDataModel indexPathForItem:item];
                 [indexPaths addObject:indexPath];
             }
-            [collectionView reloadItemsAtIndexPaths:indexPaths];
+            TLPerformGroupedAnimatedUpdates(indexPaths, firstVisibleIndexPath, lastVisibleIndexPath, YES, !visibleOnly, ^(NSArray *itemIndexPaths, BOOL animated) {
+                if (animated) {
+                    [collectionView reloadItemsAtIndexPaths:itemIndexPaths];
+                } else {
+                    [UIView performWithoutAnimation:^{
+                        [collectionView reloadItemsAtIndexPaths:itemIndexPaths];
+                    }];
+                }
+            });
         }
 
         if (completion) {
             completion(finished);
         }
-    }];    
+    };
+
+    if (visibleOnly && visibleOperationCount == 0) {
+        [UIView performWithoutAnimation:^{
+            [collectionView performBatchUpdates:updates completion:updatesCompletion];
+        }];
+    } else {
+        [collectionView performBatchUpdates:updates completion:updatesCompletion];
+    }
+}
+
+- (void)reloadCollectionView:(UICollectionView *)collectionView
+{
+    [collectionView reloadData];
+    //asking the collection view how many items it has in each section
+    //resolves a bug where the collection view can sometimes be confused
+    //about the number of items it has after reloadData, leading to an
+    //internal inconsistency exception on subsequent batch updates. (The scenario
+    //that this fixed for me was when the first insert had only 1 item. On the next
+    //insert, however many items were being inserted, the collection view thought
+    //it already had that many items, causing the next insert to crash.)
+    for (int i = 0; i < collectionView.numberOfSections; i++) {
+        [collectionView numberOfItemsInSection:i];
+    }
 }
 
 - (void)setModifiedItems:(NSArray *)modifiedItems
@@ -22,6 +22,7 @@
 //  THE SOFTWARE.
 
 #import "TLIndexPathDataModel.h"
+#import "TLIndexPathUpdates.h"
 
 @interface TLCollapsibleDataModel : TLIndexPathDataModel
 @property (copy, nonatomic, readonly) NSSet *collapsedSectionNames;
@@ -30,4 +31,15 @@
 - (BOOL)isSectionCollapsed:(NSInteger)section;
 - (id)initWithBackingDataModel:(TLIndexPathDataModel *)backingDataModel collapsedSectionNames:(NSSet *)collapsedSectionNames;
 - (id)initWithBackingDataModel:(TLIndexPathDataModel *)backingDataModel expandedSectionNames:(NSSet *)expandedSectionNames;
+
+/**
+ Returns the updates for changing which sections are collapsed. Only the sections whose
+ collapsed state changes are re-indexed, reusing the backing data model's identifiers for
+ sections being expanded, so the cost is proportional to the number of rows in those
+ sections rather than the whole data model. The items of collapsed sections are reported
+ as deleted and those of expanded sections as inserted without diffing. The updated data
+ model is available through the `updatedDataModel` property and can be applied with
+ `[TLIndexPathController setDataModelWithUpdates:]`.
+ */
+- (TLIndexPathUpdates *)updatesBySettingCollapsedSectionNames:(NSSet *)collapsedSectionNames;
 @end
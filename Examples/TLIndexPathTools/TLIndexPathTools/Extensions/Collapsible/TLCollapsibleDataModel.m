@@ -24,6 +24,11 @@
 #import "TLCollapsibleDataModel.h"
 #import "TLIndexPathSectionInfo.h"
 
+@interface TLIndexPathDataModel (TLCollapsibleDataModel)
+- (id)initWithDataModel:(TLIndexPathDataModel *)dataModel sectionInfos:(NSArray *)sectionInfos identifiersBySectionName:(NSDictionary *)identifiersBySectionName;
+- (NSArray *)identifiersInSection:(NSInteger)section;
+@end
+
 @implementation TLCollapsibleDataModel
 
 #pragma mark - Initialization
@@ -72,6 +77,54 @@
     return otherSectionNames;
 }
 
+#pragma mark - Changing collapsed state
+
+- (TLIndexPathUpdates *)updatesBySettingCollapsedSectionNames:(NSSet *)collapsedSectionNames
+{
+    // sections line up one-to-one with the backing data model, so only the sections
+    // whose state changes need new section infos and identifiers
+    NSMutableArray *sectionInfos = [NSMutableArray arrayWithArray:self.sections];
+    NSMutableDictionary *identifiersBySectionName = [NSMutableDictionary dictionary];
+    NSMutableSet *expandedSectionNames = [NSMutableSet set];
+    NSMutableArray *insertedItems = [NSMutableArray array];
+    NSMutableArray *deletedItems = [NSMutableArray array];
+    NSInteger section = 0;
+    for (id<NSFetchedResultsSectionInfo>backingSectionInfo in self.backingDataModel.sections) {
+        NSString *sectionName = backingSectionInfo.name;
+        BOOL collapsed = [collapsedSectionNames containsObject:sectionName];
+        if (!collapsed) {
+            [expandedSectionNames addObject:sectionName];
+        }
+        if (collapsed != [self.collapsedSectionNames containsObject:sectionName]) {
+            if (collapsed) {
+                [deletedItems addObjectsFromArray:[sectionInfos[section] objects]];
+                sectionInfos[section] = [[TLIndexPathSectionInfo alloc] initWithItems:@[] name:sectionName indexTitle:backingSectionInfo.indexTitle];
+                [identifiersBySectionName setObject:@[] forKey:sectionName];
+            } else {
+                [insertedItems addObjectsFromArray:backingSectionInfo.objects];
+                sectionInfos[section] = backingSectionInfo;
+                [identifiersBySectionName setObject:[self.backingDataModel identifiersInSection:section] forKey:sectionName];
+            }
+        }
+        section++;
+    }
+    
+    TLCollapsibleDataModel *dataModel = [[TLCollapsibleDataModel alloc] initWithDataModel:self
+                                                                             sectionInfos:sectionInfos
+                                                                 identifiersBySectionName:identifiersBySectionName];
+    dataModel->_collapsedSectionNames = [collapsedSectionNames copy];
+    dataModel->_expandedSectionNames = expandedSectionNames;
+    dataModel->_backingDataModel = self.backingDataModel;
+    
+    return [[TLIndexPathUpdates alloc] initWithOldDataModel:self
+                                           updatedDataModel:dataModel
+                                       insertedSectionNames:@[]
+                                              insertedItems:insertedItems
+                                               deletedItems:deletedItems
+                                                 movedItems:@[]
+                                              modifiedItems:@[]];
+}
+
 #pragma mark - Collapsed state information
 
 - (BOOL)isSectionCollapsed:(NSInteger)section
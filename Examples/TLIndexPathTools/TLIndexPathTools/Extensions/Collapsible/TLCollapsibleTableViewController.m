@@ -112,7 +112,9 @@
         collapsed = YES;
     }
 
-    self.dataModel = [[TLCollapsibleDataModel alloc] initWithBackingDataModel:self.dataModel.backingDataModel collapsedSectionNames:collapsedSectionNames];
+    //only the toggled sections are re-indexed and their rows are reported directly
+    TLIndexPathUpdates *updates = [self.dataModel updatesBySettingCollapsedSectionNames:collapsedSectionNames];
+    [self.indexPathController setDataModelWithUpdates:updates];
 
     if ([self.delegate respondsToSelector:@selector(controller:didChangeSection:collapsed:)]) {
         [self.delegate controller:self didChangeSection:section collapsed:collapsed];
@@ -0,0 +1,83 @@
+//
+//  TLRowHeightIndex.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A prefix-sum (Fenwick tree) index of the row heights of a single table view section.
+ Updating a row's height, looking up a row's offset from the top of the section and
+ finding how many rows fit in a given height are all O(log n), which lets scroll
+ position calculations avoid walking every row of large sections.
+ 
+ `TLTableViewController` maintains instances of this class for its sections.
+ See `[TLTableViewController rowHeightIndexForSection:]`.
+ */
+
+@interface TLRowHeightIndex : NSObject
+
+/**
+ Creates an index for the given number of rows, calling `heightBlock` once per row. O(n).
+ 
+ @param count  the number of rows
+ @param heightBlock  block that returns the height of the given row
+ */
+- (instancetype)initWithCount:(NSUInteger)count heightBlock:(CGFloat(^)(NSUInteger row))heightBlock;
+
+/**
+ The number of rows in the index.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ The sum of all row heights.
+ */
+@property (nonatomic, readonly) CGFloat totalHeight;
+
+/**
+ Returns the height of the given row.
+ */
+- (CGFloat)heightForRow:(NSUInteger)row;
+
+/**
+ Sets the height of the given row. O(log n).
+ */
+- (void)setHeight:(CGFloat)height forRow:(NSUInteger)row;
+
+/**
+ Returns the sum of the heights of the rows before the given row, i.e. the row's
+ offset from the top of the first row. `row` may be equal to `count`. O(log n).
+ */
+- (CGFloat)offsetForRow:(NSUInteger)row;
+
+/**
+ Returns the number of leading rows whose combined height is less than or equal to
+ the given height. O(log n).
+ */
+- (NSUInteger)numberOfRowsFittingHeight:(CGFloat)height;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,114 @@
+//
+//  TLRowHeightIndex.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import "TLRowHeightIndex.h"
+
+@interface TLRowHeightIndex ()
+{
+    // 1-based Fenwick tree where `_tree[i]` is the sum of the heights of rows
+    // (i - lowbit(i), i]
+    CGFloat *_tree;
+    CGFloat *_heights;
+    NSUInteger _mostSignificantBit;
+}
+@end
+
+@implementation TLRowHeightIndex
+
+- (instancetype)initWithCount:(NSUInteger)count heightBlock:(CGFloat (^)(NSUInteger))heightBlock
+{
+    if (self = [super init]) {
+        _count = count;
+        _tree = calloc(count + 1, sizeof(CGFloat));
+        _heights = calloc(MAX(count, 1), sizeof(CGFloat));
+        for (NSUInteger row = 0; row < count; row++) {
+            CGFloat height = heightBlock(row);
+            _heights[row] = height;
+            _tree[row + 1] = height;
+            _totalHeight += height;
+        }
+        // build in O(n) by pushing each node's sum to its parent
+        for (NSUInteger i = 1; i <= count; i++) {
+            NSUInteger parent = i + (i & -i);
+            if (parent <= count) {
+                _tree[parent] += _tree[i];
+            }
+        }
+        _mostSignificantBit = 1;
+        while (_mostSignificantBit <= count / 2) {
+            _mostSignificantBit <<= 1;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_tree);
+    free(_heights);
+}
+
+- (CGFloat)heightForRow:(NSUInteger)row
+{
+    return row < self.count ? _heights[row] : 0;
+}
+
+- (void)setHeight:(CGFloat)height forRow:(NSUInteger)row
+{
+    if (row >= self.count) {
+        return;
+    }
+    CGFloat delta = height - _heights[row];
+    _heights[row] = height;
+    _totalHeight += delta;
+    for (NSUInteger i = row + 1; i <= self.count; i += i & -i) {
+        _tree[i] += delta;
+    }
+}
+
+- (CGFloat)offsetForRow:(NSUInteger)row
+{
+    CGFloat offset = 0;
+    for (NSUInteger i = MIN(row, self.count); i > 0; i -= i & -i) {
+        offset += _tree[i];
+    }
+    return offset;
+}
+
+- (NSUInteger)numberOfRowsFittingHeight:(CGFloat)height
+{
+    // descend the implicit tree, consuming as many complete ranges as fit
+    NSUInteger rows = 0;
+    CGFloat remaining = height;
+    for (NSUInteger step = self.count ? _mostSignificantBit : 0; step > 0; step >>= 1) {
+        NSUInteger next = rows + step;
+        if (next <= self.count && _tree[next] <= remaining) {
+            rows = next;
+            remaining -= _tree[next];
+        }
+    }
+    return rows;
+}
+
+@end
@@ -0,0 +1,103 @@
+//
+//  TLTreeDataModel.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+/**
+ A data model representing a heirarchy of `TLIndexPathTreeItem` nodes in a given
+ collapsed stated. This class must be initialized by using one of the two initializers
+ defined here, providing either an array of top level `TLIndexPathTreeItem` nodes
+ or an array of `TLIndexPathSectionInfos` containing top level nodes (particularly
+ if empty sections are needed) and the current set of collapsed node identifiers.
+ 
+ These initializers flatten the heirarchy into the array of items to be displayed
+ in the table. This flattened data is passed up to the `TLIndexPathDataModel`
+ initializer and, thus, the basic data model APIs reflect only the flattened data
+ to be displayed. The full data heirarchy is retained in the `treeItems`
+ and `treeItemSections` properties.
+ 
+ This data model can be plugged into a `TLTableViewController`, but
+ one should normally use `TLTreeTableViewController` because it contains the
+ additional logic to automatically update the data model as rows are expanded
+ and collapsed. It also provides a mechanism to lazy load nodes.
+ */
+
+#import "TLIndexPathDataModel.h"
+#import "TLIndexPathUpdates.h"
+#import "TLIndexPathTreeItem.h"
+
+@interface TLTreeDataModel : TLIndexPathDataModel
+@property (copy, nonatomic, readonly) NSArray *collapsedNodeIdentifiers;
+/**
+ The collapsed node identifiers as a set. This is the stored representation and should
+ be preferred over `collapsedNodeIdentifiers` for membership tests.
+ */
+@property (strong, nonatomic, readonly) NSSet *collapsedNodeIdentifierSet;
+@property (copy, nonatomic, readonly) NSArray *treeItems;
+@property (copy, nonatomic, readonly) NSArray *treeItemSections;
+- (instancetype)initWithTreeItems:(NSArray *)treeItems collapsedNodeIdentifiers:(NSArray *)collapsedNodeIdentifiers;
+- (instancetype)initWithTreeItemSections:(NSArray *)treeItemSections collapsedNodeIdentifiers:(NSArray *)collapsedNodeIdentifiers;
+
+/**
+ Returns the updates for changing the collapsed node identifiers in a way that only
+ affects the visibility of the given node's descendants, such as when the node is
+ expanded or collapsed. The node's currently visible descendants are spliced out of
+ the flattened data and replaced with those visible under `collapsedNodeIdentifiers`,
+ so the cost is proportional to the size of the visible subtree rather than the whole
+ tree. The inserted and deleted items are reported directly rather than by diffing.
+ The updated data model is available through the `updatedDataModel` property and can
+ be applied with `[TLIndexPathController setDataModelWithUpdates:]`.
+ 
+ Returns `nil` if the node isn't visible.
+ 
+ @param collapsedNodeIdentifiers  the new collapsed node identifiers. Nodes outside of
+        the given node's subtree must have the same collapsed state as before.
+ @param identifier  the identifier of the node being expanded or collapsed
+ */
+- (TLIndexPathUpdates *)updatesBySettingCollapsedNodeIdentifiers:(NSArray *)collapsedNodeIdentifiers forNodeWithIdentifier:(id)identifier;
+
+/**
+ A variant of `updatesBySettingCollapsedNodeIdentifiers:forNodeWithIdentifier:` that
+ takes the collapsed node identifiers as a set.
+ */
+- (TLIndexPathUpdates *)updatesBySettingCollapsedNodeIdentifierSet:(NSSet *)collapsedNodeIdentifierSet forNodeWithIdentifier:(id)identifier;
+
+/**
+ Returns the updates for replacing a visible node with a new version, such as when
+ lazy loading its children. Only the node's ancestors are copied; all other nodes are
+ shared with this data model. The node's visible descendants are spliced out of the
+ flattened data and replaced with the new version's, so the cost is proportional to
+ the depth of the node and the size of its old and new subtrees rather than the whole
+ tree. The changes are reported directly rather than by diffing. The updated data model
+ is available through the `updatedDataModel` property.
+ 
+ Descendant identifiers that are no longer in the node's subtree are removed from the
+ collapsed node identifiers and `collapsedChildNodeIdentifiers` are added.
+ 
+ Returns `nil` if there is no visible node with the item's identifier.
+ 
+ @param treeItem  the new version of the node
+ @param collapsedChildNodeIdentifiers  identifiers of nodes in the new version's subtree
+        that should be collapsed
+ */
+- (TLIndexPathUpdates *)updatesByReplacingTreeItem:(TLIndexPathTreeItem *)treeItem collapsedChildNodeIdentifiers:(NSArray *)collapsedChildNodeIdentifiers;
+
+@end
@@ -0,0 +1,322 @@
+//
+//  TLTreeDataModel.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "TLTreeDataModel.h"
+#import "TLIndexPathTreeItem.h"
+#import "TLIndexPathSectionInfo.h"
+
+@interface TLIndexPathDataModel (TLTreeDataModel)
+- (id)initWithDataModel:(TLIndexPathDataModel *)dataModel sectionInfos:(NSArray *)sectionInfos identifiersBySectionName:(NSDictionary *)identifiersBySectionName;
+- (NSArray *)identifiersInSection:(NSInteger)section;
+@end
+
+@implementation TLTreeDataModel
+
+- (instancetype)initWithTreeItems:(NSArray *)treeItems collapsedNodeIdentifiers:(NSArray *)collapsedNodeIdentifiers
+{
+    // let `TLIndexPathDataModel` organize the tree items into sections and then
+    // use the section-based inititializer
+    TLIndexPathDataModel *tempDataModel = [[TLIndexPathDataModel alloc] initWithItems:treeItems];
+    return [self initWithTreeItemSections:tempDataModel.sections collapsedNodeIdentifiers:collapsedNodeIdentifiers];
+}
+
+- (instancetype)initWithTreeItemSections:(NSArray *)treeItemSections collapsedNodeIdentifiers:(NSArray *)collapsedNodeIdentifiers
+{
+    NSSet *collapsedNodeIdentifierSet = [NSSet setWithArray:collapsedNodeIdentifiers];
+    NSMutableArray *treeItems = [NSMutableArray array];
+    NSMutableArray *sections = [NSMutableArray arrayWithCapacity:[treeItemSections count]];
+    for (id<NSFetchedResultsSectionInfo>treeItemSection in treeItemSections) {
+        [treeItems addObjectsFromArray:[treeItemSection objects]];
+        NSMutableArray *items = [NSMutableArray array];
+        for (TLIndexPathTreeItem *item in [treeItemSection objects]) {
+            [self flattenTreeItem:item intoArray:items withCollapsedNodeIdentifiers:collapsedNodeIdentifierSet];
+        }
+        TLIndexPathSectionInfo *section = [[TLIndexPathSectionInfo alloc] initWithItems:items
+                                                                                   name:treeItemSection.name
+                                                                             indexTitle:treeItemSection.indexTitle];
+        [sections addObject:section];
+    }
+    if (self = [super initWithSectionInfos:sections identifierKeyPath:nil]) {
+        _treeItems = treeItems;
+        _treeItemSections = treeItemSections;
+        _collapsedNodeIdentifierSet = collapsedNodeIdentifierSet;
+    }
+    return self;
+}
+
+- (NSArray *)collapsedNodeIdentifiers
+{
+    return [self.collapsedNodeIdentifierSet allObjects];
+}
+
+- (TLIndexPathUpdates *)updatesBySettingCollapsedNodeIdentifiers:(NSArray *)collapsedNodeIdentifiers forNodeWithIdentifier:(id)identifier
+{
+    return [self updatesBySettingCollapsedNodeIdentifierSet:[NSSet setWithArray:collapsedNodeIdentifiers] forNodeWithIdentifier:identifier];
+}
+
+- (TLIndexPathUpdates *)updatesBySettingCollapsedNodeIdentifierSet:(NSSet *)collapsedNodeIdentifierSet forNodeWithIdentifier:(id)identifier
+{
+    NSIndexPath *indexPath = [self indexPathForIdentifier:identifier];
+    if (!indexPath) {
+        return nil;
+    }
+    TLIndexPathTreeItem *node = [self itemAtIndexPath:indexPath];
+    collapsedNodeIdentifierSet = [collapsedNodeIdentifierSet copy];
+    
+    // the node's visible descendants are contiguous and immediately follow the node
+    NSUInteger oldCount = [self countVisibleDescendantsOfTreeItem:node withCollapsedNodeIdentifiers:self.collapsedNodeIdentifierSet];
+    NSMutableArray *insertedItems = [NSMutableArray array];
+    if (![collapsedNodeIdentifierSet containsObject:node.identifier]) {
+        for (TLIndexPathTreeItem *childItem in node.childItems) {
+            [self flattenTreeItem:childItem intoArray:insertedItems withCollapsedNodeIdentifiers:collapsedNodeIdentifierSet];
+        }
+    }
+    NSRange range = NSMakeRange(indexPath.row + 1, oldCount);
+    
+    id<NSFetchedResultsSectionInfo> sectionInfo = self.sections[indexPath.section];
+    NSMutableArray *items = [NSMutableArray arrayWithArray:sectionInfo.objects];
+    NSArray *deletedItems = [items subarrayWithRange:range];
+    [items replaceObjectsInRange:range withObjectsFromArray:insertedItems];
+    
+    NSMutableArray *insertedIdentifiers = [NSMutableArray arrayWithCapacity:insertedItems.count];
+    for (id item in insertedItems) {
+        [insertedIdentifiers addObject:[self identifierForItem:item]];
+    }
+    NSMutableArray *identifiers = [NSMutableArray arrayWithArray:[self identifiersInSection:indexPath.section]];
+    [identifiers replaceObjectsInRange:range withObjectsFromArray:insertedIdentifiers];
+    
+    NSMutableArray *sections = [NSMutableArray arrayWithArray:self.sections];
+    sections[indexPath.section] = [[TLIndexPathSectionInfo alloc] initWithItems:items
+                                                                           name:sectionInfo.name
+                                                                     indexTitle:sectionInfo.indexTitle];
+    TLTreeDataModel *dataModel = [[TLTreeDataModel alloc] initWithDataModel:self
+                                                               sectionInfos:sections
+                                                   identifiersBySectionName:@{sectionInfo.name : identifiers}];
+    dataModel->_treeItems = self.treeItems;
+    dataModel->_treeItemSections = self.treeItemSections;
+    dataModel->_collapsedNodeIdentifierSet = collapsedNodeIdentifierSet;
+    
+    return [[TLIndexPathUpdates alloc] initWithOldDataModel:self
+                                           updatedDataModel:dataModel
+                                       insertedSectionNames:@[]
+                                              insertedItems:insertedItems
+                                               deletedItems:deletedItems
+                                                 movedItems:@[]
+                                              modifiedItems:@[]];
+}
+
+- (TLIndexPathUpdates *)updatesByReplacingTreeItem:(TLIndexPathTreeItem *)treeItem collapsedChildNodeIdentifiers:(NSArray *)collapsedChildNodeIdentifiers
+{
+    NSIndexPath *indexPath = [self indexPathForIdentifier:[self identifierForItem:treeItem]];
+    if (!indexPath) {
+        return nil;
+    }
+    NSInteger section = indexPath.section;
+    id<NSFetchedResultsSectionInfo> treeItemSection = self.treeItemSections[section];
+    
+    // find the path from the top level node to the node being replaced. All children
+    // of a visible, expanded node are visible and appear in order, so the child whose
+    // subtree contains the node's row is found by binary searching the children's rows.
+    NSMutableArray *path = [NSMutableArray array];
+    NSMutableArray *childIndexes = [NSMutableArray array];
+    NSMutableArray *rows = [NSMutableArray array];
+    NSArray *children = [treeItemSection objects];
+    while (YES) {
+        NSUInteger index = NSNotFound;
+        NSInteger childRow = NSNotFound;
+        NSUInteger low = 0;
+        NSUInteger high = children.count;
+        while (low < high) {
+            NSUInteger mid = low + (high - low) / 2;
+            NSIndexPath *childIndexPath = [self indexPathForIdentifier:[self identifierForItem:children[mid]]];
+            if (!childIndexPath || childIndexPath.section != section) {
+                return nil;
+            }
+            if (childIndexPath.row <= indexPath.row) {
+                index = mid;
+                childRow = childIndexPath.row;
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (index == NSNotFound) {
+            return nil;
+        }
+        TLIndexPathTreeItem *child = children[index];
+        [path addObject:child];
+        [childIndexes addObject:@(index)];
+        [rows addObject:@(childRow)];
+        if (childRow == indexPath.row) {
+            break;
+        }
+        children = child.childItems;
+    }
+    TLIndexPathTreeItem *oldTreeItem = [path lastObject];
+    
+    // copy the ancestors from the bottom up, sharing all other nodes
+    NSMutableArray *newPath = [path mutableCopy];
+    newPath[newPath.count - 1] = treeItem;
+    for (NSInteger level = (NSInteger)path.count - 2; level >= 0; level--) {
+        TLIndexPathTreeItem *ancestor = path[level];
+        NSMutableArray *childItems = [ancestor.childItems mutableCopy];
+        childItems[[childIndexes[level + 1] unsignedIntegerValue]] = newPath[level + 1];
+        newPath[level] = [ancestor copyWithChildren:childItems];
+    }
+    
+    NSUInteger topLevelIndex = [childIndexes[0] unsignedIntegerValue];
+    NSMutableArray *topLevelItems = [[treeItemSection objects] mutableCopy];
+    topLevelItems[topLevelIndex] = newPath[0];
+    NSMutableArray *treeItemSections = [self.treeItemSections mutableCopy];
+    treeItemSections[section] = [[TLIndexPathSectionInfo alloc] initWithItems:topLevelItems
+                                                                         name:treeItemSection.name
+                                                                   indexTitle:treeItemSection.indexTitle];
+    NSUInteger treeItemsIndex = topLevelIndex;
+    for (NSInteger otherSection = 0; otherSection < section; otherSection++) {
+        treeItemsIndex += [self.treeItemSections[otherSection] numberOfObjects];
+    }
+    NSMutableArray *treeItems = [self.treeItems mutableCopy];
+    treeItems[treeItemsIndex] = newPath[0];
+    
+    // drop collapsed identifiers of descendants that are no longer in the subtree
+    NSMutableSet *descendantIdentifiers = [NSMutableSet set];
+    [self addDescendantIdentifiersOfTreeItem:treeItem toSet:descendantIdentifiers];
+    NSMutableSet *collapsedNodeIdentifierSet = [self.collapsedNodeIdentifierSet mutableCopy];
+    NSMutableSet *oldDescendantIdentifiers = [NSMutableSet set];
+    [self addDescendantIdentifiersOfTreeItem:oldTreeItem toSet:oldDescendantIdentifiers];
+    [oldDescendantIdentifiers minusSet:descendantIdentifiers];
+    [collapsedNodeIdentifierSet minusSet:oldDescendantIdentifiers];
+    [collapsedNodeIdentifierSet addObjectsFromArray:collapsedChildNodeIdentifiers];
+    
+    // the node's visible descendants are contiguous and immediately follow the node
+    NSUInteger oldCount = [self countVisibleDescendantsOfTreeItem:oldTreeItem withCollapsedNodeIdentifiers:self.collapsedNodeIdentifierSet];
+    NSMutableArray *descendantItems = [NSMutableArray array];
+    if (![collapsedNodeIdentifierSet containsObject:[self identifierForItem:treeItem]]) {
+        for (TLIndexPathTreeItem *childItem in treeItem.childItems) {
+            [self flattenTreeItem:childItem intoArray:descendantItems withCollapsedNodeIdentifiers:collapsedNodeIdentifierSet];
+        }
+    }
+    NSRange range = NSMakeRange(indexPath.row + 1, oldCount);
+    
+    id<NSFetchedResultsSectionInfo> sectionInfo = self.sections[section];
+    NSMutableArray *items = [NSMutableArray arrayWithArray:sectionInfo.objects];
+    NSArray *oldDescendantItems = [items subarrayWithRange:range];
+    [items replaceObjectsInRange:range withObjectsFromArray:descendantItems];
+    for (NSUInteger level = 0; level < newPath.count; level++) {
+        items[[rows[level] unsignedIntegerValue]] = newPath[level];
+    }
+    
+    NSMutableArray *descendantItemIdentifiers = [NSMutableArray arrayWithCapacity:descendantItems.count];
+    for (id item in descendantItems) {
+        [descendantItemIdentifiers addObject:[self identifierForItem:item]];
+    }
+    NSMutableArray *identifiers = [NSMutableArray arrayWithArray:[self identifiersInSection:section]];
+    [identifiers replaceObjectsInRange:range withObjectsFromArray:descendantItemIdentifiers];
+    
+    NSMutableArray *sections = [NSMutableArray arrayWithArray:self.sections];
+    sections[section] = [[TLIndexPathSectionInfo alloc] initWithItems:items
+                                                                 name:sectionInfo.name
+                                                           indexTitle:sectionInfo.indexTitle];
+    TLTreeDataModel *dataModel = [[TLTreeDataModel alloc] initWithDataModel:self
+                                                               sectionInfos:sections
+                                                   identifiersBySectionName:@{sectionInfo.name : identifiers}];
+    dataModel->_treeItems = treeItems;
+    dataModel->_treeItemSections = treeItemSections;
+    dataModel->_collapsedNodeIdentifierSet = collapsedNodeIdentifierSet;
+    
+    // descendants that are visible in both versions are retained rather than
+    // deleted and inserted
+    NSMutableDictionary *oldDescendantItemsByIdentifier = [NSMutableDictionary dictionaryWithCapacity:oldDescendantItems.count];
+    for (id item in oldDescendantItems) {
+        [oldDescendantItemsByIdentifier setObject:item forKey:[self identifierForItem:item]];
+    }
+    NSMutableArray *insertedItems = [NSMutableArray array];
+    NSMutableArray *movedItems = [NSMutableArray array];
+    NSMutableArray *modifiedItems = [NSMutableArray array];
+    if (![oldTreeItem isEqual:treeItem]) {
+        [modifiedItems addObject:treeItem];
+    }
+    [descendantItems enumerateObjectsUsingBlock:^(id item, NSUInteger index, BOOL *stop) {
+        id identifier = descendantItemIdentifiers[index];
+        id oldItem = [oldDescendantItemsByIdentifier objectForKey:identifier];
+        if (oldItem) {
+            [oldDescendantItemsByIdentifier removeObjectForKey:identifier];
+            if ([self indexPathForIdentifier:identifier].row != range.location + index) {
+                [movedItems addObject:item];
+            }
+            if (![oldItem isEqual:item]) {
+                [modifiedItems addObject:item];
+            }
+        } else {
+            [insertedItems addObject:item];
+        }
+    }];
+    NSMutableArray *deletedItems = [NSMutableArray arrayWithCapacity:oldDescendantItemsByIdentifier.count];
+    for (id item in oldDescendantItems) {
+        if ([oldDescendantItemsByIdentifier objectForKey:[self identifierForItem:item]]) {
+            [deletedItems addObject:item];
+        }
+    }
+    
+    return [[TLIndexPathUpdates alloc] initWithOldDataModel:self
+                                           updatedDataModel:dataModel
+                                       insertedSectionNames:@[]
+                                              insertedItems:insertedItems
+                                               deletedItems:deletedItems
+                                                 movedItems:movedItems
+                                              modifiedItems:modifiedItems];
+}
+
+- (void)addDescendantIdentifiersOfTreeItem:(TLIndexPathTreeItem *)item toSet:(NSMutableSet *)identifiers
+{
+    for (TLIndexPathTreeItem *childItem in item.childItems) {
+        [identifiers addObject:[self identifierForItem:childItem]];
+        [self addDescendantIdentifiersOfTreeItem:childItem toSet:identifiers];
+    }
+}
+
+- (NSUInteger)countVisibleDescendantsOfTreeItem:(TLIndexPathTreeItem *)item withCollapsedNodeIdentifiers:(NSSet *)collapsedNodeIdentifiers
+{
+    if ([collapsedNodeIdentifiers containsObject:item.identifier]) {
+        return 0;
+    }
+    NSUInteger count = 0;
+    for (TLIndexPathTreeItem *childItem in item.childItems) {
+        count += 1 + [self countVisibleDescendantsOfTreeItem:childItem withCollapsedNodeIdentifiers:collapsedNodeIdentifiers];
+    }
+    return count;
+}
+
+- (void)flattenTreeItem:(TLIndexPathTreeItem *)item intoArray:(NSMutableArray *)items withCollapsedNodeIdentifiers:(NSSet *)collapsedNodeIdentifiers
+{
+    if (item) {
+        [items addObject:item];
+        if (![collapsedNodeIdentifiers containsObject:item.identifier]) {
+            for (TLIndexPathTreeItem *childItem in item.childItems) {
+                [self flattenTreeItem:childItem intoArray:items withCollapsedNodeIdentifiers:collapsedNodeIdentifiers];
+            }
+        }
+    }
+}
+
+@end
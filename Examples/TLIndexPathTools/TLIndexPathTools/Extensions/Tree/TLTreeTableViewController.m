@@ -23,7 +23,6 @@
 
 #import "TLTreeTableViewController.h"
 #import "UITableViewController+ScrollOptimizer.h"
-#import "TLIndexPathSectionInfo.h"
 #import "UITableView+ScrollOptimizer.h"
 
 @interface TLTreeTableViewController ()
@@ -50,34 +49,16 @@
 
 - (void)setNewVersionOfItem:(TLIndexPathTreeItem *)item collapsedChildNodeIdentifiers:(NSArray *)collapsedChildNodeIdentifiers optimizeScroll:(BOOL)optimizeScroll
 {
-    NSIndexPath *indexPath = [self.dataModel indexPathForIdentifier:item.identifier];
-    if (indexPath) {
-        
-        NSArray *treeItemSections = self.dataModel.treeItemSections;
-        NSMutableArray *newTreeItemSections = [NSMutableArray arrayWithCapacity:[treeItemSections count]];
-        for (int section = 0; section < [treeItemSections count]; section++) {
-            id<NSFetchedResultsSectionInfo> treeItemSection = treeItemSections[section];
-            if (indexPath.section == section) {
-                NSArray *newTreeItems = [self rebuildTreeItems:[treeItemSection objects] withNewVersionOfItem:item];
-                TLIndexPathSectionInfo *newTreeItemSection = [[TLIndexPathSectionInfo alloc] initWithItems:newTreeItems
-                                                                                                      name:treeItemSection.name
-                                                                                                indexTitle:treeItemSection.indexTitle];
-                [newTreeItemSections addObject:newTreeItemSection];
-            } else {
-                [newTreeItemSections addObject:treeItemSection];
-            }
-        }
-        
+    //only the item's ancestors are copied and the changes are reported by the
+    //data model, so this doesn't depend on the size of the tree
+    TLIndexPathUpdates *updates = [self.dataModel updatesByReplacingTreeItem:item collapsedChildNodeIdentifiers:collapsedChildNodeIdentifiers];
+    if (updates) {
+        NSIndexPath *indexPath = [self.dataModel indexPathForIdentifier:item.identifier];
         BOOL currentignoreDataModelChanges = self.indexPathController.ignoreDataModelChanges;
         if (self.changingNode) {
             self.indexPathController.ignoreDataModelChanges = YES;
         }
-        //TODO to make this more robust, we should remove any existing children from the
-        //current set of collapsed items. But what we've done here should work for
-        //the simple case of lazy loading children.
-        NSMutableArray *mergedCollapsed = [[NSMutableArray alloc] initWithArray:self.dataModel.collapsedNodeIdentifiers];
-        [mergedCollapsed addObjectsFromArray:collapsedChildNodeIdentifiers];
-        self.dataModel = [[TLTreeDataModel alloc] initWithTreeItemSections:newTreeItemSections collapsedNodeIdentifiers:mergedCollapsed];
+        [self.indexPathController setDataModelWithUpdates:updates];
         self.indexPathController.ignoreDataModelChanges = currentignoreDataModelChanges;
         if (optimizeScroll) {
             [self optimizeScrollForNodeAtIndexPath:indexPath];
@@ -85,28 +66,10 @@
     }
 }
 
-- (NSArray *)rebuildTreeItems:(NSArray *)treeItems withNewVersionOfItem:(TLIndexPathTreeItem *)newVersionOfItem
-{
-    if (!treeItems) {
-        return nil;
-    }
-    NSMutableArray *newTreeItems = [[NSMutableArray alloc] initWithCapacity:treeItems.count];
-    for (TLIndexPathTreeItem *item in treeItems) {
-        if ([newVersionOfItem.identifier isEqual:item.identifier]) {
-            [newTreeItems addObject:newVersionOfItem];
-        } else {
-            NSArray *newChildItems = [self rebuildTreeItems:item.childItems withNewVersionOfItem:newVersionOfItem];
-            TLIndexPathTreeItem *newItem = [item copyWithChildren:newChildItems];
-            [newTreeItems addObject:newItem];
-        }
-    }
-    return newTreeItems;
-}
-
 - (void)optimizeScrollForNodeAtIndexPath:(NSIndexPath *)indexPath
 {
     id identifier = [self.dataModel identifierAtIndexPath:indexPath];
-    if ([self.dataModel.collapsedNodeIdentifiers containsObject:identifier]) {
+    if ([self.dataModel.collapsedNodeIdentifierSet containsObject:identifier]) {
         return;
     }
     TLIndexPathTreeItem *item = (TLIndexPathTreeItem *)[self.dataModel itemAtIndexPath:indexPath];
@@ -130,7 +93,7 @@
     //perform the expand/collapse logic on non-leaf nodes
     if (item.childItems) {
         
-        NSMutableArray *collapsedNodeIdentifiers = [NSMutableArray arrayWithArray:self.dataModel.collapsedNodeIdentifiers];
+        NSMutableSet *collapsedNodeIdentifiers = [self.dataModel.collapsedNodeIdentifierSet mutableCopy];
         //`collapsed` represents the __new__ state
         BOOL collapsed = ![collapsedNodeIdentifiers containsObject:item.identifier];
 
@@ -148,7 +111,7 @@
         
         //reassign variables in case changes were made by the delegate
         item = [self.dataModel itemAtIndexPath:indexPath];
-        collapsedNodeIdentifiers = [NSMutableArray arrayWithArray:self.dataModel.collapsedNodeIdentifiers];
+        collapsedNodeIdentifiers = [self.dataModel.collapsedNodeIdentifierSet mutableCopy];
         collapsed = ![collapsedNodeIdentifiers containsObject:item.identifier];
         
         if (collapsed == NO) {
@@ -165,9 +128,16 @@
             [collapsedNodeIdentifiers addObject:item.identifier];
         }
         
-        NSArray *treeItemSections = self.dataModel.treeItemSections;
-        self.dataModel = [[TLTreeDataModel alloc] initWithTreeItemSections:treeItemSections
-                                                  collapsedNodeIdentifiers:collapsedNodeIdentifiers];
+        //splice the node's subtree rather than rebuilding the whole tree
+        TLIndexPathUpdates *updates = [self.dataModel updatesBySettingCollapsedNodeIdentifierSet:collapsedNodeIdentifiers
+                                                                           forNodeWithIdentifier:item.identifier];
+        if (updates) {
+            [self.indexPathController setDataModelWithUpdates:updates];
+        } else {
+            NSArray *treeItemSections = self.dataModel.treeItemSections;
+            self.dataModel = [[TLTreeDataModel alloc] initWithTreeItemSections:treeItemSections
+                                                      collapsedNodeIdentifiers:[collapsedNodeIdentifiers allObjects]];
+        }
         
         if ([self.delegate respondsToSelector:@selector(controller:didChangeNode:collapsed:)]) {
             [self.delegate controller:self didChangeNode:item collapsed:collapsed];
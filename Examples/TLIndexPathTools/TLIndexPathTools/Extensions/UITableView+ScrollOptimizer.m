@@ -30,22 +30,29 @@
 - (void)optimizeScrollPositionForIndexPaths:(NSArray *)indexPaths options:(TLTableViewScrollOptions)options topInset:(CGFloat)topInset animated:(BOOL)animated
 {
     [self layoutIfNeeded];
-    CGRect rect = CGRectNull;
-    NSInteger section = -1;
+    // Rows, headers and footers are stacked vertically in index path order, so the
+    // union of all of their rects is spanned by the first and last index paths and
+    // the header and footer of the first and last sections.
+    NSIndexPath *firstIndexPath;
+    NSIndexPath *lastIndexPath;
     for (NSIndexPath *indexPath in indexPaths) {
-        if (indexPath.section != section) {
-            section = indexPath.section;
-            if (options & TLTableViewScrollOptionsIncludeHeaderViews) {
-                CGRect headerFrame = [self rectForHeaderInSection:section];
-                rect = CGRectUnion(rect, headerFrame);
-            }
-            if (options & TLTableViewScrollOptionsIncludeFooterViews) {
-                CGRect footerFrame = [self rectForFooterInSection:section];
-                rect = CGRectUnion(rect, footerFrame);
-            }
+        if (!firstIndexPath || [indexPath compare:firstIndexPath] == NSOrderedAscending) {
+            firstIndexPath = indexPath;
+        }
+        if (!lastIndexPath || [indexPath compare:lastIndexPath] == NSOrderedDescending) {
+            lastIndexPath = indexPath;
+        }
+    }
+    CGRect rect = CGRectNull;
+    if (firstIndexPath) {
+        if (options & TLTableViewScrollOptionsIncludeHeaderViews) {
+            rect = CGRectUnion(rect, [self rectForHeaderInSection:firstIndexPath.section]);
+        }
+        if (options & TLTableViewScrollOptionsIncludeFooterViews) {
+            rect = CGRectUnion(rect, [self rectForFooterInSection:lastIndexPath.section]);
         }
-        CGRect indexPathFrame = [self rectForRowAtIndexPath:indexPath];
-        rect = CGRectUnion(rect, indexPathFrame);
+        rect = CGRectUnion(rect, [self rectForRowAtIndexPath:firstIndexPath]);
+        rect = CGRectUnion(rect, [self rectForRowAtIndexPath:lastIndexPath]);
     }
     CGFloat maxY = CGRectGetMaxY(rect);
     CGSize contentSize = self.contentSize;
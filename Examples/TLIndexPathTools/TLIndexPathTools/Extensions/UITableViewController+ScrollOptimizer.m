@@ -7,6 +7,8 @@
 //
 
 #import "UITableViewController+ScrollOptimizer.h"
+#import "TLTableViewController.h"
+#import "TLRowHeightIndex.h"
 
 @implementation UITableViewController (ScrollOptimizer)
 
@@ -40,22 +42,30 @@
             return;
         }
         
-        // Iterate over rows to find out how many can be made visible
-        id<NSFetchedResultsSectionInfo>sectionInfo = dataModel.sections[section];
-        for (id item in sectionInfo.objects) {
-            NSIndexPath *indexPath = [dataModel indexPathForItem:item];
-            offsetBelowTopToMakeVisible += [self tableView:self.tableView heightForRowAtIndexPath:indexPath];
-            spaceNotVisible = offsetBelowTopToMakeVisible - visibleSpaceBelowSectionTop;
-            // If we run out of space to display all rows, scroll the header to the top
-            if (spaceNotVisible > sectionTop) {
-                CGSize contentSize = self.tableView.contentSize;
-                contentSize.height = 1000;
-                self.tableView.contentSize = contentSize;
-                CGFloat locationToMakeVisible = headerView.frame.origin.y + visibleSpaceBelowSectionTop + sectionTop;
-                [self forceTableScrollBasedOnExpectedSize:locationToMakeVisible animated:animated];
-                return;
-            }
+        // Find out how many rows can be made visible. Use the row height index
+        // when available rather than summing the rows one at a time.
+        NSInteger numberOfRows = [dataModel numberOfRowsInSection:section];
+        TLRowHeightIndex *rowHeightIndex;
+        if ([self respondsToSelector:@selector(rowHeightIndexForSection:)]) {
+            rowHeightIndex = [(TLTableViewController *)self rowHeightIndexForSection:section];
         }
+        if (rowHeightIndex.count != numberOfRows) {
+            rowHeightIndex = [[TLRowHeightIndex alloc] initWithCount:numberOfRows heightBlock:^CGFloat(NSUInteger row) {
+                return [self tableView:self.tableView heightForRowAtIndexPath:[NSIndexPath indexPathForRow:row inSection:section]];
+            }];
+        }
+        NSUInteger numberOfRowsFitting = [rowHeightIndex numberOfRowsFittingHeight:sectionTop + visibleSpaceBelowSectionTop - offsetBelowTopToMakeVisible];
+        // If we run out of space to display all rows, scroll the header to the top
+        if (numberOfRowsFitting < numberOfRows) {
+            CGSize contentSize = self.tableView.contentSize;
+            contentSize.height = 1000;
+            self.tableView.contentSize = contentSize;
+            CGFloat locationToMakeVisible = headerView.frame.origin.y + visibleSpaceBelowSectionTop + sectionTop;
+            [self forceTableScrollBasedOnExpectedSize:locationToMakeVisible animated:animated];
+            return;
+        }
+        offsetBelowTopToMakeVisible += rowHeightIndex.totalHeight;
+        spaceNotVisible = offsetBelowTopToMakeVisible - visibleSpaceBelowSectionTop;
         
         // The entire section can be displayed, so scroll as much as needed
         if (spaceNotVisible > 0) {
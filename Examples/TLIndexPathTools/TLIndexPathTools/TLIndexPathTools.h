@@ -20,6 +20,7 @@ FOUNDATION_EXPORT const unsigned char TLIndexPathToolsVersionString[];
 #import "TLIndexPathItem.h"
 #import "TLIndexPathSectionInfo.h"
 #import "TLIndexPathUpdates.h"
+#import "TLIndexPathDataModelMutations.h"
 
 #pragma mark - Index path controller
 
@@ -37,6 +38,7 @@ FOUNDATION_EXPORT const unsigned char TLIndexPathToolsVersionString[];
 #import "TLDynamicHeightLabelCell.h"
 #import "UITableView+ScrollOptimizer.h"
 #import "UITableViewController+ScrollOptimizer.h"
+#import "TLRowHeightIndex.h"
 #import "TLIndexPathTreeItem.h"
 #import "TLTreeDataModel.h"
 #import "TLTreeTableViewController.h"
@@ -46,6 +46,15 @@
  */
 @property (strong, nonatomic) TLIndexPathController *indexPathController;
 
+/**
+ If `YES`, visible cells of modified items are updated in place by calling
+ `collectionView:configureCell:atIndexPath:` within the batch update rather than being
+ reloaded after it. Off-screen modified items are marked stale and reconfigured when
+ displayed. Cells whose identifier no longer matches the item are still reloaded.
+ Defaults to `YES`.
+ */
+@property (nonatomic) BOOL reconfiguresModifiedItems;
+
 /**
  The implementation of `collectionView:cellForItemAtIndexPath:` calls this method
  to ask for the cell's identifier before attempting to dequeue a cell. The default
@@ -69,6 +78,15 @@
 
 - (void)reconfigureVisibleCells;
 
+/**
+ Called during batch updates when `reconfiguresModifiedItems` is `YES` to update the
+ visible cell of a modified item in place. The default implementation calls
+ `collectionView:configureCell:atIndexPath:` and returns `YES`, unless the cell's reuse
+ identifier differs from `collectionView:cellIdentifierAtIndexPath:`, in which case it
+ returns `NO` and the item is reloaded instead.
+ */
+- (BOOL)collectionView:(UICollectionView *)collectionView reconfigureCell:(UICollectionViewCell *)cell atIndexPath:(NSIndexPath *)indexPath;
+
 #pragma mark - Backing cells with view controllers
 
 /**
@@ -89,6 +107,17 @@
  */
 - (UIViewController *)collectionView:(UICollectionView *)collectionView viewControllerForCell:(UICollectionViewCell *)cell;
 
+/**
+ Called in `cellForItemAtIndexPath` when a cell is about to be displayed with a backing view
+ controller that was previously used for another item. Backing controllers stay attached
+ to their cells and are reused along with them. When a cell is deallocated instead of
+ being reused, its controller is pooled by cell identifier and handed to the next new cell
+ with the same identifier rather than instantiating another one. The default
+ implementation installs a pooled controller's view into the cell's content view. Override
+ this to reset controller state, calling the super implementation.
+ */
+- (void)collectionView:(UICollectionView *)collectionView prepareViewController:(UIViewController *)controller forReuseInCell:(UICollectionViewCell *)cell atIndexPath:(NSIndexPath *)indexPath;
+
 /**
  If set to NO, the view controller will not establish a containment relationship
  with view controllers instantiated for cells. This option exists because cases have
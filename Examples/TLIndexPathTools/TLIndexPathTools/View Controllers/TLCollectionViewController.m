@@ -0,0 +1,362 @@
+//
+//  TLCollectionViewController.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "TLCollectionViewController.h"
+#import <objc/runtime.h>
+#import "TLIndexPathItem.h"
+
+@interface TLCollectionViewController ()
+@property (strong, nonatomic) NSMutableDictionary *reusableViewControllersByCellIdentifier;
+@property (weak, nonatomic) NSIndexPath *currentCellForItemAtIndexPath;
+// identifiers of modified items whose cells may have been configured, but not displayed,
+// before the modification, such as prefetched cells
+@property (strong, nonatomic) NSMutableSet *staleItemIdentifiers;
+- (void)enqueueReusableViewController:(UIViewController *)controller cellIdentifier:(NSString *)cellIdentifier;
+@end
+
+static char kTLCollectionViewCellBackingKey;
+
+static const NSUInteger TLMaximumReusableViewControllersPerCellIdentifier = 8;
+
+/*
+ Attaches a backing view controller to its cell as an associated object. If the cell is
+ deallocated rather than reused, the controller is returned to the owner's reuse pool
+ asynchronously on the main queue.
+ */
+@interface TLCollectionViewCellBacking : NSObject
+@property (strong, nonatomic) UIViewController *viewController;
+@property (copy, nonatomic) NSString *cellIdentifier;
+@property (weak, nonatomic) TLCollectionViewController *owner;
+// `NO` if the controller must be prepared for reuse before the cell is displayed again
+@property (nonatomic) BOOL inUse;
+@end
+
+@implementation TLCollectionViewCellBacking
+
+- (void)dealloc
+{
+    //the cell may be deallocated in the middle of an update or off the main queue,
+    //so the controller is returned to the pool on the next main queue turn
+    __weak TLCollectionViewController *owner = _owner;
+    UIViewController *viewController = _viewController;
+    NSString *cellIdentifier = _cellIdentifier;
+    if (!owner || !viewController) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [owner enqueueReusableViewController:viewController cellIdentifier:cellIdentifier];
+    });
+}
+
+@end
+
+@implementation TLCollectionViewController
+
+#pragma mark - Initialization
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if (self = [super initWithCoder:aDecoder]) {
+        [self initialize];
+    }
+    return self;
+}
+
+- (id)initWithNibName:(NSString *)nibNameOrNil bundle:(NSBundle *)nibBundleOrNil
+{
+    if (self = [super initWithNibName:nibNameOrNil bundle:nibBundleOrNil]) {
+        [self initialize];
+    }
+    return self;
+}
+
+- (id)initWithCollectionViewLayout:(UICollectionViewLayout *)layout
+{
+    if (self = [super initWithCollectionViewLayout:layout]) {
+        [self initialize];
+    }
+    return self;
+}
+
+- (void)initialize
+{
+    _indexPathController = [[TLIndexPathController alloc] init];
+    _indexPathController.delegate = self;
+    _establishContainmentRelationshipWithViewControllerForCell = YES;
+    _reconfiguresModifiedItems = YES;
+}
+
+#pragma mark - Index path controller
+
+- (void)setIndexPathController:(TLIndexPathController *)indexPathController
+{
+    if (_indexPathController != indexPathController) {
+        _indexPathController = indexPathController;
+        _indexPathController.delegate = self;
+        [self.staleItemIdentifiers removeAllObjects];
+        [self.collectionView reloadData];
+    }
+}
+
+#pragma mark - Configuration
+
+- (void)collectionView:(UICollectionView *)collectionView configureCell:(UICollectionViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+}
+
+- (void)reconfigureVisibleCells
+{
+    for (UICollectionViewCell *cell in [self.collectionView visibleCells]) {
+        NSIndexPath *indexPath = [self.collectionView indexPathForCell:cell];
+        [self collectionView:self.collectionView configureCell:cell atIndexPath:indexPath];
+    }
+}
+
+- (BOOL)collectionView:(UICollectionView *)collectionView reconfigureCell:(UICollectionViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    NSString *identifier = [self collectionView:collectionView cellIdentifierAtIndexPath:indexPath];
+    if (cell.reuseIdentifier && ![cell.reuseIdentifier isEqualToString:identifier]) {
+        return NO;
+    }
+    [self collectionView:collectionView configureCell:cell atIndexPath:indexPath];
+    return YES;
+}
+
+- (NSString *)collectionView:(UICollectionView *)collectionView cellIdentifierAtIndexPath:(NSIndexPath *)indexPath
+{
+    id item = [self.indexPathController.dataModel itemAtIndexPath:indexPath];
+    NSString *cellId;
+    if ([item isKindOfClass:[TLIndexPathItem class]]) {
+        TLIndexPathItem *i = item;
+        cellId = i.cellIdentifier;
+    }
+    if (cellId.length == 0) {
+        cellId = @"Cell";
+    }
+    return cellId;
+}
+
+#pragma mark - Backing cells with view controllers
+
+- (UIViewController *)collectionView:(UICollectionView *)collectionView viewControllerForCell:(UICollectionViewCell *)cell
+{
+    TLCollectionViewCellBacking *backing = objc_getAssociatedObject(cell, &kTLCollectionViewCellBackingKey);
+    if (backing.viewController) {
+        return backing.viewController;
+    }
+
+    UIViewController *controller = [self dequeueReusableViewControllerWithCellIdentifier:cell.reuseIdentifier];
+    BOOL reused = controller != nil;
+    if (!controller) {
+        NSIndexPath *indexPath = self.currentCellForItemAtIndexPath;
+        if (indexPath == nil) {
+            indexPath = [self.collectionView indexPathForCell:cell];
+        }
+        controller = [self collectionView:collectionView instantiateViewControllerForCell:cell atIndexPath:indexPath];
+    }
+    if (controller) {
+        backing = [[TLCollectionViewCellBacking alloc] init];
+        backing.viewController = controller;
+        backing.cellIdentifier = cell.reuseIdentifier;
+        backing.owner = self;
+        //freshly instantiated controllers don't need to be prepared for reuse
+        backing.inUse = !reused;
+        objc_setAssociatedObject(cell, &kTLCollectionViewCellBackingKey, backing, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return controller;
+}
+
+- (UIViewController *)collectionView:(UICollectionView *)collectionView instantiateViewControllerForCell:(UICollectionViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    return nil;
+}
+
+- (void)collectionView:(UICollectionView *)collectionView prepareViewController:(UIViewController *)controller forReuseInCell:(UICollectionViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    //a pooled controller's view was removed from the deallocated cell
+    if (controller.view.superview == nil) {
+        controller.view.frame = cell.contentView.bounds;
+        controller.view.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        [cell.contentView addSubview:controller.view];
+    }
+}
+
+- (UIViewController *)collectionView:(UICollectionView *)collectionView existingViewControllerForCell:(UICollectionViewCell *)cell
+{
+    TLCollectionViewCellBacking *backing = objc_getAssociatedObject(cell, &kTLCollectionViewCellBackingKey);
+    return backing.viewController;
+}
+
+- (void)collectionView:(UICollectionView *)collectionView prepareViewControllerForDisplayInCell:(UICollectionViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    TLCollectionViewCellBacking *backing = objc_getAssociatedObject(cell, &kTLCollectionViewCellBackingKey);
+    if (backing.viewController && !backing.inUse) {
+        backing.inUse = YES;
+        [self collectionView:collectionView prepareViewController:backing.viewController forReuseInCell:cell atIndexPath:indexPath];
+    }
+}
+
+- (UIViewController *)dequeueReusableViewControllerWithCellIdentifier:(NSString *)cellIdentifier
+{
+    if (!cellIdentifier) {
+        return nil;
+    }
+    NSMutableArray *controllers = self.reusableViewControllersByCellIdentifier[cellIdentifier];
+    UIViewController *controller = [controllers lastObject];
+    if (controller) {
+        [controllers removeLastObject];
+    }
+    return controller;
+}
+
+- (void)enqueueReusableViewController:(UIViewController *)controller cellIdentifier:(NSString *)cellIdentifier
+{
+    [controller.view removeFromSuperview];
+    [controller removeFromParentViewController];
+    if (!controller || !cellIdentifier) {
+        return;
+    }
+    if (!self.reusableViewControllersByCellIdentifier) {
+        self.reusableViewControllersByCellIdentifier = [[NSMutableDictionary alloc] init];
+    }
+    NSMutableArray *controllers = self.reusableViewControllersByCellIdentifier[cellIdentifier];
+    if (!controllers) {
+        controllers = [[NSMutableArray alloc] init];
+        self.reusableViewControllersByCellIdentifier[cellIdentifier] = controllers;
+    }
+    if (controllers.count < TLMaximumReusableViewControllersPerCellIdentifier) {
+        [controllers addObject:controller];
+    }
+}
+
+#pragma mark - UICollectionViewDataSource
+
+- (NSInteger)numberOfSectionsInCollectionView:(UICollectionView *)collectionView
+{
+    return self.indexPathController.dataModel.numberOfSections;
+}
+
+- (NSInteger)collectionView:(UICollectionView *)collectionView numberOfItemsInSection:(NSInteger)section
+{
+    return [self.indexPathController.dataModel numberOfRowsInSection:section];
+}
+
+- (UICollectionViewCell *)collectionView:(UICollectionView *)collectionView cellForItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    self.currentCellForItemAtIndexPath = indexPath;
+    NSString *identifier = [self collectionView:collectionView cellIdentifierAtIndexPath:indexPath];
+    UICollectionViewCell *cell = [collectionView dequeueReusableCellWithReuseIdentifier:identifier forIndexPath:indexPath];
+    if (!cell) {
+        cell = [[UICollectionViewCell alloc] init];
+    }
+    UIViewController *controller = [self collectionView:collectionView viewControllerForCell:cell];
+    [self collectionView:collectionView prepareViewControllerForDisplayInCell:cell atIndexPath:indexPath];
+    if (controller && self.establishContainmentRelationshipWithViewControllerForCell) {
+        [self addChildViewController:controller];
+    }
+    [self collectionView:collectionView configureCell:cell atIndexPath:indexPath];
+    id itemIdentifier = self.staleItemIdentifiers.count ? [self.indexPathController.dataModel identifierAtIndexPath:indexPath] : nil;
+    if (itemIdentifier) {
+        [self.staleItemIdentifiers removeObject:itemIdentifier];
+    }
+    self.currentCellForItemAtIndexPath = nil;
+    return cell;
+}
+
+/**
+ The default implementation supports single header and footer views for flow layouts.
+ Override this as needed.
+ */
+- (UICollectionReusableView *)collectionView:(UICollectionView *)collectionView viewForSupplementaryElementOfKind:(NSString *)kind atIndexPath:(NSIndexPath *)indexPath
+{
+    NSString *identifier;
+    //TODO Support multiple possible header and footer views
+    if ([UICollectionElementKindSectionHeader isEqualToString:kind]) {
+        identifier = @"Header";
+    } else if ([UICollectionElementKindSectionFooter isEqualToString:kind]) {
+        identifier = @"Footer";
+    }
+    UICollectionReusableView *view = [collectionView dequeueReusableSupplementaryViewOfKind:kind withReuseIdentifier:identifier forIndexPath:indexPath];
+    return view;
+}
+
+#pragma mark - UICollectionViewDelegate
+
+- (void)collectionView:(UICollectionView *)collectionView willDisplayCell:(UICollectionViewCell *)cell forItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (self.staleItemIdentifiers.count) {
+        id identifier = [self.indexPathController.dataModel identifierAtIndexPath:indexPath];
+        if (identifier && [self.staleItemIdentifiers containsObject:identifier]) {
+            [self.staleItemIdentifiers removeObject:identifier];
+            [self collectionView:collectionView configureCell:cell atIndexPath:indexPath];
+        }
+    }
+}
+
+- (void)collectionView:(UICollectionView *)collectionView didEndDisplayingCell:(UICollectionViewCell *)cell forItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    // Check for existing view controller instead of calling `viewControllerForCell` because sometimes this
+    // method can be called for a cell that is going away and there's no need to instantiate a controller.
+    TLCollectionViewCellBacking *backing = objc_getAssociatedObject(cell, &kTLCollectionViewCellBackingKey);
+    backing.inUse = NO;
+    [backing.viewController removeFromParentViewController];
+}
+
+#pragma mark - TLIndexPathControllerDelegate
+
+- (void)controller:(TLIndexPathController *)controller didUpdateDataModel:(TLIndexPathUpdates *)updates
+{
+    if (!updates.hasChanges) { return; }
+    //only perform batch udpates if view is visible
+    if (self.isViewLoaded && self.view.window) {
+        if (self.reconfiguresModifiedItems && updates.modifiedItems.count) {
+            if (!self.staleItemIdentifiers) {
+                self.staleItemIdentifiers = [[NSMutableSet alloc] init];
+            }
+            for (id item in updates.modifiedItems) {
+                id identifier = [updates.updatedDataModel identifierForItem:item];
+                if (identifier) {
+                    [self.staleItemIdentifiers addObject:identifier];
+                }
+            }
+            __weak TLCollectionViewController *weakSelf = self;
+            updates.reconfigureCellBlock = ^BOOL(id cell, NSIndexPath *indexPath) {
+                TLCollectionViewController *strongSelf = weakSelf;
+                if (![strongSelf collectionView:strongSelf.collectionView reconfigureCell:cell atIndexPath:indexPath]) {
+                    return NO;
+                }
+                id identifier = [strongSelf.indexPathController.dataModel identifierAtIndexPath:indexPath];
+                if (identifier) {
+                    [strongSelf.staleItemIdentifiers removeObject:identifier];
+                }
+                return YES;
+            };
+        }
+        [updates performBatchUpdatesOnCollectionView:self.collectionView];
+    } else {
+        [self.staleItemIdentifiers removeAllObjects];
+        [self.collectionView reloadData];
+    }
+}
+
+@end
@@ -39,6 +39,22 @@
 
 #import <Foundation/Foundation.h>
 
+/**
+ Computes view sizes from data alone, without touching any view. Objects returned by
+ `[TLDynamicSizeView sizeCalculator]` implement this protocol.
+ */
+@protocol TLDynamicSizeCalculator <NSObject>
+/**
+ Returns the size of the view for the given data. This method is called on a
+ background queue, so it must be thread-safe, for example by only measuring text
+ with `NSString` or `NSAttributedString` APIs.
+ 
+ @param data  data that affects the view's size
+ @return the computed size of the view
+ */
+- (CGSize) sizeWithData:(id)data;
+@end
+
 @protocol TLDynamicSizeView <NSObject>
 @optional
 /**
@@ -49,4 +65,13 @@
  @return the computed size of the view
  */
 - (CGSize) sizeWithData:(id)data;
+
+/**
+ Returns an object that computes the same sizes as `sizeWithData:` and is safe to
+ use on a background queue. It must not be a view or refer to one, so it shouldn't
+ be the receiver itself. When row height caching is enabled, `TLTableViewController`
+ uses it to precompute the heights of inserted and modified rows on a background
+ queue. The default is nil, in which case heights are only computed on demand.
+ */
+- (id<TLDynamicSizeCalculator>) sizeCalculator;
 @end
@@ -24,6 +24,7 @@
 #import <UIKit/UIKit.h>
 
 #import "TLIndexPathController.h"
+#import "TLRowHeightIndex.h"
 
 /**
  A subclass of `UITableViewController` that works with `TLIndexPathController`
@@ -54,6 +55,14 @@
  */
 @property (nonatomic) UITableViewRowAnimation rowAnimationStyle;
 
+/**
+ If `YES`, visible cells of modified items are updated in place by calling
+ `tableView:configureCell:atIndexPath:` within the batch update rather than being
+ reloaded after it. Cells whose identifier no longer matches the item are still
+ reloaded. Defaults to `YES`.
+ */
+@property (nonatomic) BOOL reconfiguresModifiedItems;
+
 /**
  The implementation of `tableView:cellForRowAtIndexPath:` calls this method
  to ask for the cell's identifier before attempting to dequeue a cell. The default
@@ -77,6 +86,53 @@
 
 - (void)reconfigureVisibleCells;
 
+/**
+ Called during batch updates when `reconfiguresModifiedItems` is `YES` to update the
+ visible cell of a modified item in place. The default implementation calls
+ `tableView:configureCell:atIndexPath:` and returns `YES`, unless the cell's reuse
+ identifier differs from `tableView:cellIdentifierAtIndexPath:`, in which case it returns
+ `NO` and the row is reloaded instead.
+ */
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath;
+
+#pragma mark - Row heights
+
+/**
+ Set this property to YES to cache the row heights calculated in
+ `tableView:heightForRowAtIndexPath:`. Heights are keyed by item identifier and
+ the item's `hash`, which serves as a content version, so items that are replaced
+ with unequal versions are measured again. Cached heights for the modified and
+ deleted items of every `TLIndexPathUpdates` are discarded, and the whole cache
+ is discarded when the table view's width changes.
+ 
+ If a dynamic height cell implements `sizeCalculator`, the heights of the inserted
+ and modified rows of every `TLIndexPathUpdates` that use that cell are precomputed
+ with the calculator on a background queue.
+ 
+ Defaults to NO.
+ */
+@property (nonatomic) BOOL cachesRowHeights;
+
+/**
+ Discards all cached row heights. Call this when something other than the items
+ affects row heights, such as a change in the preferred content size category.
+ */
+- (void)invalidateRowHeights;
+
+/**
+ Discards the cached row height of the given item.
+ */
+- (void)invalidateRowHeightForItem:(id)item;
+
+/**
+ Returns a prefix-sum index of the row heights in the given section, built from
+ `tableView:heightForRowAtIndexPath:` on first use. The index is kept in sync with
+ the data model: modified items have their heights updated in place and sections
+ whose rows are inserted, deleted or moved are rebuilt on next use. Scroll position
+ calculations use it to avoid summing row heights one at a time.
+ */
+- (TLRowHeightIndex *)rowHeightIndexForSection:(NSInteger)section;
+
 #pragma mark - Prototype cells
 
 /**
@@ -107,5 +163,16 @@
  */
 - (UIViewController *)tableView:(UITableView *)tableView viewControllerForCell:(UITableViewCell *)cell;
 
+/**
+ Called in `cellForRowAtIndexPath` when a cell is about to be displayed with a backing view
+ controller that was previously used for another item. Backing controllers stay attached
+ to their cells and are reused along with them. When a cell is deallocated instead of
+ being reused, its controller is pooled by cell identifier and handed to the next new cell
+ with the same identifier rather than instantiating another one. The default
+ implementation installs a pooled controller's view into the cell's content view. Override
+ this to reset controller state, calling the super implementation.
+ */
+- (void)tableView:(UITableView *)tableView prepareViewController:(UIViewController *)controller forReuseInCell:(UITableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath;
+
 
 @end
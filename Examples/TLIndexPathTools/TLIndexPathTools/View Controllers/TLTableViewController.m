@@ -0,0 +1,632 @@
+
+//  TLTableViewController.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#import "TLTableViewController.h"
+#import <objc/runtime.h>
+#import "TLIndexPathItem.h"
+#import "TLDynamicSizeView.h"
+#import "TLDynamicHeightCell.h"
+
+@interface TLTableViewController ()
+@property (strong, nonatomic) NSMutableDictionary *prototypeCells;
+@property (strong, nonatomic) NSMutableDictionary *reusableViewControllersByCellIdentifier;
+@property (weak, nonatomic) NSIndexPath *currentCellForRowAtIndexPath;
+@property (strong, nonatomic) NSMutableDictionary *rowHeightsByIdentifier;
+@property (strong, nonatomic) NSMutableDictionary *rowHeightVersionsByIdentifier;
+@property (nonatomic) CGFloat rowHeightCacheWidth;
+@property (nonatomic) NSUInteger rowHeightCacheGeneration;
+@property (strong, nonatomic) dispatch_queue_t rowHeightQueue;
+@property (strong, nonatomic) NSMutableDictionary *rowHeightIndexesBySectionName;
+@property (nonatomic) CGFloat rowHeightIndexWidth;
+- (void)enqueueReusableViewController:(UIViewController *)controller cellIdentifier:(NSString *)cellIdentifier;
+@end
+
+static char kTLTableViewCellBackingKey;
+
+static const NSUInteger TLMaximumReusableViewControllersPerCellIdentifier = 8;
+
+/*
+ Attaches a backing view controller to its cell as an associated object. If the cell is
+ deallocated rather than reused, the controller is returned to the owner's reuse pool
+ asynchronously on the main queue.
+ */
+@interface TLTableViewCellBacking : NSObject
+@property (strong, nonatomic) UIViewController *viewController;
+@property (copy, nonatomic) NSString *cellIdentifier;
+@property (weak, nonatomic) TLTableViewController *owner;
+// `NO` if the controller must be prepared for reuse before the cell is displayed again
+@property (nonatomic) BOOL inUse;
+@end
+
+@implementation TLTableViewCellBacking
+
+- (void)dealloc
+{
+    //the cell may be deallocated in the middle of an update or off the main queue,
+    //so the controller is returned to the pool on the next main queue turn
+    __weak TLTableViewController *owner = _owner;
+    UIViewController *viewController = _viewController;
+    NSString *cellIdentifier = _cellIdentifier;
+    if (!owner || !viewController) {
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [owner enqueueReusableViewController:viewController cellIdentifier:cellIdentifier];
+    });
+}
+
+@end
+
+@implementation TLTableViewController
+
+#pragma mark - Initialization
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if (self = [super initWithCoder:aDecoder]) {
+        [self initialize];
+    }
+    // Temporary workaround for "Unknown class TLDynamicHeightCell in Interface Builder file."
+    // error. Still trying to figure that one out, but any reference to this class in code resolves it.
+    [TLDynamicHeightCell class];
+    return self;
+}
+
+- (id)initWithNibName:(NSString *)nibNameOrNil bundle:(NSBundle *)nibBundleOrNil
+{
+    if (self = [super initWithNibName:nibNameOrNil bundle:nibBundleOrNil]) {
+        [self initialize];
+    }
+    return self;
+}
+
+- (id)initWithStyle:(UITableViewStyle)style
+{
+    if (self = [super initWithStyle:style]) {
+        [self initialize];
+    }
+    return self;
+}
+
+- (void)viewDidLoad
+{
+    [super viewDidLoad];
+}
+
+- (void)initialize
+{
+    _indexPathController = [[TLIndexPathController alloc] init];
+    _indexPathController.delegate = self;
+    _rowAnimationStyle = UITableViewRowAnimationFade;
+    _reconfiguresModifiedItems = YES;
+//    [TLDynamicHeightCell class];
+}
+
+#pragma mark - Index path controller
+
+- (void)setIndexPathController:(TLIndexPathController *)indexPathController
+{
+    if (_indexPathController != indexPathController) {
+        _indexPathController = indexPathController;
+        _indexPathController.delegate = self;
+        [self.tableView reloadData];
+    }
+}
+
+#pragma mark - Configuration
+
+- (NSString *)tableView:(UITableView *)tableView cellIdentifierAtIndexPath:(NSIndexPath *)indexPath
+{
+    id item = [self.indexPathController.dataModel itemAtIndexPath:indexPath];
+    NSString *cellId;
+    if ([item isKindOfClass:[TLIndexPathItem class]]) {
+        TLIndexPathItem *i = item;
+        cellId = i.cellIdentifier;
+    }
+    if (cellId.length == 0) {
+        cellId = @"Cell";
+    }
+    return cellId;
+
+}
+
+- (void)tableView:(UITableView *)tableView configureCell:(UITableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+}
+
+- (void)reconfigureVisibleCells
+{
+    for (UITableViewCell *cell in [self.tableView visibleCells]) {
+        NSIndexPath *indexPath = [self.tableView indexPathForCell:cell];
+        [self tableView:self.tableView configureCell:cell atIndexPath:indexPath];
+    }
+}
+
+- (BOOL)tableView:(UITableView *)tableView reconfigureCell:(UITableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    NSString *cellId = [self tableView:tableView cellIdentifierAtIndexPath:indexPath];
+    if (cell.reuseIdentifier && ![cell.reuseIdentifier isEqualToString:cellId]) {
+        return NO;
+    }
+    [self tableView:tableView configureCell:cell atIndexPath:indexPath];
+    return YES;
+}
+
+#pragma mark - Row heights
+
+- (void)invalidateRowHeights
+{
+    [self.rowHeightIndexesBySectionName removeAllObjects];
+    [self.rowHeightsByIdentifier removeAllObjects];
+    [self.rowHeightVersionsByIdentifier removeAllObjects];
+    // discard any background results computed for the old cache
+    self.rowHeightCacheGeneration++;
+}
+
+- (void)invalidateRowHeightForItem:(id)item
+{
+    TLIndexPathDataModel *dataModel = self.indexPathController.dataModel;
+    NSIndexPath *indexPath = [dataModel indexPathForItem:item];
+    if (indexPath) {
+        [self.rowHeightIndexesBySectionName removeObjectForKey:[dataModel sectionNameForSection:indexPath.section]];
+    }
+    [self removeCachedRowHeightForItem:item];
+}
+
+- (void)removeCachedRowHeightForItem:(id)item
+{
+    id identifier = [self.indexPathController.dataModel identifierForItem:item];
+    if (identifier) {
+        [self.rowHeightsByIdentifier removeObjectForKey:identifier];
+        [self.rowHeightVersionsByIdentifier removeObjectForKey:identifier];
+    }
+}
+
+- (NSNumber *)cachedRowHeightForIdentifier:(id)identifier item:(id)item tableView:(UITableView *)tableView
+{
+    if (tableView.bounds.size.width != self.rowHeightCacheWidth) {
+        [self invalidateRowHeights];
+        self.rowHeightCacheWidth = tableView.bounds.size.width;
+        return nil;
+    }
+    NSNumber *version = [self.rowHeightVersionsByIdentifier objectForKey:identifier];
+    if (version && [version unsignedIntegerValue] == [item hash]) {
+        return [self.rowHeightsByIdentifier objectForKey:identifier];
+    }
+    return nil;
+}
+
+- (void)cacheRowHeight:(CGFloat)height forIdentifier:(id)identifier version:(NSUInteger)version
+{
+    if (!self.rowHeightsByIdentifier) {
+        self.rowHeightsByIdentifier = [[NSMutableDictionary alloc] init];
+        self.rowHeightVersionsByIdentifier = [[NSMutableDictionary alloc] init];
+    }
+    [self.rowHeightsByIdentifier setObject:@(height) forKey:identifier];
+    [self.rowHeightVersionsByIdentifier setObject:@(version) forKey:identifier];
+}
+
+- (TLRowHeightIndex *)rowHeightIndexForSection:(NSInteger)section
+{
+    TLIndexPathDataModel *dataModel = self.indexPathController.dataModel;
+    NSString *sectionName = [dataModel sectionNameForSection:section];
+    if (!sectionName) {
+        return nil;
+    }
+    if (self.tableView.bounds.size.width != self.rowHeightIndexWidth) {
+        [self.rowHeightIndexesBySectionName removeAllObjects];
+        self.rowHeightIndexWidth = self.tableView.bounds.size.width;
+    }
+    TLRowHeightIndex *index = [self.rowHeightIndexesBySectionName objectForKey:sectionName];
+    if (!index) {
+        if (!self.rowHeightIndexesBySectionName) {
+            self.rowHeightIndexesBySectionName = [[NSMutableDictionary alloc] init];
+        }
+        __weak TLTableViewController *weakSelf = self;
+        index = [[TLRowHeightIndex alloc] initWithCount:[dataModel numberOfRowsInSection:section] heightBlock:^CGFloat(NSUInteger row) {
+            return [weakSelf indexedHeightForRowAtIndexPath:[NSIndexPath indexPathForRow:row inSection:section]];
+        }];
+        [self.rowHeightIndexesBySectionName setObject:index forKey:sectionName];
+    }
+    return index;
+}
+
+- (CGFloat)indexedHeightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    CGFloat height = [self tableView:self.tableView heightForRowAtIndexPath:indexPath];
+    if (height < 0) {
+        // `UITableViewAutomaticDimension`
+        height = self.tableView.estimatedRowHeight > 0 ? self.tableView.estimatedRowHeight : self.tableView.rowHeight;
+    }
+    return height;
+}
+
+/*
+ Keeps the row height indexes in sync with the data model. Sections with structural
+ changes are rebuilt on next use and modified rows are updated in place.
+ */
+- (void)updateRowHeightIndexesWithUpdates:(TLIndexPathUpdates *)updates
+{
+    if (!self.rowHeightIndexesBySectionName.count) {
+        return;
+    }
+    if (updates.insertedSectionNames.count || updates.deletedSectionNames.count || updates.movedSectionNames.count) {
+        [self.rowHeightIndexesBySectionName removeAllObjects];
+        return;
+    }
+    TLIndexPathDataModel *oldDataModel = updates.oldDataModel;
+    TLIndexPathDataModel *updatedDataModel = updates.updatedDataModel;
+    for (id item in updates.insertedItems) {
+        NSIndexPath *indexPath = [updatedDataModel indexPathForItem:item];
+        [self.rowHeightIndexesBySectionName removeObjectForKey:[updatedDataModel sectionNameForSection:indexPath.section]];
+    }
+    for (id item in updates.deletedItems) {
+        NSIndexPath *indexPath = [oldDataModel indexPathForItem:item];
+        [self.rowHeightIndexesBySectionName removeObjectForKey:[oldDataModel sectionNameForSection:indexPath.section]];
+    }
+    for (id item in updates.movedItems) {
+        NSIndexPath *oldIndexPath = [oldDataModel indexPathForItem:item];
+        NSIndexPath *updatedIndexPath = [updatedDataModel indexPathForItem:item];
+        [self.rowHeightIndexesBySectionName removeObjectForKey:[oldDataModel sectionNameForSection:oldIndexPath.section]];
+        [self.rowHeightIndexesBySectionName removeObjectForKey:[updatedDataModel sectionNameForSection:updatedIndexPath.section]];
+    }
+    for (id item in updates.modifiedItems) {
+        NSIndexPath *indexPath = [updatedDataModel indexPathForItem:item];
+        TLRowHeightIndex *index = [self.rowHeightIndexesBySectionName objectForKey:[updatedDataModel sectionNameForSection:indexPath.section]];
+        [index setHeight:[self indexedHeightForRowAtIndexPath:indexPath] forRow:indexPath.row];
+    }
+}
+
+/*
+ Measures the uncached inserted and modified rows whose prototype cell provides a
+ size calculator on a background queue. Calculators and data are gathered on the main
+ queue and the results are discarded if the cache is invalidated before they're
+ delivered.
+ */
+- (void)precomputeRowHeightsForUpdates:(TLIndexPathUpdates *)updates
+{
+    if (!self.isViewLoaded) {
+        return;
+    }
+    TLIndexPathDataModel *dataModel = updates.updatedDataModel;
+    NSMutableArray *items = [NSMutableArray arrayWithArray:updates.insertedItems];
+    [items addObjectsFromArray:updates.modifiedItems];
+    for (NSString *sectionName in updates.insertedSectionNames) {
+        NSInteger section = [dataModel sectionForSectionName:sectionName];
+        if (section != NSNotFound) {
+            [items addObjectsFromArray:[dataModel sectionInfoForSection:section].objects];
+        }
+    }
+    NSMutableArray *calculators = [[NSMutableArray alloc] init];
+    NSMutableArray *identifiers = [[NSMutableArray alloc] init];
+    NSMutableArray *versions = [[NSMutableArray alloc] init];
+    NSMutableArray *data = [[NSMutableArray alloc] init];
+    for (id item in items) {
+        NSIndexPath *indexPath = [dataModel indexPathForItem:item];
+        id identifier = [dataModel identifierForItem:item];
+        if (!indexPath || !identifier || [self cachedRowHeightForIdentifier:identifier item:item tableView:self.tableView]) {
+            continue;
+        }
+        NSString *cellId = [self tableView:self.tableView cellIdentifierAtIndexPath:indexPath];
+        UITableViewCell *cell = cellId ? [self tableView:self.tableView prototypeForCellIdentifier:cellId] : nil;
+        if (![cell conformsToProtocol:@protocol(TLDynamicSizeView)]
+            || ![cell respondsToSelector:@selector(sizeCalculator)]) {
+            continue;
+        }
+        id<TLDynamicSizeCalculator> calculator = [(id<TLDynamicSizeView>)cell sizeCalculator];
+        if (!calculator) {
+            continue;
+        }
+        [calculators addObject:calculator];
+        [identifiers addObject:identifier];
+        [versions addObject:@([item hash])];
+        [data addObject:[self sizeDataForItem:item] ?: [NSNull null]];
+    }
+    if (identifiers.count == 0) {
+        return;
+    }
+    if (!self.rowHeightQueue) {
+        self.rowHeightQueue = dispatch_queue_create("com.tractablelabs.TLTableViewController.rowHeights", DISPATCH_QUEUE_SERIAL);
+    }
+    NSUInteger generation = self.rowHeightCacheGeneration;
+    __weak TLTableViewController *weakSelf = self;
+    dispatch_async(self.rowHeightQueue, ^{
+        NSMutableArray *heights = [[NSMutableArray alloc] initWithCapacity:identifiers.count];
+        for (NSUInteger i = 0; i < identifiers.count; i++) {
+            id d = data[i] == [NSNull null] ? nil : data[i];
+            [heights addObject:@([calculators[i] sizeWithData:d].height)];
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            TLTableViewController *strongSelf = weakSelf;
+            if (!strongSelf || strongSelf.rowHeightCacheGeneration != generation) {
+                return;
+            }
+            for (NSUInteger i = 0; i < identifiers.count; i++) {
+                [strongSelf cacheRowHeight:[heights[i] doubleValue] forIdentifier:identifiers[i] version:[versions[i] unsignedIntegerValue]];
+            }
+        });
+    });
+}
+
+- (id)sizeDataForItem:(id)item
+{
+    if ([item isKindOfClass:[TLIndexPathItem class]]) {
+        return ((TLIndexPathItem *)item).data;
+    }
+    return item;
+}
+
+#pragma mark - Prototype cells
+
+- (UITableViewCell *)tableView:(UITableView *)tableView prototypeForCellIdentifier:(NSString *)cellIdentifier
+{
+    UITableViewCell *cell;
+    if (cellIdentifier) {
+        cell = [self.prototypeCells objectForKey:cellIdentifier];
+        if (!cell) {
+            if (!self.prototypeCells) {
+                self.prototypeCells = [[NSMutableDictionary alloc] init];
+            }
+            cell = [tableView dequeueReusableCellWithIdentifier:cellIdentifier];
+            //this will cause a view controller to be configured for the prototype cell
+            //if there's supposed to be one
+            [self tableView:tableView viewControllerForCell:cell];
+            //TODO this will fail if multiple tables are being used and they have
+            //overlapping identifiers. The key needs to be unique to the table
+            [self.prototypeCells setObject:cell forKey:cellIdentifier];
+        }
+    }
+    return cell;
+
+}
+
+#pragma mark - Backing cells with view controllers
+
+- (UIViewController *)tableView:(UITableView *)tableView viewControllerForCell:(UITableViewCell *)cell
+{
+    TLTableViewCellBacking *backing = objc_getAssociatedObject(cell, &kTLTableViewCellBackingKey);
+    if (backing.viewController) {
+        return backing.viewController;
+    }
+
+    UIViewController *controller = [self dequeueReusableViewControllerWithCellIdentifier:cell.reuseIdentifier];
+    BOOL reused = controller != nil;
+    if (!controller) {
+        NSIndexPath *indexPath = self.currentCellForRowAtIndexPath;
+        if (indexPath == nil) {
+            indexPath = [self.tableView indexPathForCell:cell];
+        }
+        controller = [self tableView:tableView instantiateViewControllerForCell:cell atIndexPath:indexPath];
+    }
+    if (controller) {
+        backing = [[TLTableViewCellBacking alloc] init];
+        backing.viewController = controller;
+        backing.cellIdentifier = cell.reuseIdentifier;
+        backing.owner = self;
+        //freshly instantiated controllers don't need to be prepared for reuse
+        backing.inUse = !reused;
+        objc_setAssociatedObject(cell, &kTLTableViewCellBackingKey, backing, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return controller;
+}
+
+- (UIViewController *)tableView:(UITableView *)tableView instantiateViewControllerForCell:(UITableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    return nil;
+}
+
+- (void)tableView:(UITableView *)tableView prepareViewController:(UIViewController *)controller forReuseInCell:(UITableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    //a pooled controller's view was removed from the deallocated cell
+    if (controller.view.superview == nil) {
+        controller.view.frame = cell.contentView.bounds;
+        controller.view.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        [cell.contentView addSubview:controller.view];
+    }
+}
+
+- (void)tableView:(UITableView *)tableView prepareViewControllerForDisplayInCell:(UITableViewCell *)cell atIndexPath:(NSIndexPath *)indexPath
+{
+    TLTableViewCellBacking *backing = objc_getAssociatedObject(cell, &kTLTableViewCellBackingKey);
+    if (backing.viewController && !backing.inUse) {
+        backing.inUse = YES;
+        [self tableView:tableView prepareViewController:backing.viewController forReuseInCell:cell atIndexPath:indexPath];
+    }
+}
+
+- (UIViewController *)dequeueReusableViewControllerWithCellIdentifier:(NSString *)cellIdentifier
+{
+    if (!cellIdentifier) {
+        return nil;
+    }
+    NSMutableArray *controllers = self.reusableViewControllersByCellIdentifier[cellIdentifier];
+    UIViewController *controller = [controllers lastObject];
+    if (controller) {
+        [controllers removeLastObject];
+    }
+    return controller;
+}
+
+- (void)enqueueReusableViewController:(UIViewController *)controller cellIdentifier:(NSString *)cellIdentifier
+{
+    [controller.view removeFromSuperview];
+    [controller removeFromParentViewController];
+    if (!controller || !cellIdentifier) {
+        return;
+    }
+    if (!self.reusableViewControllersByCellIdentifier) {
+        self.reusableViewControllersByCellIdentifier = [[NSMutableDictionary alloc] init];
+    }
+    NSMutableArray *controllers = self.reusableViewControllersByCellIdentifier[cellIdentifier];
+    if (!controllers) {
+        controllers = [[NSMutableArray alloc] init];
+        self.reusableViewControllersByCellIdentifier[cellIdentifier] = controllers;
+    }
+    if (controllers.count < TLMaximumReusableViewControllersPerCellIdentifier) {
+        [controllers addObject:controller];
+    }
+}
+
+#pragma mark - UITableViewDataSource
+
+- (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView
+{
+    return self.indexPathController.dataModel.numberOfSections;
+}
+
+- (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section
+{
+    return [self.indexPathController.dataModel numberOfRowsInSection:section];
+}
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    self.currentCellForRowAtIndexPath = indexPath;
+    NSString *cellId = [self tableView:tableView cellIdentifierAtIndexPath:indexPath];
+    UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:cellId];
+    if (!cell) {
+        cell = [[UITableViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:cellId];
+    }
+    UIViewController *controller = [self tableView:tableView viewControllerForCell:cell];
+    [self tableView:tableView prepareViewControllerForDisplayInCell:cell atIndexPath:indexPath];
+    if (controller) {
+        [self addChildViewController:controller];
+    }
+    [self tableView:tableView configureCell:cell atIndexPath:indexPath];
+    self.currentCellForRowAtIndexPath = nil;
+    return cell;
+}
+
+#pragma mark - UITableViewDelegate
+
+- (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    [self tableView:tableView configureCell:cell atIndexPath:indexPath];
+}
+
+- (NSString *)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section
+{
+    return [self.indexPathController.dataModel sectionTitleForSection:section];
+}
+
+/**
+ Automatically calculate cell height by retrieving a prototype and either a)
+ returning the existing height or b) if the cell implements the `TLDynamicHeightView`
+ protocol, returning the value of sizeWithData:. For (b), the data passed to the
+ cell will be the item returned by the data model or, if the item is an instance
+ of `TLIndexPathItem`, the value of the item's `data` property.
+ */
+- (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (!self.cachesRowHeights) {
+        return [self tableView:tableView calculateHeightForRowAtIndexPath:indexPath];
+    }
+    TLIndexPathDataModel *dataModel = self.indexPathController.dataModel;
+    id identifier = [dataModel identifierAtIndexPath:indexPath];
+    id item = [dataModel itemAtIndexPath:indexPath];
+    if (!identifier) {
+        return [self tableView:tableView calculateHeightForRowAtIndexPath:indexPath];
+    }
+    NSNumber *cachedHeight = [self cachedRowHeightForIdentifier:identifier item:item tableView:tableView];
+    if (cachedHeight) {
+        return [cachedHeight doubleValue];
+    }
+    CGFloat height = [self tableView:tableView calculateHeightForRowAtIndexPath:indexPath];
+    [self cacheRowHeight:height forIdentifier:identifier version:[item hash]];
+    return height;
+}
+
+- (CGFloat)tableView:(UITableView *)tableView calculateHeightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    id item = [self.indexPathController.dataModel itemAtIndexPath:indexPath];
+    NSString *cellId = [self tableView:tableView cellIdentifierAtIndexPath:indexPath];
+    if (cellId) {
+        UITableViewCell *cell = [self tableView:tableView prototypeForCellIdentifier:cellId];
+        if ([cell conformsToProtocol:@protocol(TLDynamicSizeView)]) {
+            id<TLDynamicSizeView> v = (id<TLDynamicSizeView>)cell;
+            if ([v respondsToSelector:@selector(sizeWithData:)]) {
+                // cell knows how to calculate its size
+                CGSize computedSize = [v sizeWithData:[self sizeDataForItem:item]];
+                return computedSize.height;
+            } else {
+                id tmp = self.currentCellForRowAtIndexPath;
+                self.currentCellForRowAtIndexPath = indexPath;
+                // automatically calculate size
+                [self tableView:tableView configureCell:cell atIndexPath:indexPath];
+                CGSize systemSize = [cell.contentView systemLayoutSizeFittingSize:UILayoutFittingCompressedSize];
+                self.currentCellForRowAtIndexPath = tmp;
+                CGFloat separatorHeight = tableView.separatorStyle == UITableViewCellSeparatorStyleNone ? 0 : 1 / [UIScreen mainScreen].scale;
+                return systemSize.height + separatorHeight;
+            }
+        } else if (CGRectIsEmpty(cell.bounds)) {
+            // Fix for adaptive storyboards. New adaptive storyboards (created in iOS8 or later),
+            // which dequeue cells with empty bounds. If we see empty bounds, then fall back
+            // (or perhaps forward) to self-sizing cells
+            return UITableViewAutomaticDimension;
+        } else {
+            return cell.bounds.size.height;
+        }
+    }
+    
+    return 44.0;
+}
+
+- (void)tableView:(UITableView *)tableView didEndDisplayingCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    TLTableViewCellBacking *backing = objc_getAssociatedObject(cell, &kTLTableViewCellBackingKey);
+    backing.inUse = NO;
+    [backing.viewController removeFromParentViewController];
+}
+
+#pragma mark - TLIndexPathControllerDelegate
+
+- (void)controller:(TLIndexPathController *)controller didUpdateDataModel:(TLIndexPathUpdates *)updates
+{
+    if (!updates.hasChanges) { return; }
+    if (self.cachesRowHeights) {
+        for (id item in updates.modifiedItems) {
+            [self removeCachedRowHeightForItem:item];
+        }
+        for (id item in updates.deletedItems) {
+            [self removeCachedRowHeightForItem:item];
+        }
+        [self precomputeRowHeightsForUpdates:updates];
+    }
+    [self updateRowHeightIndexesWithUpdates:updates];
+    //only perform batch udpates if view is visible
+    if (self.isViewLoaded && self.view.window) {
+        if (self.reconfiguresModifiedItems) {
+            //off-screen cells don't need to be marked stale because
+            //`tableView:willDisplayCell:forRowAtIndexPath:` always reconfigures
+            __weak TLTableViewController *weakSelf = self;
+            updates.reconfigureCellBlock = ^BOOL(id cell, NSIndexPath *indexPath) {
+                return [weakSelf tableView:weakSelf.tableView reconfigureCell:cell atIndexPath:indexPath];
+            };
+        }
+        [updates performBatchUpdatesOnTableView:self.tableView withRowAnimation:self.rowAnimationStyle];
+    } else {
+        [self.tableView reloadData];
+    }
+}
+
+@end
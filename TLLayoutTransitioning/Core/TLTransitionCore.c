@@ -0,0 +1,522 @@
+//
+//  TLTransitionCore.c
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#include "TLTransitionCore.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+// Geometry
+
+const TLCoreRect TLCoreRectNull = {{INFINITY, INFINITY}, {0, 0}};
+
+bool TLCoreRectIsNull(TLCoreRect rect)
+{
+    return rect.origin.x == INFINITY || rect.origin.y == INFINITY;
+}
+
+static TLCoreRect TLCoreRectStandardize(TLCoreRect rect)
+{
+    if (rect.size.width < 0) {
+        rect.origin.x += rect.size.width;
+        rect.size.width = -rect.size.width;
+    }
+    if (rect.size.height < 0) {
+        rect.origin.y += rect.size.height;
+        rect.size.height = -rect.size.height;
+    }
+    return rect;
+}
+
+double TLCoreRectGetMinX(TLCoreRect rect)
+{
+    return TLCoreRectStandardize(rect).origin.x;
+}
+
+double TLCoreRectGetMidX(TLCoreRect rect)
+{
+    rect = TLCoreRectStandardize(rect);
+    return rect.origin.x + rect.size.width / 2;
+}
+
+double TLCoreRectGetMaxX(TLCoreRect rect)
+{
+    rect = TLCoreRectStandardize(rect);
+    return rect.origin.x + rect.size.width;
+}
+
+double TLCoreRectGetMinY(TLCoreRect rect)
+{
+    return TLCoreRectStandardize(rect).origin.y;
+}
+
+double TLCoreRectGetMidY(TLCoreRect rect)
+{
+    rect = TLCoreRectStandardize(rect);
+    return rect.origin.y + rect.size.height / 2;
+}
+
+double TLCoreRectGetMaxY(TLCoreRect rect)
+{
+    rect = TLCoreRectStandardize(rect);
+    return rect.origin.y + rect.size.height;
+}
+
+TLCoreRect TLCoreRectUnion(TLCoreRect rect, TLCoreRect otherRect)
+{
+    if (TLCoreRectIsNull(rect)) {
+        return TLCoreRectStandardize(otherRect);
+    }
+    if (TLCoreRectIsNull(otherRect)) {
+        return TLCoreRectStandardize(rect);
+    }
+    double minX = fmin(TLCoreRectGetMinX(rect), TLCoreRectGetMinX(otherRect));
+    double minY = fmin(TLCoreRectGetMinY(rect), TLCoreRectGetMinY(otherRect));
+    double maxX = fmax(TLCoreRectGetMaxX(rect), TLCoreRectGetMaxX(otherRect));
+    double maxY = fmax(TLCoreRectGetMaxY(rect), TLCoreRectGetMaxY(otherRect));
+    TLCoreRect unionRect = {{minX, minY}, {maxX - minX, maxY - minY}};
+    return unionRect;
+}
+
+TLCoreRect TLCoreRectInset(TLCoreRect rect, TLCoreInsets insets)
+{
+    rect.origin.x += insets.left;
+    rect.origin.y += insets.top;
+    rect.size.width -= insets.left + insets.right;
+    rect.size.height -= insets.top + insets.bottom;
+    return rect;
+}
+
+// Interpolation
+
+double TLCoreInterpolateFloat(double fromFloat, double toFloat, double progress)
+{
+    double t = progress;
+    double f = 1 - t;
+    return t * toFloat + f * fromFloat;
+}
+
+TLCorePoint TLCoreInterpolatePoint(TLCorePoint fromPoint, TLCorePoint toPoint, double progress)
+{
+    TLCorePoint point;
+    point.x = TLCoreInterpolateFloat(fromPoint.x, toPoint.x, progress);
+    point.y = TLCoreInterpolateFloat(fromPoint.y, toPoint.y, progress);
+    return point;
+}
+
+TLCoreSize TLCoreInterpolateSize(TLCoreSize fromSize, TLCoreSize toSize, double progress)
+{
+    TLCoreSize size;
+    size.width = TLCoreInterpolateFloat(fromSize.width, toSize.width, progress);
+    size.height = TLCoreInterpolateFloat(fromSize.height, toSize.height, progress);
+    return size;
+}
+
+TLCoreRect TLCoreInterpolateRect(TLCoreRect fromRect, TLCoreRect toRect, double progress)
+{
+    TLCoreRect rect;
+    rect.origin = TLCoreInterpolatePoint(fromRect.origin, toRect.origin, progress);
+    rect.size = TLCoreInterpolateSize(fromRect.size, toRect.size, progress);
+    return rect;
+}
+
+TLCoreInsets TLCoreInterpolateInsets(TLCoreInsets fromInsets, TLCoreInsets toInsets, double progress)
+{
+    TLCoreInsets insets;
+    insets.top = TLCoreInterpolateFloat(fromInsets.top, toInsets.top, progress);
+    insets.left = TLCoreInterpolateFloat(fromInsets.left, toInsets.left, progress);
+    insets.bottom = TLCoreInterpolateFloat(fromInsets.bottom, toInsets.bottom, progress);
+    insets.right = TLCoreInterpolateFloat(fromInsets.right, toInsets.right, progress);
+    return insets;
+}
+
+void TLCoreInterpolatePose(TLCorePose *pose, const TLCorePose *fromPose, const TLCorePose *toPose, double progress)
+{
+    // every field of a pose is a double, so interpolate the poses as flat arrays
+    // rather than field by field
+    enum { count = sizeof(TLCorePose) / sizeof(double) };
+    const double *from = (const double *)fromPose;
+    const double *to = (const double *)toPose;
+    double *result = (double *)pose;
+    double t = progress;
+    double f = 1 - t;
+    for (int i = 0; i < count; i++) {
+        result[i] = t * to[i] + f * from[i];
+    }
+}
+
+// Progress and time
+
+double TLCoreProgress(double initialValue, double currentValue, double finalValue)
+{
+    double p = (currentValue - initialValue) / (finalValue - initialValue);
+    p = fmin(1.0, p);
+    p = fmax(0, p);
+    return p;
+}
+
+double TLCoreIncrementalProgress(double previousProgress, double progress)
+{
+    int reverse = previousProgress > progress;
+    double remaining = reverse ? previousProgress : 1 - previousProgress;
+    return remaining == 0 ? progress : fabs(progress - previousProgress) / remaining;
+}
+
+double TLCoreConvertTimespace(double time, double startTime, double endTime)
+{
+    // sanitize input
+    time = fmax(0, fmin(1, time));
+    startTime = fmax(0, fmin(1, startTime));
+    endTime = fmax(0, fmin(1, endTime));
+    if (endTime <= startTime) {
+        return 1;
+    }
+    if (time <= startTime) {
+        return 0;
+    }
+    if (time >= endTime) {
+        return 1;
+    }
+    // calculate time in the converted timespace
+    return (time - startTime) / (endTime - startTime);
+}
+
+// Placement
+
+TLCorePoint TLCoreContentOffsetForPlacement(const TLCorePlacementContext *context)
+{
+    TLCoreRect fromFrame = context->fromFrame;
+    TLCoreRect toFrame = context->toFrame;
+    bool defaultPlacementAnchor = context->defaultPlacementAnchor;
+    TLCorePoint placementAnchor = context->placementAnchor;
+
+    TLCoreRect placementFrame = TLCoreRectInset((TLCoreRect){{0, 0}, context->toSize}, context->placementInset);
+
+    // location of the point we're adjusting for, in the coordinate system
+    // of the content
+    TLCorePoint sourcePoint;
+
+    // location where we want the source point to end up, in the coordinate
+    // system of the collection view
+    TLCorePoint destinationPoint;
+
+    if (defaultPlacementAnchor) {
+        sourcePoint = (TLCorePoint){TLCoreRectGetMidX(toFrame), TLCoreRectGetMidY(toFrame)};
+    } else {
+        sourcePoint = TLCorePointForAnchorPoint(placementAnchor, toFrame);
+    }
+
+    switch (context->placement) {
+        case TLCorePlacementMinimal:
+            if (defaultPlacementAnchor) {
+                destinationPoint = (TLCorePoint){TLCoreRectGetMidX(fromFrame), TLCoreRectGetMidY(fromFrame)};
+            } else {
+                destinationPoint = TLCorePointForAnchorPoint(placementAnchor, fromFrame);
+            }
+            destinationPoint.x -= context->contentOffset.x;
+            destinationPoint.y -= context->contentOffset.y;
+            break;
+        case TLCorePlacementVisible:
+        {
+            // calculate the minimal toContentOffset and the resulting
+            // frame in collection view space
+            TLCorePlacementContext minimalContext = *context;
+            minimalContext.placement = TLCorePlacementMinimal;
+            TLCorePoint minimalToContentOffset = TLCoreContentOffsetForPlacement(&minimalContext);
+            TLCoreRect translatedToFrameUnion = toFrame;
+            translatedToFrameUnion.origin.x -= minimalToContentOffset.x;
+            translatedToFrameUnion.origin.y -= minimalToContentOffset.y;
+            // now calculate the minimal offset that maximizes this frame's visibility
+            TLCorePoint maximalIntersectionOffset =
+                    TLCoreMinimalOffsetForMaximalIntersection(placementFrame, translatedToFrameUnion);
+            minimalToContentOffset.x -= maximalIntersectionOffset.x;
+            minimalToContentOffset.y -= maximalIntersectionOffset.y;
+            return minimalToContentOffset;
+        }
+        case TLCorePlacementCenter:
+            destinationPoint = (TLCorePoint){TLCoreRectGetMidX(placementFrame), TLCoreRectGetMidY(placementFrame)};
+            break;
+        case TLCorePlacementTop:
+            if (defaultPlacementAnchor) {
+                sourcePoint = (TLCorePoint){TLCoreRectGetMidX(toFrame), TLCoreRectGetMinY(toFrame)};
+            }
+            destinationPoint = (TLCorePoint){TLCoreRectGetMidX(placementFrame), TLCoreRectGetMinY(placementFrame)};
+            break;
+        case TLCorePlacementLeft:
+            if (defaultPlacementAnchor) {
+                sourcePoint = (TLCorePoint){TLCoreRectGetMinX(toFrame), TLCoreRectGetMidY(toFrame)};
+            }
+            destinationPoint = (TLCorePoint){TLCoreRectGetMinX(placementFrame), TLCoreRectGetMidY(placementFrame)};
+            break;
+        case TLCorePlacementBottom:
+            if (defaultPlacementAnchor) {
+                sourcePoint = (TLCorePoint){TLCoreRectGetMidX(toFrame), TLCoreRectGetMaxY(toFrame)};
+            }
+            destinationPoint = (TLCorePoint){TLCoreRectGetMidX(placementFrame), TLCoreRectGetMaxY(placementFrame)};
+            break;
+        case TLCorePlacementRight:
+            if (defaultPlacementAnchor) {
+                sourcePoint = (TLCorePoint){TLCoreRectGetMaxX(toFrame), TLCoreRectGetMidY(toFrame)};
+            }
+            destinationPoint = (TLCorePoint){TLCoreRectGetMaxX(placementFrame), TLCoreRectGetMidY(placementFrame)};
+            break;
+        default:
+            destinationPoint = (TLCorePoint){0, 0};
+            break;
+    }
+
+    TLCoreSize contentSize = context->toContentSize;
+    TLCoreInsets toContentInset = context->toContentInset;
+
+    TLCorePoint offset = {sourcePoint.x - destinationPoint.x, sourcePoint.y - destinationPoint.y};
+
+    double minOffsetX = -toContentInset.left;
+    double minOffsetY = -toContentInset.top;
+
+    double maxOffsetX = toContentInset.right + contentSize.width - placementFrame.size.width;
+    double maxOffsetY = toContentInset.bottom + contentSize.height - placementFrame.size.height;
+    maxOffsetX = fmax(minOffsetX, maxOffsetX);
+    maxOffsetY = fmax(minOffsetY, maxOffsetY);
+
+    offset.x = fmax(minOffsetX, offset.x);
+    offset.y = fmax(minOffsetY, offset.y);
+
+    offset.x = fmin(maxOffsetX, offset.x);
+    offset.y = fmin(maxOffsetY, offset.y);
+
+    return offset;
+}
+
+TLCorePoint TLCoreRelativePointInRect(TLCorePoint point, TLCoreRect rect)
+{
+    TLCorePoint relativePoint = {point.x - rect.origin.x, point.y - rect.origin.y};
+    double width = TLCoreRectStandardize(rect).size.width;
+    double height = TLCoreRectStandardize(rect).size.height;
+    relativePoint.x = width == 0 ? 0 : relativePoint.x / width;
+    relativePoint.y = height == 0 ? 0 : relativePoint.y / height;
+    return relativePoint;
+}
+
+TLCorePoint TLCorePointForAnchorPoint(TLCorePoint anchorPoint, TLCoreRect frame)
+{
+    TLCorePoint point;
+    point.x = (1 - anchorPoint.x) * TLCoreRectGetMinX(frame) + anchorPoint.x * TLCoreRectGetMaxX(frame);
+    point.y = (1 - anchorPoint.y) * TLCoreRectGetMinY(frame) + anchorPoint.y * TLCoreRectGetMaxY(frame);
+    return point;
+}
+
+TLCorePoint TLCoreMinimalOffsetForMaximalIntersection(TLCoreRect parentFrame, TLCoreRect childFrame)
+{
+    double topSpace = TLCoreRectGetMinY(childFrame) - TLCoreRectGetMinY(parentFrame);
+    double leftSpace = TLCoreRectGetMinX(childFrame) - TLCoreRectGetMinX(parentFrame);
+    double bottomSpace = TLCoreRectGetMaxY(parentFrame) - TLCoreRectGetMaxY(childFrame);
+    double rightSpace = TLCoreRectGetMaxX(parentFrame) - TLCoreRectGetMaxX(childFrame);
+    return (TLCorePoint){TLCoreLinearOffset(leftSpace, rightSpace), TLCoreLinearOffset(topSpace, bottomSpace)};
+}
+
+double TLCoreLinearOffset(double spaceBeforeChild, double spaceAfterChild)
+{
+    // if both before and after space have the same sign, then there is no offset.
+    // If they're both negative, an offset will not improve anything. If they are
+    // both positive, no offset is needed.
+    if (spaceBeforeChild * spaceAfterChild >= 0) {
+        return 0;
+    }
+    if (spaceBeforeChild < 0) {
+        return fmin(spaceAfterChild, -spaceBeforeChild);
+    } else {
+        return fmax(spaceAfterChild, -spaceBeforeChild);
+    }
+}
+
+// Batch updates
+
+typedef struct {
+    TLCoreIndexPath before;
+    TLCoreIndexPath after;
+} TLCoreRemapSource;
+
+static int TLCoreCompareIndexPaths(TLCoreIndexPath indexPath, TLCoreIndexPath otherIndexPath)
+{
+    if (indexPath.section != otherIndexPath.section) {
+        return indexPath.section < otherIndexPath.section ? -1 : 1;
+    }
+    if (indexPath.item != otherIndexPath.item) {
+        return indexPath.item < otherIndexPath.item ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ Orders index paths and remap sources, whose first member is an index path.
+ */
+static int TLCoreCompareLeadingIndexPaths(const void *element, const void *otherElement)
+{
+    return TLCoreCompareIndexPaths(*(const TLCoreIndexPath *)element, *(const TLCoreIndexPath *)otherElement);
+}
+
+/*
+ Advances `*cursor` past the elements of a sorted array that precede `indexPath`
+ and returns the matching element, or NULL. `indexPath` must not decrease between
+ calls sharing a cursor, so a pass over the array is linear overall.
+ */
+static const void *TLCoreSortedFind(const void *elements, size_t count, size_t size, size_t *cursor, TLCoreIndexPath indexPath)
+{
+    const char *bytes = elements;
+    int order = -1;
+    while (*cursor < count
+            && (order = TLCoreCompareIndexPaths(*(const TLCoreIndexPath *)(bytes + *cursor * size), indexPath)) < 0) {
+        (*cursor)++;
+    }
+    return *cursor < count && order == 0 ? bytes + *cursor * size : NULL;
+}
+
+static size_t TLCoreLowerBound(const TLCoreIndexPath *indexPaths, size_t count, TLCoreIndexPath indexPath)
+{
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (TLCoreCompareIndexPaths(indexPaths[mid], indexPath) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool TLCoreRemapIndexPaths(const long *oldItemCounts, long oldNumberOfSections,
+                           const TLCoreUpdate *updates, size_t updateCount,
+                           long *newSections, TLCoreIndexPath *newIndexPaths)
+{
+    const TLCoreIndexPath notFound = {TLCoreNotFound, TLCoreNotFound};
+    size_t capacity = updateCount ? updateCount : 1;
+    // deletes and move sources are relative to the old index paths, inserts and
+    // move destinations to the new ones
+    TLCoreRemapSource *sectionSources = malloc(capacity * sizeof(TLCoreRemapSource));
+    TLCoreRemapSource *itemSources = malloc(capacity * sizeof(TLCoreRemapSource));
+    TLCoreIndexPath *occupiedSections = malloc(capacity * sizeof(TLCoreIndexPath));
+    TLCoreIndexPath *occupiedItems = malloc(capacity * sizeof(TLCoreIndexPath));
+    if (!sectionSources || !itemSources || !occupiedSections || !occupiedItems) {
+        free(sectionSources);
+        free(itemSources);
+        free(occupiedSections);
+        free(occupiedItems);
+        return false;
+    }
+    size_t sectionSourceCount = 0;
+    size_t itemSourceCount = 0;
+    size_t occupiedSectionCount = 0;
+    size_t occupiedItemCount = 0;
+    for (size_t i = 0; i < updateCount; i++) {
+        const TLCoreUpdate *update = &updates[i];
+        TLCoreIndexPath before = update->before;
+        TLCoreIndexPath after = update->after;
+        bool sectionUpdate = (update->action == TLCoreUpdateActionInsert ? after : before).item == TLCoreNotFound;
+        if (sectionUpdate) {
+            // sections are keyed as the index path of their first item
+            before.item = 0;
+            after.item = 0;
+        }
+        switch (update->action) {
+            case TLCoreUpdateActionDelete:
+                if (sectionUpdate) {
+                    sectionSources[sectionSourceCount++] = (TLCoreRemapSource){before, notFound};
+                } else {
+                    itemSources[itemSourceCount++] = (TLCoreRemapSource){before, notFound};
+                }
+                break;
+            case TLCoreUpdateActionInsert:
+                if (sectionUpdate) {
+                    occupiedSections[occupiedSectionCount++] = after;
+                } else {
+                    occupiedItems[occupiedItemCount++] = after;
+                }
+                break;
+            case TLCoreUpdateActionMove:
+                if (sectionUpdate) {
+                    sectionSources[sectionSourceCount++] = (TLCoreRemapSource){before, after};
+                    occupiedSections[occupiedSectionCount++] = after;
+                } else {
+                    itemSources[itemSourceCount++] = (TLCoreRemapSource){before, after};
+                    occupiedItems[occupiedItemCount++] = after;
+                }
+                break;
+        }
+    }
+    qsort(sectionSources, sectionSourceCount, sizeof(TLCoreRemapSource), TLCoreCompareLeadingIndexPaths);
+    qsort(itemSources, itemSourceCount, sizeof(TLCoreRemapSource), TLCoreCompareLeadingIndexPaths);
+    qsort(occupiedSections, occupiedSectionCount, sizeof(TLCoreIndexPath), TLCoreCompareLeadingIndexPaths);
+    qsort(occupiedItems, occupiedItemCount, sizeof(TLCoreIndexPath), TLCoreCompareLeadingIndexPaths);
+
+    // old sections and items are visited in order, so each sorted array is walked once
+    size_t sectionSourceCursor = 0;
+    size_t itemSourceCursor = 0;
+    size_t occupiedSectionCursor = 0;
+    size_t element = 0;
+    long nextSection = 0;
+    for (long section = 0; section < oldNumberOfSections; section++) {
+        const TLCoreRemapSource *sectionSource = TLCoreSortedFind(sectionSources, sectionSourceCount, sizeof(TLCoreRemapSource),
+                                                                  &sectionSourceCursor, (TLCoreIndexPath){section, 0});
+        long newSection;
+        if (sectionSource) {
+            newSection = sectionSource->after.section;
+        } else {
+            while (TLCoreSortedFind(occupiedSections, occupiedSectionCount, sizeof(TLCoreIndexPath),
+                                    &occupiedSectionCursor, (TLCoreIndexPath){nextSection, 0})) {
+                nextSection++;
+            }
+            newSection = nextSection++;
+        }
+        newSections[section] = newSection;
+
+        size_t occupiedItemCursor = newSection == TLCoreNotFound ? occupiedItemCount
+                : TLCoreLowerBound(occupiedItems, occupiedItemCount, (TLCoreIndexPath){newSection, 0});
+        long nextItem = 0;
+        for (long item = 0; item < oldItemCounts[section]; item++) {
+            const TLCoreRemapSource *itemSource = TLCoreSortedFind(itemSources, itemSourceCount, sizeof(TLCoreRemapSource),
+                                                                   &itemSourceCursor, (TLCoreIndexPath){section, item});
+            if (itemSource) {
+                newIndexPaths[element++] = itemSource->after;
+                continue;
+            }
+            if (newSection == TLCoreNotFound) {
+                newIndexPaths[element++] = notFound;
+                continue;
+            }
+            while (TLCoreSortedFind(occupiedItems, occupiedItemCount, sizeof(TLCoreIndexPath),
+                                    &occupiedItemCursor, (TLCoreIndexPath){newSection, nextItem})) {
+                nextItem++;
+            }
+            newIndexPaths[element++] = (TLCoreIndexPath){newSection, nextItem++};
+        }
+    }
+
+    free(sectionSources);
+    free(itemSources);
+    free(occupiedSections);
+    free(occupiedItems);
+    return true;
+}
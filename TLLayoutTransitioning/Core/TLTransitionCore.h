@@ -0,0 +1,244 @@
+//
+//  TLTransitionCore.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+/**
+ The transition math behind `TLTransitionLayout` and `UICollectionView+TLTransitioning`
+ in plain C with no UIKit, CoreGraphics or Foundation dependencies. The Objective-C
+ classes convert to and from these types and call through to the functions below,
+ so the interpolation and content offset kernels can be built, benchmarked and
+ tested on any platform with a C99 compiler.
+ */
+
+#ifndef TLTransitionCore_h
+#define TLTransitionCore_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Geometry types
+
+typedef struct {
+    double x;
+    double y;
+} TLCorePoint;
+
+typedef struct {
+    double width;
+    double height;
+} TLCoreSize;
+
+typedef struct {
+    TLCorePoint origin;
+    TLCoreSize size;
+} TLCoreRect;
+
+typedef struct {
+    double top;
+    double left;
+    double bottom;
+    double right;
+} TLCoreInsets;
+
+typedef struct {
+    double a, b, c, d;
+    double tx, ty;
+} TLCoreAffineTransform;
+
+typedef struct {
+    double m11, m12, m13, m14;
+    double m21, m22, m23, m24;
+    double m31, m32, m33, m34;
+    double m41, m42, m43, m44;
+} TLCoreTransform3D;
+
+/**
+ The interpolated subset of `UICollectionViewLayoutAttributes`. The bounds origin
+ is always zero, so only the size is stored.
+ */
+typedef struct {
+    TLCoreSize size;
+    TLCorePoint center;
+    double alpha;
+    TLCoreAffineTransform transform;
+    TLCoreTransform3D transform3D;
+} TLCorePose;
+
+extern const TLCoreRect TLCoreRectNull;
+
+bool TLCoreRectIsNull(TLCoreRect rect);
+double TLCoreRectGetMinX(TLCoreRect rect);
+double TLCoreRectGetMidX(TLCoreRect rect);
+double TLCoreRectGetMaxX(TLCoreRect rect);
+double TLCoreRectGetMinY(TLCoreRect rect);
+double TLCoreRectGetMidY(TLCoreRect rect);
+double TLCoreRectGetMaxY(TLCoreRect rect);
+
+/**
+ Same semantics as `CGRectUnion`, including the handling of `TLCoreRectNull`.
+ */
+TLCoreRect TLCoreRectUnion(TLCoreRect rect, TLCoreRect otherRect);
+
+/**
+ Same semantics as `UIEdgeInsetsInsetRect`.
+ */
+TLCoreRect TLCoreRectInset(TLCoreRect rect, TLCoreInsets insets);
+
+// Interpolation
+
+double TLCoreInterpolateFloat(double fromFloat, double toFloat, double progress);
+TLCorePoint TLCoreInterpolatePoint(TLCorePoint fromPoint, TLCorePoint toPoint, double progress);
+TLCoreSize TLCoreInterpolateSize(TLCoreSize fromSize, TLCoreSize toSize, double progress);
+TLCoreRect TLCoreInterpolateRect(TLCoreRect fromRect, TLCoreRect toRect, double progress);
+TLCoreInsets TLCoreInterpolateInsets(TLCoreInsets fromInsets, TLCoreInsets toInsets, double progress);
+
+/**
+ Interpolates every field of `fromPose` and `toPose` into `pose`. `pose` may alias
+ either of the inputs.
+ */
+void TLCoreInterpolatePose(TLCorePose *pose, const TLCorePose *fromPose, const TLCorePose *toPose, double progress);
+
+// Progress and time
+
+/**
+ Returns the clamped linear progress of `currentValue` between `initialValue`
+ and `finalValue`. Easing is applied by the caller.
+ */
+double TLCoreProgress(double initialValue, double currentValue, double finalValue);
+
+/**
+ `TLTransitionLayout` interpolates from the previously computed poses rather than
+ the original layout, so each step needs the fraction of the remaining distance
+ covered by moving from `previousProgress` to `progress`. Works in both directions.
+ */
+double TLCoreIncrementalProgress(double previousProgress, double progress);
+
+/**
+ See `TLConvertTimespace`.
+ */
+double TLCoreConvertTimespace(double time, double startTime, double endTime);
+
+// Placement
+
+/**
+ Mirrors `TLTransitionLayoutIndexPathPlacement`. The values must stay in sync.
+ */
+typedef enum {
+    TLCorePlacementNone,
+    TLCorePlacementMinimal,
+    TLCorePlacementVisible,
+    TLCorePlacementCenter,
+    TLCorePlacementTop,
+    TLCorePlacementLeft,
+    TLCorePlacementBottom,
+    TLCorePlacementRight,
+} TLCorePlacement;
+
+/**
+ The inputs to the content offset solver. `fromFrame` and `toFrame` are the unions
+ of the placed items' frames in the current and next layouts.
+ */
+typedef struct {
+    TLCorePlacement placement;
+    bool defaultPlacementAnchor;
+    TLCorePoint placementAnchor;
+    TLCoreInsets placementInset;
+    TLCoreSize toSize;
+    TLCoreInsets toContentInset;
+    TLCoreSize toContentSize;
+    TLCorePoint contentOffset;
+    TLCoreRect fromFrame;
+    TLCoreRect toFrame;
+} TLCorePlacementContext;
+
+/**
+ Computes the target content offset. See
+ `toContentOffsetForLayout:indexPaths:placement:placementAnchor:placementInset:toSize:toContentInset:`.
+ */
+TLCorePoint TLCoreContentOffsetForPlacement(const TLCorePlacementContext *context);
+
+TLCorePoint TLCoreRelativePointInRect(TLCorePoint point, TLCoreRect rect);
+TLCorePoint TLCorePointForAnchorPoint(TLCorePoint anchorPoint, TLCoreRect frame);
+
+/**
+ Returns the smallest offset of `childFrame` that maximizes its intersection with
+ `parentFrame`, computed independently along each axis.
+ */
+TLCorePoint TLCoreMinimalOffsetForMaximalIntersection(TLCoreRect parentFrame, TLCoreRect childFrame);
+double TLCoreLinearOffset(double spaceBeforeChild, double spaceAfterChild);
+
+// Batch updates
+
+enum {
+    TLCoreNotFound = -1,
+};
+
+typedef struct {
+    long section;
+    long item;
+} TLCoreIndexPath;
+
+/**
+ Mirrors the `UICollectionUpdateAction` values that change index paths. Reloads
+ keep their index paths and aren't represented.
+ */
+typedef enum {
+    TLCoreUpdateActionDelete,
+    TLCoreUpdateActionInsert,
+    TLCoreUpdateActionMove,
+} TLCoreUpdateAction;
+
+/**
+ One `UICollectionViewUpdateItem`. `before` is relative to the data before the
+ update and unused for inserts; `after` is relative to the data after it and
+ unused for deletes. Section updates have an `item` of `TLCoreNotFound`.
+ */
+typedef struct {
+    TLCoreUpdateAction action;
+    TLCoreIndexPath before;
+    TLCoreIndexPath after;
+} TLCoreUpdate;
+
+/**
+ Maps the sections and items of a collection view before a batch update to their
+ positions after it, so `TLTransitionLayout` can carry in-flight poses across the
+ update. Deleted sections and items map to `TLCoreNotFound`, moved ones to their
+ destinations, and the rest keep their relative order, filling the positions not
+ taken by inserts and move destinations.
+ 
+ `newSections` receives one entry per old section and `newIndexPaths` one per old
+ item, in section order. Returns false if memory could not be allocated.
+ */
+bool TLCoreRemapIndexPaths(const long *oldItemCounts, long oldNumberOfSections,
+                           const TLCoreUpdate *updates, size_t updateCount,
+                           long *newSections, TLCoreIndexPath *newIndexPaths);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
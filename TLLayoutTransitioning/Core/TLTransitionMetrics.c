@@ -0,0 +1,149 @@
+//
+//  TLTransitionMetrics.c
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "TLTransitionMetrics.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+uint64_t TLCoreMetricsNow(void)
+{
+#if defined(__APPLE__)
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+// Ring buffer sink
+
+struct TLCoreMetricsRingBuffer {
+    TLCoreFrameMetrics *frames;
+    size_t capacity;
+    uint64_t totalCount;
+};
+
+TLCoreMetricsRingBuffer *TLCoreMetricsRingBufferCreate(size_t capacity)
+{
+    if (capacity == 0) {
+        return NULL;
+    }
+    TLCoreMetricsRingBuffer *buffer = calloc(1, sizeof(TLCoreMetricsRingBuffer));
+    if (!buffer) {
+        return NULL;
+    }
+    buffer->frames = calloc(capacity, sizeof(TLCoreFrameMetrics));
+    if (!buffer->frames) {
+        free(buffer);
+        return NULL;
+    }
+    buffer->capacity = capacity;
+    return buffer;
+}
+
+void TLCoreMetricsRingBufferDestroy(TLCoreMetricsRingBuffer *buffer)
+{
+    if (buffer) {
+        free(buffer->frames);
+        free(buffer);
+    }
+}
+
+void TLCoreMetricsRingBufferClear(TLCoreMetricsRingBuffer *buffer)
+{
+    buffer->totalCount = 0;
+}
+
+static void TLCoreMetricsRingBufferRecord(void *context, const TLCoreFrameMetrics *metrics)
+{
+    TLCoreMetricsRingBuffer *buffer = context;
+    buffer->frames[buffer->totalCount % buffer->capacity] = *metrics;
+    buffer->totalCount++;
+}
+
+TLCoreMetricsSink TLCoreMetricsRingBufferSink(TLCoreMetricsRingBuffer *buffer)
+{
+    TLCoreMetricsSink sink = {buffer ? TLCoreMetricsRingBufferRecord : NULL, buffer};
+    return sink;
+}
+
+size_t TLCoreMetricsRingBufferCount(const TLCoreMetricsRingBuffer *buffer)
+{
+    return buffer->totalCount < buffer->capacity ? (size_t)buffer->totalCount : buffer->capacity;
+}
+
+uint64_t TLCoreMetricsRingBufferTotalCount(const TLCoreMetricsRingBuffer *buffer)
+{
+    return buffer->totalCount;
+}
+
+size_t TLCoreMetricsRingBufferCopy(const TLCoreMetricsRingBuffer *buffer, TLCoreFrameMetrics *metrics, size_t maxCount)
+{
+    size_t count = TLCoreMetricsRingBufferCount(buffer);
+    if (count > maxCount) {
+        count = maxCount;
+    }
+    // the oldest retained frame follows the most recently written slot once the buffer wraps
+    uint64_t first = buffer->totalCount - TLCoreMetricsRingBufferCount(buffer);
+    for (size_t i = 0; i < count; i++) {
+        metrics[i] = buffer->frames[(first + i) % buffer->capacity];
+    }
+    return count;
+}
+
+// Log sink
+
+static void TLCoreMetricsLogRecord(void *context, const TLCoreFrameMetrics *metrics)
+{
+    FILE *file = context ? context : stderr;
+    fprintf(file, "TLTransitionMetrics frame=%" PRIu64 " progress=%.4f time=%.4f elements=%" PRIu32
+            " rectQueries=%" PRIu32 " returned=%" PRIu32 " dropped=%" PRIu32
+            " contentOffsetNs=%" PRIu64 " prepareNs=%" PRIu64 " rectNs=%" PRIu64
+            " updateAttributesNs=%" PRIu64 " progressChangedNs=%" PRIu64 " totalNs=%" PRIu64 "\n",
+            metrics->frame, metrics->progress, metrics->time, metrics->elementsInterpolated,
+            metrics->rectQueries, metrics->elementsReturned, metrics->droppedFrames,
+            metrics->contentOffsetNanoseconds, metrics->prepareLayoutNanoseconds, metrics->rectQueryNanoseconds,
+            metrics->updateLayoutAttributesNanoseconds, metrics->progressChangedNanoseconds, metrics->totalNanoseconds);
+}
+
+TLCoreMetricsSink TLCoreMetricsLogSink(FILE *file)
+{
+    TLCoreMetricsSink sink = {TLCoreMetricsLogRecord, file};
+    return sink;
+}
@@ -0,0 +1,119 @@
+//
+//  TLTransitionMetrics.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+/**
+ Per-frame transition metrics and the sinks they are delivered to. `TLTransitionLayout`
+ only collects metrics while a sink is installed, so there is no timing overhead
+ by default. A ring buffer and a log sink are provided here for portable builds;
+ `TLTransitionSignpostMetricsSink()` emits signposts on device.
+ */
+
+#ifndef TLTransitionMetrics_h
+#define TLTransitionMetrics_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ The work done for one transition frame, i.e. one progress update and the layout
+ passes that follow it. Times are in nanoseconds.
+ */
+typedef struct {
+    uint64_t frame;
+    double progress;
+    double time;
+    uint32_t elementsInterpolated;
+    uint32_t rectQueries;
+    uint32_t elementsReturned;
+    uint32_t droppedFrames;
+    uint64_t contentOffsetNanoseconds;
+    uint64_t prepareLayoutNanoseconds;
+    uint64_t rectQueryNanoseconds;
+    uint64_t updateLayoutAttributesNanoseconds;
+    uint64_t progressChangedNanoseconds;
+    uint64_t totalNanoseconds;
+} TLCoreFrameMetrics;
+
+typedef void (*TLCoreMetricsRecordFunction)(void *context, const TLCoreFrameMetrics *metrics);
+
+/**
+ A sink is a record function and the context passed to it. A zeroed sink is disabled.
+ */
+typedef struct {
+    TLCoreMetricsRecordFunction record;
+    void *context;
+} TLCoreMetricsSink;
+
+/**
+ A monotonic timestamp in nanoseconds.
+ */
+uint64_t TLCoreMetricsNow(void);
+
+// Ring buffer sink
+
+/**
+ Retains the most recent `capacity` frames. Not thread safe; records and reads
+ must happen on the same thread, typically the main thread.
+ */
+typedef struct TLCoreMetricsRingBuffer TLCoreMetricsRingBuffer;
+
+TLCoreMetricsRingBuffer *TLCoreMetricsRingBufferCreate(size_t capacity);
+void TLCoreMetricsRingBufferDestroy(TLCoreMetricsRingBuffer *buffer);
+void TLCoreMetricsRingBufferClear(TLCoreMetricsRingBuffer *buffer);
+TLCoreMetricsSink TLCoreMetricsRingBufferSink(TLCoreMetricsRingBuffer *buffer);
+
+/**
+ The number of frames currently retained, at most the capacity.
+ */
+size_t TLCoreMetricsRingBufferCount(const TLCoreMetricsRingBuffer *buffer);
+
+/**
+ The number of frames recorded since creation or the last clear, including those
+ that have been overwritten.
+ */
+uint64_t TLCoreMetricsRingBufferTotalCount(const TLCoreMetricsRingBuffer *buffer);
+
+/**
+ Copies up to `maxCount` retained frames into `metrics`, oldest first, and returns
+ the number copied.
+ */
+size_t TLCoreMetricsRingBufferCopy(const TLCoreMetricsRingBuffer *buffer, TLCoreFrameMetrics *metrics, size_t maxCount);
+
+// Log sink
+
+/**
+ Writes one line of key=value pairs per frame to `file`, or to `stderr` if `file` is NULL.
+ */
+TLCoreMetricsSink TLCoreMetricsLogSink(FILE *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+//
+//  TLTransitionSnapshot.c
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#include "TLTransitionSnapshot.h"
+
+#include <string.h>
+
+#define TLCoreLayoutSnapshotVersion 1
+#define TLCoreLayoutSnapshotByteOrder 0x01020304u
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t numberOfSections;
+    uint32_t supplementaryKindCount;
+    uint32_t elementCount;
+    double boundsWidth;
+    double boundsHeight;
+} TLCoreLayoutSnapshotHeader;
+
+static const char TLCoreLayoutSnapshotMagic[4] = {'T', 'L', 'L', 'S'};
+
+static size_t TLCoreLayoutSnapshotCountsLength(uint32_t numberOfSections)
+{
+    return ((size_t)numberOfSections * sizeof(uint32_t) + 7) & ~(size_t)7;
+}
+
+static size_t TLCoreLayoutSnapshotLengthForElements(uint32_t numberOfSections, uint64_t elementCount)
+{
+    if (elementCount > UINT32_MAX || elementCount > (SIZE_MAX - sizeof(TLCoreLayoutSnapshotHeader)) / 2 / sizeof(TLCorePose)) {
+        return 0;
+    }
+    return sizeof(TLCoreLayoutSnapshotHeader) + TLCoreLayoutSnapshotCountsLength(numberOfSections)
+            + (size_t)elementCount * sizeof(TLCorePose);
+}
+
+static uint64_t TLCoreLayoutSnapshotElementCount(uint32_t numberOfSections, const uint32_t *itemCounts, uint32_t supplementaryKindCount)
+{
+    uint64_t elementCount = (uint64_t)numberOfSections * supplementaryKindCount;
+    for (uint32_t section = 0; section < numberOfSections; section++) {
+        elementCount += itemCounts[section];
+    }
+    return elementCount;
+}
+
+size_t TLCoreLayoutSnapshotLength(uint32_t numberOfSections, const uint32_t *itemCounts, uint32_t supplementaryKindCount)
+{
+    return TLCoreLayoutSnapshotLengthForElements(numberOfSections,
+            TLCoreLayoutSnapshotElementCount(numberOfSections, itemCounts, supplementaryKindCount));
+}
+
+TLCorePose *TLCoreLayoutSnapshotInit(void *bytes, uint32_t numberOfSections, const uint32_t *itemCounts, uint32_t supplementaryKindCount, TLCoreSize boundsSize)
+{
+    TLCoreLayoutSnapshotHeader *header = bytes;
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, TLCoreLayoutSnapshotMagic, sizeof(header->magic));
+    header->version = TLCoreLayoutSnapshotVersion;
+    header->byteOrder = TLCoreLayoutSnapshotByteOrder;
+    header->numberOfSections = numberOfSections;
+    header->supplementaryKindCount = supplementaryKindCount;
+    header->elementCount = (uint32_t)TLCoreLayoutSnapshotElementCount(numberOfSections, itemCounts, supplementaryKindCount);
+    header->boundsWidth = boundsSize.width;
+    header->boundsHeight = boundsSize.height;
+    char *counts = (char *)bytes + sizeof(*header);
+    size_t countsLength = TLCoreLayoutSnapshotCountsLength(numberOfSections);
+    memset(counts, 0, countsLength);
+    memcpy(counts, itemCounts, numberOfSections * sizeof(uint32_t));
+    return (TLCorePose *)(counts + countsLength);
+}
+
+bool TLCoreLayoutSnapshotParse(TLCoreLayoutSnapshot *snapshot, const void *bytes, size_t length)
+{
+    const TLCoreLayoutSnapshotHeader *header = bytes;
+    if (!bytes || (uintptr_t)bytes % 8 != 0 || length < sizeof(*header)
+            || memcmp(header->magic, TLCoreLayoutSnapshotMagic, sizeof(header->magic)) != 0
+            || header->version != TLCoreLayoutSnapshotVersion
+            || header->byteOrder != TLCoreLayoutSnapshotByteOrder
+            || length != TLCoreLayoutSnapshotLengthForElements(header->numberOfSections, header->elementCount)) {
+        return false;
+    }
+    const uint32_t *itemCounts = (const uint32_t *)((const char *)bytes + sizeof(*header));
+    if (TLCoreLayoutSnapshotElementCount(header->numberOfSections, itemCounts, header->supplementaryKindCount) != header->elementCount) {
+        return false;
+    }
+    snapshot->numberOfSections = header->numberOfSections;
+    snapshot->supplementaryKindCount = header->supplementaryKindCount;
+    snapshot->elementCount = header->elementCount;
+    snapshot->boundsSize = (TLCoreSize){header->boundsWidth, header->boundsHeight};
+    snapshot->itemCounts = itemCounts;
+    snapshot->poses = (const TLCorePose *)((const char *)itemCounts + TLCoreLayoutSnapshotCountsLength(header->numberOfSections));
+    return true;
+}
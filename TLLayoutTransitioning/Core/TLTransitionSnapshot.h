@@ -0,0 +1,83 @@
+//
+//  TLTransitionSnapshot.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+/**
+ Immutable snapshots of a layout's geometry in a flat binary format that is used
+ in place, so a snapshot can be read straight out of a memory-mapped file. A snapshot
+ holds the pose of every element in `TLTransitionLayout`'s element order (each
+ section's cells followed by one element per supplementary kind), along with the
+ item counts and bounds size it was taken with so it can be checked against the
+ data it is applied to.
+ 
+ The format is the header, the item count of each section padded to a multiple
+ of 8 bytes, and the poses, all in native byte order.
+ */
+
+#ifndef TLTransitionSnapshot_h
+#define TLTransitionSnapshot_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "TLTransitionCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t numberOfSections;
+    uint32_t supplementaryKindCount;
+    uint32_t elementCount;
+    TLCoreSize boundsSize;
+    const uint32_t *itemCounts;
+    const TLCorePose *poses;
+} TLCoreLayoutSnapshot;
+
+/**
+ Returns the length in bytes of a snapshot with the given counts, or 0 if it
+ would be too large.
+ */
+size_t TLCoreLayoutSnapshotLength(uint32_t numberOfSections, const uint32_t *itemCounts, uint32_t supplementaryKindCount);
+
+/**
+ Writes the header and item counts of a snapshot into `bytes`, which must be
+ 8-byte aligned and `TLCoreLayoutSnapshotLength()` bytes long, and returns the
+ pose array for the caller to fill in element order.
+ */
+TLCorePose *TLCoreLayoutSnapshotInit(void *bytes, uint32_t numberOfSections, const uint32_t *itemCounts, uint32_t supplementaryKindCount, TLCoreSize boundsSize);
+
+/**
+ Parses a snapshot without copying; `snapshot` points into `bytes`, which must
+ outlive it. Returns false if `bytes` is not an 8-byte aligned snapshot of this
+ version and byte order.
+ */
+bool TLCoreLayoutSnapshotParse(TLCoreLayoutSnapshot *snapshot, const void *bytes, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
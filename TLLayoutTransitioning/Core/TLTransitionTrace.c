@@ -0,0 +1,309 @@
+//
+//  TLTransitionTrace.c
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#include "TLTransitionTrace.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TLCoreTraceVersion 1
+#define TLCoreTraceByteOrder 0x01020304u
+#define TLCoreTraceFlagHasToContentOffset 0x1u
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t elementCount;
+    uint32_t flags;
+    uint32_t reserved;
+    double viewportWidth;
+    double viewportHeight;
+    double fromContentOffsetX;
+    double fromContentOffsetY;
+    double toContentOffsetX;
+    double toContentOffsetY;
+} TLCoreTraceHeader;
+
+static const char TLCoreTraceMagic[4] = {'T', 'L', 'T', 'R'};
+
+TLCoreTrace *TLCoreTraceCreate(void)
+{
+    return calloc(1, sizeof(TLCoreTrace));
+}
+
+void TLCoreTraceDestroy(TLCoreTrace *trace)
+{
+    if (trace) {
+        free(trace->fromPoses);
+        free(trace->toPoses);
+        free(trace->events);
+        free(trace);
+    }
+}
+
+bool TLCoreTraceSetElementCount(TLCoreTrace *trace, uint32_t elementCount)
+{
+    free(trace->fromPoses);
+    free(trace->toPoses);
+    trace->fromPoses = calloc(elementCount ? elementCount : 1, sizeof(TLCorePose));
+    trace->toPoses = calloc(elementCount ? elementCount : 1, sizeof(TLCorePose));
+    if (!trace->fromPoses || !trace->toPoses) {
+        free(trace->fromPoses);
+        free(trace->toPoses);
+        trace->fromPoses = trace->toPoses = NULL;
+        trace->elementCount = 0;
+        return false;
+    }
+    trace->elementCount = elementCount;
+    return true;
+}
+
+bool TLCoreTraceAppendEvent(TLCoreTrace *trace, TLCoreTraceEventType type, double timestamp, double value0, double value1)
+{
+    if (trace->eventCount == trace->eventCapacity) {
+        size_t capacity = trace->eventCapacity ? trace->eventCapacity * 2 : 128;
+        TLCoreTraceEvent *events = realloc(trace->events, capacity * sizeof(TLCoreTraceEvent));
+        if (!events) {
+            return false;
+        }
+        trace->events = events;
+        trace->eventCapacity = capacity;
+    }
+    TLCoreTraceEvent event = {(uint32_t)type, 0, timestamp, {value0, value1}};
+    trace->events[trace->eventCount++] = event;
+    return true;
+}
+
+bool TLCoreTraceWrite(const TLCoreTrace *trace, FILE *file)
+{
+    TLCoreTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TLCoreTraceMagic, sizeof(header.magic));
+    header.version = TLCoreTraceVersion;
+    header.byteOrder = TLCoreTraceByteOrder;
+    header.elementCount = trace->elementCount;
+    header.flags = trace->hasToContentOffset ? TLCoreTraceFlagHasToContentOffset : 0;
+    header.viewportWidth = trace->viewportSize.width;
+    header.viewportHeight = trace->viewportSize.height;
+    header.fromContentOffsetX = trace->fromContentOffset.x;
+    header.fromContentOffsetY = trace->fromContentOffset.y;
+    header.toContentOffsetX = trace->toContentOffset.x;
+    header.toContentOffsetY = trace->toContentOffset.y;
+    uint64_t eventCount = trace->eventCount;
+    return fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(trace->fromPoses, sizeof(TLCorePose), trace->elementCount, file) == trace->elementCount
+        && fwrite(trace->toPoses, sizeof(TLCorePose), trace->elementCount, file) == trace->elementCount
+        && fwrite(&eventCount, sizeof(eventCount), 1, file) == 1
+        && fwrite(trace->events, sizeof(TLCoreTraceEvent), trace->eventCount, file) == trace->eventCount;
+}
+
+/*
+ Returns the number of bytes between the current position and the end of `file`,
+ or UINT64_MAX if the stream isn't seekable.
+ */
+static uint64_t TLCoreTraceRemainingLength(FILE *file)
+{
+    long position = ftell(file);
+    if (position < 0 || fseek(file, 0, SEEK_END) != 0) {
+        return UINT64_MAX;
+    }
+    long end = ftell(file);
+    if (fseek(file, position, SEEK_SET) != 0) {
+        return 0;
+    }
+    return end < position ? 0 : (uint64_t)(end - position);
+}
+
+TLCoreTrace *TLCoreTraceRead(FILE *file)
+{
+    TLCoreTraceHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1
+            || memcmp(header.magic, TLCoreTraceMagic, sizeof(header.magic)) != 0
+            || header.version != TLCoreTraceVersion
+            || header.byteOrder != TLCoreTraceByteOrder) {
+        return NULL;
+    }
+    // validate the counts against the file before allocating for them, so a
+    // truncated or corrupt header can't request arbitrarily large buffers
+    uint64_t remaining = TLCoreTraceRemainingLength(file);
+    uint64_t posesLength = 2 * (uint64_t)header.elementCount * sizeof(TLCorePose);
+    if (remaining < posesLength + sizeof(uint64_t)) {
+        return NULL;
+    }
+    TLCoreTrace *trace = TLCoreTraceCreate();
+    if (!trace || !TLCoreTraceSetElementCount(trace, header.elementCount)) {
+        TLCoreTraceDestroy(trace);
+        return NULL;
+    }
+    trace->viewportSize = (TLCoreSize){header.viewportWidth, header.viewportHeight};
+    trace->fromContentOffset = (TLCorePoint){header.fromContentOffsetX, header.fromContentOffsetY};
+    trace->hasToContentOffset = header.flags & TLCoreTraceFlagHasToContentOffset;
+    trace->toContentOffset = (TLCorePoint){header.toContentOffsetX, header.toContentOffsetY};
+    uint64_t eventCount;
+    if (fread(trace->fromPoses, sizeof(TLCorePose), trace->elementCount, file) != trace->elementCount
+            || fread(trace->toPoses, sizeof(TLCorePose), trace->elementCount, file) != trace->elementCount
+            || fread(&eventCount, sizeof(eventCount), 1, file) != 1) {
+        TLCoreTraceDestroy(trace);
+        return NULL;
+    }
+    if (remaining == UINT64_MAX) {
+        // the length of a stream isn't known up front, so grow the event buffer
+        // as events are actually read
+        for (uint64_t e = 0; e < eventCount; e++) {
+            TLCoreTraceEvent event;
+            if (fread(&event, sizeof(event), 1, file) != 1
+                    || !TLCoreTraceAppendEvent(trace, event.type, event.timestamp, event.values[0], event.values[1])) {
+                TLCoreTraceDestroy(trace);
+                return NULL;
+            }
+        }
+        return trace;
+    }
+    if (eventCount > (remaining - posesLength - sizeof(uint64_t)) / sizeof(TLCoreTraceEvent)) {
+        TLCoreTraceDestroy(trace);
+        return NULL;
+    }
+    trace->events = malloc((eventCount ? eventCount : 1) * sizeof(TLCoreTraceEvent));
+    if (!trace->events || fread(trace->events, sizeof(TLCoreTraceEvent), eventCount, file) != eventCount) {
+        TLCoreTraceDestroy(trace);
+        return NULL;
+    }
+    trace->eventCount = trace->eventCapacity = eventCount;
+    return trace;
+}
+
+static void TLCoreTraceFlushFrame(TLCoreFrameMetrics *metrics, bool *pending, TLCoreMetricsSink sink)
+{
+    if (*pending) {
+        *pending = false;
+        if (sink.record) {
+            sink.record(sink.context, metrics);
+        }
+    }
+}
+
+size_t TLCoreTraceReplay(const TLCoreTrace *trace, TLCoreMetricsSink sink)
+{
+    uint32_t count = trace->elementCount;
+    TLCorePose *poses = malloc((count ? count : 1) * sizeof(TLCorePose));
+    if (!poses) {
+        return 0;
+    }
+    bool hasPoses = false;
+    bool cancelled = false;
+    double progress = 0;
+    double previousProgress = 0;
+    bool hasToContentOffset = trace->hasToContentOffset;
+    TLCorePoint toContentOffset = trace->toContentOffset;
+    TLCorePoint contentOffset = trace->fromContentOffset;
+    double lastDisplayLinkTimestamp = 0;
+
+    TLCoreFrameMetrics metrics;
+    memset(&metrics, 0, sizeof(metrics));
+    bool pending = false;
+    size_t frames = 0;
+
+    for (size_t e = 0; e < trace->eventCount && !cancelled; e++) {
+        const TLCoreTraceEvent *event = &trace->events[e];
+        switch (event->type) {
+            case TLCoreTraceEventProgress:
+            {
+                if (event->values[0] == progress) {
+                    break;
+                }
+                TLCoreTraceFlushFrame(&metrics, &pending, sink);
+                memset(&metrics, 0, sizeof(metrics));
+                metrics.frame = frames++;
+                metrics.progress = event->values[0];
+                metrics.time = event->values[1];
+                pending = true;
+
+                uint64_t start = TLCoreMetricsNow();
+                previousProgress = progress;
+                progress = event->values[0];
+                if (hasToContentOffset) {
+                    contentOffset = TLCoreInterpolatePoint(trace->fromContentOffset, toContentOffset, progress);
+                }
+                uint64_t offsetEnd = TLCoreMetricsNow();
+
+                // mirrors `-[TLTransitionLayout prepareLayout]`
+                bool reverse = previousProgress > progress;
+                double t = TLCoreIncrementalProgress(previousProgress, progress);
+                for (uint32_t i = 0; i < count; i++) {
+                    const TLCorePose *fromPose = hasPoses ? &poses[i] : &trace->fromPoses[i];
+                    const TLCorePose *toPose = reverse ? &trace->fromPoses[i] : &trace->toPoses[i];
+                    TLCoreInterpolatePose(&poses[i], fromPose, toPose, t);
+                }
+                hasPoses = true;
+                uint64_t prepareEnd = TLCoreMetricsNow();
+
+                // mirrors `-[TLTransitionLayout layoutAttributesForElementsInRect:]` for the viewport
+                TLCoreRect rect = {contentOffset, trace->viewportSize};
+                uint32_t returned = 0;
+                for (uint32_t i = 0; i < count; i++) {
+                    TLCoreRect frame = {{poses[i].center.x - poses[i].size.width / 2,
+                                         poses[i].center.y - poses[i].size.height / 2}, poses[i].size};
+                    if (TLCoreRectGetMinX(frame) < TLCoreRectGetMaxX(rect) && TLCoreRectGetMaxX(frame) > TLCoreRectGetMinX(rect)
+                            && TLCoreRectGetMinY(frame) < TLCoreRectGetMaxY(rect) && TLCoreRectGetMaxY(frame) > TLCoreRectGetMinY(rect)) {
+                        returned++;
+                    }
+                }
+                uint64_t queryEnd = TLCoreMetricsNow();
+
+                metrics.elementsInterpolated = count;
+                metrics.rectQueries = 1;
+                metrics.elementsReturned = returned;
+                metrics.contentOffsetNanoseconds = offsetEnd - start;
+                metrics.prepareLayoutNanoseconds = prepareEnd - offsetEnd;
+                metrics.rectQueryNanoseconds = queryEnd - prepareEnd;
+                metrics.totalNanoseconds = queryEnd - start;
+                break;
+            }
+            case TLCoreTraceEventDisplayLink:
+            {
+                double duration = event->values[0];
+                if (pending && lastDisplayLinkTimestamp > 0 && duration > 0) {
+                    long dropped = lround((event->timestamp - lastDisplayLinkTimestamp) / duration) - 1;
+                    metrics.droppedFrames += dropped > 0 ? (uint32_t)dropped : 0;
+                }
+                lastDisplayLinkTimestamp = event->timestamp;
+                break;
+            }
+            case TLCoreTraceEventRetarget:
+                hasToContentOffset = true;
+                toContentOffset = (TLCorePoint){event->values[0], event->values[1]};
+                break;
+            case TLCoreTraceEventCancel:
+                cancelled = true;
+                break;
+            default:
+                break;
+        }
+    }
+    TLCoreTraceFlushFrame(&metrics, &pending, sink);
+    free(poses);
+    return frames;
+}
@@ -0,0 +1,119 @@
+//
+//  TLTransitionTrace.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+/**
+ Recorded transition traces and their deterministic replay. A trace holds a
+ snapshot of the endpoint geometry (the "from" and "to" pose of every element,
+ in `TLTransitionLayout`'s element order), followed by the stream of progress
+ samples, display link ticks, content offset retargets and cancellation that
+ drove the transition. `TLTransitionLayout` records traces when `tracePath` is
+ set; `TLCoreTraceReplay` re-executes them through the core so frame-time
+ behavior can be profiled and compared off-device.
+ 
+ The file format is the header, the "from" poses, the "to" poses, an event count
+ and the events, all written in native byte order. Readers reject traces written
+ with a different byte order or version.
+ */
+
+#ifndef TLTransitionTrace_h
+#define TLTransitionTrace_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "TLTransitionCore.h"
+#include "TLTransitionMetrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    /** values: progress, time */
+    TLCoreTraceEventProgress = 1,
+    /** values: display link duration */
+    TLCoreTraceEventDisplayLink = 2,
+    /** values: target content offset x, y */
+    TLCoreTraceEventRetarget = 3,
+    /** no values */
+    TLCoreTraceEventCancel = 4,
+} TLCoreTraceEventType;
+
+typedef struct {
+    uint32_t type;
+    uint32_t reserved;
+    /** seconds since recording started; the display link timestamp for display link events */
+    double timestamp;
+    double values[2];
+} TLCoreTraceEvent;
+
+typedef struct {
+    uint32_t elementCount;
+    TLCorePose *fromPoses;
+    TLCorePose *toPoses;
+    TLCoreSize viewportSize;
+    TLCorePoint fromContentOffset;
+    bool hasToContentOffset;
+    TLCorePoint toContentOffset;
+    size_t eventCount;
+    size_t eventCapacity;
+    TLCoreTraceEvent *events;
+} TLCoreTrace;
+
+TLCoreTrace *TLCoreTraceCreate(void);
+void TLCoreTraceDestroy(TLCoreTrace *trace);
+
+/**
+ Sizes the endpoint pose arrays, zeroing their contents. Returns false if
+ memory could not be allocated.
+ */
+bool TLCoreTraceSetElementCount(TLCoreTrace *trace, uint32_t elementCount);
+
+bool TLCoreTraceAppendEvent(TLCoreTrace *trace, TLCoreTraceEventType type, double timestamp, double value0, double value1);
+
+/**
+ Returns false on write errors.
+ */
+bool TLCoreTraceWrite(const TLCoreTrace *trace, FILE *file);
+
+/**
+ Returns NULL if the file is not a readable trace, including when the counts in
+ its header promise more data than the file holds.
+ */
+TLCoreTrace *TLCoreTraceRead(FILE *file);
+
+/**
+ Re-executes `trace` the way `TLTransitionLayout` would have: each progress
+ sample updates the content offset, interpolates every element from the previous
+ poses and queries the viewport rect. Per-frame metrics are delivered to `sink`
+ in order. Returns the number of frames replayed.
+ */
+size_t TLCoreTraceReplay(const TLCoreTrace *trace, TLCoreMetricsSink sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
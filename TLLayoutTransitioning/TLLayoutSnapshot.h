@@ -0,0 +1,82 @@
+//
+//  TLLayoutSnapshot.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import <UIKit/UIKit.h>
+#import "TLTransitionSnapshot.h"
+
+/**
+ An immutable snapshot of a layout's geometry: the size, center, alpha and
+ transforms of every cell and supplementary view, stored in the compact flat
+ binary format described in `TLTransitionSnapshot.h`. The format is used in place,
+ so a snapshot read from disk can be memory-mapped rather than parsed.
+ 
+ Give snapshots of the endpoint layouts to `TLTransitionLayout` to skip querying
+ the layouts on repeat transitions. `TLLayoutSnapshotCache` keeps them per layout,
+ data version and bounds size.
+ */
+@interface TLLayoutSnapshot : NSObject
+
+/**
+ Takes a snapshot of `layout`, which must be prepared for the current contents of
+ `collectionView`. Elements are visited in `TLTransitionLayout`'s order: each
+ section's cells, followed by the section's supplementary views, one for each
+ element of `supplementaryKinds`.
+ */
++ (instancetype)snapshotOfLayout:(UICollectionViewLayout *)layout collectionView:(UICollectionView *)collectionView supplementaryKinds:(NSArray *)supplementaryKinds;
+
+/**
+ Returns a snapshot of the file at `path`, memory-mapped when possible, or nil
+ if the file is missing or is not a valid snapshot.
+ */
++ (instancetype)snapshotWithContentsOfFile:(NSString *)path;
+
+/**
+ Allocates zeroed snapshot data sized for the current contents of `collectionView`
+ and returns it along with its pose array, to be filled in element order before
+ the data is passed to `initWithData:`.
+ */
++ (NSMutableData *)dataForCollectionView:(UICollectionView *)collectionView supplementaryKinds:(NSArray *)supplementaryKinds poses:(TLCorePose **)poses;
+
+/**
+ Returns nil if `data` is not a valid snapshot. The data is used without copying
+ and must not be mutated afterwards.
+ */
+- (instancetype)initWithData:(NSData *)data;
+
+/**
+ Returns YES if the snapshot was taken with the current item counts and bounds
+ size of `collectionView` and the same number of supplementary kinds.
+ */
+- (BOOL)matchesCollectionView:(UICollectionView *)collectionView supplementaryKinds:(NSArray *)supplementaryKinds;
+
+@property (strong, readonly, nonatomic) NSData *data;
+
+@property (readonly, nonatomic) CGSize boundsSize;
+
+/**
+ The parsed snapshot, pointing into `data`.
+ */
+@property (readonly, nonatomic) const TLCoreLayoutSnapshot *coreSnapshot;
+
+@end
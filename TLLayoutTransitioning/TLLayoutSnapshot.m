@@ -0,0 +1,114 @@
+//
+//  TLLayoutSnapshot.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import "TLLayoutSnapshot.h"
+#import "TLTransitionCore+UIKit.h"
+
+@implementation TLLayoutSnapshot
+{
+    TLCoreLayoutSnapshot _coreSnapshot;
+}
+
++ (instancetype)snapshotOfLayout:(UICollectionViewLayout *)layout collectionView:(UICollectionView *)collectionView supplementaryKinds:(NSArray *)supplementaryKinds
+{
+    TLCorePose *poses;
+    NSMutableData *data = [self dataForCollectionView:collectionView supplementaryKinds:supplementaryKinds poses:&poses];
+    if (!data) {
+        return nil;
+    }
+    NSUInteger element = 0;
+    for (NSInteger section = 0; section < [collectionView numberOfSections]; section++) {
+        for (NSInteger item = 0; item < [collectionView numberOfItemsInSection:section]; item++) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
+            poses[element++] = TLCorePoseFromLayoutAttributes([layout layoutAttributesForItemAtIndexPath:indexPath]);
+        }
+        for (NSString *kind in supplementaryKinds) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:section];
+            poses[element++] = TLCorePoseFromLayoutAttributes([layout layoutAttributesForSupplementaryViewOfKind:kind atIndexPath:indexPath]);
+        }
+    }
+    return [[self alloc] initWithData:data];
+}
+
++ (instancetype)snapshotWithContentsOfFile:(NSString *)path
+{
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    return data ? [[self alloc] initWithData:data] : nil;
+}
+
++ (NSMutableData *)dataForCollectionView:(UICollectionView *)collectionView supplementaryKinds:(NSArray *)supplementaryKinds poses:(TLCorePose **)poses
+{
+    uint32_t numberOfSections = (uint32_t)[collectionView numberOfSections];
+    NSMutableData *itemCounts = [NSMutableData dataWithLength:numberOfSections * sizeof(uint32_t)];
+    uint32_t *counts = itemCounts.mutableBytes;
+    for (uint32_t section = 0; section < numberOfSections; section++) {
+        counts[section] = (uint32_t)[collectionView numberOfItemsInSection:section];
+    }
+    size_t length = TLCoreLayoutSnapshotLength(numberOfSections, counts, (uint32_t)supplementaryKinds.count);
+    NSMutableData *data = length ? [NSMutableData dataWithLength:length] : nil;
+    if (!data) {
+        return nil;
+    }
+    *poses = TLCoreLayoutSnapshotInit(data.mutableBytes, numberOfSections, counts, (uint32_t)supplementaryKinds.count,
+                                      TLCoreSizeFromCGSize(collectionView.bounds.size));
+    return data;
+}
+
+- (instancetype)initWithData:(NSData *)data
+{
+    if (self = [super init]) {
+        if (!TLCoreLayoutSnapshotParse(&_coreSnapshot, data.bytes, data.length)) {
+            return nil;
+        }
+        _data = data;
+    }
+    return self;
+}
+
+- (BOOL)matchesCollectionView:(UICollectionView *)collectionView supplementaryKinds:(NSArray *)supplementaryKinds
+{
+    uint32_t numberOfSections = (uint32_t)[collectionView numberOfSections];
+    if (numberOfSections != _coreSnapshot.numberOfSections
+            || !CGSizeEqualToSize(collectionView.bounds.size, self.boundsSize)) {
+        return NO;
+    }
+    for (uint32_t section = 0; section < numberOfSections; section++) {
+        if (_coreSnapshot.itemCounts[section] != (uint32_t)[collectionView numberOfItemsInSection:section]) {
+            return NO;
+        }
+    }
+    return _coreSnapshot.supplementaryKindCount == supplementaryKinds.count;
+}
+
+- (CGSize)boundsSize
+{
+    return CGSizeFromTLCoreSize(_coreSnapshot.boundsSize);
+}
+
+- (const TLCoreLayoutSnapshot *)coreSnapshot
+{
+    return &_coreSnapshot;
+}
+
+@end
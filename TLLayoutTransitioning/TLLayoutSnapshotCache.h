@@ -0,0 +1,54 @@
+//
+//  TLLayoutSnapshotCache.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import <UIKit/UIKit.h>
+#import "TLLayoutSnapshot.h"
+
+/**
+ Caches `TLLayoutSnapshot`s per layout, data version and bounds size, in memory and
+ optionally on disk. Layouts are identified by caller-supplied names, and data
+ versions by caller-supplied strings that must change whenever the data does, so
+ snapshots written on one launch are found again on the next one, where they are
+ memory-mapped. Both are used in file names, so should be file name safe.
+ */
+@interface TLLayoutSnapshotCache : NSObject
+
+/**
+ Snapshots are also written to and read from `directory`, which is created if
+ needed. Pass nil to cache in memory only.
+ */
+- (instancetype)initWithDirectory:(NSString *)directory;
+
+- (TLLayoutSnapshot *)snapshotForLayoutNamed:(NSString *)name dataVersion:(NSString *)dataVersion boundsSize:(CGSize)boundsSize;
+
+/**
+ Caches `snapshot` under its bounds size. Writing to disk happens on a background queue.
+ */
+- (void)setSnapshot:(TLLayoutSnapshot *)snapshot forLayoutNamed:(NSString *)name dataVersion:(NSString *)dataVersion;
+
+- (void)removeAllSnapshots;
+
+@property (copy, readonly, nonatomic) NSString *directory;
+
+@end
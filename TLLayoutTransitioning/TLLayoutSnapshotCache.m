@@ -0,0 +1,101 @@
+//
+//  TLLayoutSnapshotCache.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import "TLLayoutSnapshotCache.h"
+
+@interface TLLayoutSnapshotCache ()
+@property (strong, nonatomic) NSCache *snapshots;
+@end
+
+@implementation TLLayoutSnapshotCache
+
+- (instancetype)init
+{
+    return [self initWithDirectory:nil];
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory
+{
+    if (self = [super init]) {
+        _directory = [directory copy];
+        _snapshots = [[NSCache alloc] init];
+        if (directory) {
+            [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+        }
+    }
+    return self;
+}
+
+- (NSString *)keyForLayoutNamed:(NSString *)name dataVersion:(NSString *)dataVersion boundsSize:(CGSize)boundsSize
+{
+    return [NSString stringWithFormat:@"%@-%@-%gx%g", name, dataVersion, boundsSize.width, boundsSize.height];
+}
+
+- (NSString *)pathForKey:(NSString *)key
+{
+    return self.directory ? [self.directory stringByAppendingPathComponent:[key stringByAppendingPathExtension:@"tlsnapshot"]] : nil;
+}
+
+- (TLLayoutSnapshot *)snapshotForLayoutNamed:(NSString *)name dataVersion:(NSString *)dataVersion boundsSize:(CGSize)boundsSize
+{
+    NSString *key = [self keyForLayoutNamed:name dataVersion:dataVersion boundsSize:boundsSize];
+    TLLayoutSnapshot *snapshot = [self.snapshots objectForKey:key];
+    if (!snapshot && self.directory) {
+        snapshot = [TLLayoutSnapshot snapshotWithContentsOfFile:[self pathForKey:key]];
+        if (snapshot) {
+            [self.snapshots setObject:snapshot forKey:key cost:snapshot.data.length];
+        }
+    }
+    return snapshot;
+}
+
+- (void)setSnapshot:(TLLayoutSnapshot *)snapshot forLayoutNamed:(NSString *)name dataVersion:(NSString *)dataVersion
+{
+    NSString *key = [self keyForLayoutNamed:name dataVersion:dataVersion boundsSize:snapshot.boundsSize];
+    if (!snapshot || [self.snapshots objectForKey:key] == snapshot) {
+        return;
+    }
+    [self.snapshots setObject:snapshot forKey:key cost:snapshot.data.length];
+    NSString *path = [self pathForKey:key];
+    if (path) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+            [snapshot.data writeToFile:path atomically:YES];
+        });
+    }
+}
+
+- (void)removeAllSnapshots
+{
+    [self.snapshots removeAllObjects];
+    if (self.directory) {
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        for (NSString *file in [fileManager contentsOfDirectoryAtPath:self.directory error:nil]) {
+            if ([[file pathExtension] isEqualToString:@"tlsnapshot"]) {
+                [fileManager removeItemAtPath:[self.directory stringByAppendingPathComponent:file] error:nil];
+            }
+        }
+    }
+}
+
+@end
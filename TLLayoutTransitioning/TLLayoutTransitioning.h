@@ -16,5 +16,13 @@ FOUNDATION_EXPORT const unsigned char TLLayoutTransitioningVersionString[];
 
 #import <TLLayoutTransitioning/TLTransitionLayout.h>
 #import <TLLayoutTransitioning/UICollectionView+TLTransitioning.h>
+#import <TLLayoutTransitioning/TLTransitionCore.h>
+#import <TLLayoutTransitioning/TLTransitionCore+UIKit.h>
+#import <TLLayoutTransitioning/TLTransitionMetrics.h>
+#import <TLLayoutTransitioning/TLTransitionSignpost.h>
+#import <TLLayoutTransitioning/TLTransitionTrace.h>
+#import <TLLayoutTransitioning/TLTransitionSnapshot.h>
+#import <TLLayoutTransitioning/TLLayoutSnapshot.h>
+#import <TLLayoutTransitioning/TLLayoutSnapshotCache.h>
 
 
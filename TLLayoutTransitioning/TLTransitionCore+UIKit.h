@@ -0,0 +1,139 @@
+//
+//  TLTransitionCore+UIKit.h
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+/**
+ Inline conversions between the UIKit geometry types and the plain C types of
+ `TLTransitionCore`. Used by the Objective-C classes to call into the core.
+ */
+
+#import <UIKit/UIKit.h>
+#import "TLTransitionCore.h"
+
+static inline TLCorePoint TLCorePointFromCGPoint(CGPoint point)
+{
+    return (TLCorePoint){point.x, point.y};
+}
+
+static inline CGPoint CGPointFromTLCorePoint(TLCorePoint point)
+{
+    return CGPointMake(point.x, point.y);
+}
+
+static inline TLCoreSize TLCoreSizeFromCGSize(CGSize size)
+{
+    return (TLCoreSize){size.width, size.height};
+}
+
+static inline CGSize CGSizeFromTLCoreSize(TLCoreSize size)
+{
+    return CGSizeMake(size.width, size.height);
+}
+
+static inline TLCoreRect TLCoreRectFromCGRect(CGRect rect)
+{
+    return (TLCoreRect){TLCorePointFromCGPoint(rect.origin), TLCoreSizeFromCGSize(rect.size)};
+}
+
+static inline CGRect CGRectFromTLCoreRect(TLCoreRect rect)
+{
+    return (CGRect){CGPointFromTLCorePoint(rect.origin), CGSizeFromTLCoreSize(rect.size)};
+}
+
+static inline TLCoreInsets TLCoreInsetsFromUIEdgeInsets(UIEdgeInsets insets)
+{
+    return (TLCoreInsets){insets.top, insets.left, insets.bottom, insets.right};
+}
+
+static inline UIEdgeInsets UIEdgeInsetsFromTLCoreInsets(TLCoreInsets insets)
+{
+    return UIEdgeInsetsMake(insets.top, insets.left, insets.bottom, insets.right);
+}
+
+static inline TLCoreAffineTransform TLCoreAffineTransformFromCGAffineTransform(CGAffineTransform t)
+{
+    return (TLCoreAffineTransform){t.a, t.b, t.c, t.d, t.tx, t.ty};
+}
+
+static inline CGAffineTransform CGAffineTransformFromTLCoreAffineTransform(TLCoreAffineTransform t)
+{
+    return CGAffineTransformMake(t.a, t.b, t.c, t.d, t.tx, t.ty);
+}
+
+static inline TLCoreTransform3D TLCoreTransform3DFromCATransform3D(CATransform3D t)
+{
+    return (TLCoreTransform3D){
+        t.m11, t.m12, t.m13, t.m14,
+        t.m21, t.m22, t.m23, t.m24,
+        t.m31, t.m32, t.m33, t.m34,
+        t.m41, t.m42, t.m43, t.m44,
+    };
+}
+
+static inline CATransform3D CATransform3DFromTLCoreTransform3D(TLCoreTransform3D t)
+{
+    return (CATransform3D){
+        t.m11, t.m12, t.m13, t.m14,
+        t.m21, t.m22, t.m23, t.m24,
+        t.m31, t.m32, t.m33, t.m34,
+        t.m41, t.m42, t.m43, t.m44,
+    };
+}
+
+/**
+ Reads the interpolated fields of `attributes`. A nil `attributes` yields a zeroed
+ pose, matching the result of messaging nil.
+ */
+static inline TLCorePose TLCorePoseFromLayoutAttributes(UICollectionViewLayoutAttributes *attributes)
+{
+    TLCorePose pose = {{0}};
+    if (attributes) {
+        pose.size = TLCoreSizeFromCGSize(attributes.bounds.size);
+        pose.center = TLCorePointFromCGPoint(attributes.center);
+        pose.alpha = attributes.alpha;
+        pose.transform = TLCoreAffineTransformFromCGAffineTransform(attributes.transform);
+        pose.transform3D = TLCoreTransform3DFromCATransform3D(attributes.transform3D);
+    }
+    return pose;
+}
+
+static inline void TLCoreApplyPoseToLayoutAttributes(TLCorePose pose, UICollectionViewLayoutAttributes *attributes)
+{
+    attributes.bounds = (CGRect){CGPointZero, CGSizeFromTLCoreSize(pose.size)};
+    attributes.center = CGPointFromTLCorePoint(pose.center);
+    attributes.alpha = pose.alpha;
+    attributes.transform = CGAffineTransformFromTLCoreAffineTransform(pose.transform);
+    attributes.transform3D = CATransform3DFromTLCoreTransform3D(pose.transform3D);
+}
+
+/**
+ Maps a nil index path, and the `NSNotFound` item of a section update item, to
+ `TLCoreNotFound`.
+ */
+static inline TLCoreIndexPath TLCoreIndexPathFromIndexPath(NSIndexPath *indexPath)
+{
+    if (!indexPath) {
+        return (TLCoreIndexPath){TLCoreNotFound, TLCoreNotFound};
+    }
+    return (TLCoreIndexPath){(long)indexPath.section, indexPath.item == NSNotFound ? TLCoreNotFound : (long)indexPath.item};
+}
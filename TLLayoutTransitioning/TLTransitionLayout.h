@@ -33,10 +33,18 @@
  to the `TLTransitionAnimatorLayout` protocol, so when used with
  `[UICollectionView+TLTransitioning transitionToCollectionViewLayout:duration:completion:]`,
  this negation happens automatically.
+ 
+ Batch updates can be applied to the collection view while a transition is in flight,
+ for example with `-[TLIndexPathUpdates performBatchUpdatesOnCollectionView:]`. The
+ interpolated poses are carried over to the updated index paths, deleted elements fade
+ out from where they are and inserted elements fade in over the rest of the transition.
+ Both layouts must be able to lay out the updated data.
  */
 
 #import <UIKit/UIKit.h>
 #import "UICollectionView+TLTransitioning.h"
+#import "TLTransitionMetrics.h"
+#import "TLLayoutSnapshot.h"
 
 @interface TLTransitionLayout : UICollectionViewTransitionLayout <TLTransitionAnimatorLayout>
 
@@ -82,6 +90,25 @@
  */
 @property (strong, nonatomic) UICollectionViewLayoutAttributes *(^updateLayoutAttributes)(UICollectionViewLayoutAttributes *layoutAttributes, UICollectionViewLayoutAttributes *fromAttributes, UICollectionViewLayoutAttributes *toAttributes, CGFloat progress);
 
+/**
+ Optional batched alternative to `updateLayoutAttributes`, called once per layout
+ pass for all cells and supplementary views. `poses` holds the interpolated poses
+ and can be modified in place; `fromPoses` and `toPoses` hold the poses in the
+ current and next layouts. `visible` flags the elements whose interpolated frame
+ intersects the collection view's bounds, so the callback can skip the others.
+ Elements are in layout order: each section's cells followed by its supplementary
+ views in `supplementaryKinds` order (see `indexPathForElement:kind:`). When set,
+ `updateLayoutAttributes` is not called.
+ */
+@property (strong, nonatomic) void (^updatePoses)(TLCorePose *poses, const TLCorePose *fromPoses, const TLCorePose *toPoses, const BOOL *visible, NSUInteger count, CGFloat progress);
+
+/**
+ Returns the index path of the element at the given position in the `updatePoses`
+ arrays, setting `kind` to its supplementary kind, or nil for cells. Valid during
+ the `updatePoses` callback.
+ */
+- (NSIndexPath *)indexPathForElement:(NSUInteger)element kind:(NSString * __autoreleasing *)kind;
+
 /**
  Set the transition progress and time. This method can optionally be called instead
  of `setTransitionProgress` when the transition is following a non-linear easing
@@ -99,4 +126,56 @@
  */
 @property (strong, nonatomic) void(^progressChanged)(CGFloat progress);
 
+/**
+ Optional block returning a stable identifier for the item at the given index path,
+ for example `-[TLIndexPathDataModel identifierAtIndexPath:]`. When set, cells are
+ matched by identifier rather than by index path, so cells carry their in-flight
+ poses across batch updates however their index paths change. Identifiers should be
+ unique and must be usable as dictionary keys; items returning nil, or an identifier
+ already returned for an earlier item, are matched by index path instead. Set this
+ before the transition starts.
+ */
+@property (strong, nonatomic) id (^identifierForItemAtIndexPath)(NSIndexPath *indexPath);
+
+/**
+ Optional snapshots of the current and next layouts. When a snapshot matches the
+ collection view's item counts and bounds size, the endpoint's poses are read from
+ it instead of querying the layout, which makes repeat transitions between the same
+ pair of layouts cheap. The `updateLayoutAttributes` callback still receives
+ attributes from the layouts. Snapshots are dropped when batch updates are applied
+ during the transition.
+ */
+@property (strong, nonatomic) TLLayoutSnapshot *currentLayoutSnapshot;
+@property (strong, nonatomic) TLLayoutSnapshot *nextLayoutSnapshot;
+
+/**
+ If `YES`, endpoints without a usable snapshot are captured into `currentLayoutSnapshot`
+ and `nextLayoutSnapshot` on the first layout pass, from the layout queries the pass
+ makes anyway, so they can be cached for the next transition. See `TLLayoutSnapshotCache`.
+ Default value is `NO`.
+ */
+@property (nonatomic) BOOL capturesLayoutSnapshots;
+
+/**
+ Optional sink for per-frame metrics: elements interpolated, rect queries served,
+ time spent in the `updateLayoutAttributes` and `progressChanged` callbacks and
+ total layout time. A frame starts with each progress update and is delivered to
+ the sink when the next one starts or the transition completes. Metrics are only
+ collected while a sink is installed. Use `TLTransitionSignpostMetricsSink()` to
+ emit signposts for Instruments, or `TLCoreMetricsRingBufferSink()` and
+ `TLCoreMetricsLogSink()` from `TLTransitionMetrics.h`.
+ */
+@property (nonatomic) TLCoreMetricsSink metricsSink;
+
+/**
+ Optional path at which to record a trace of the transition for offline replay
+ with the `TLTransitionReplay` tool. The trace captures the "from" and "to" pose of
+ every element on the first layout pass, followed by each progress update, display
+ link tick, `toContentOffset` change and cancellation. It is written on a background
+ queue when the transition completes or is cancelled. Set this before the transition
+ starts; recording adds a copy of every element's endpoint poses to the cost of the
+ first layout pass.
+ */
+@property (copy, nonatomic) NSString *tracePath;
+
 @end
@@ -22,15 +22,65 @@
 //  THE SOFTWARE.
 
 #import "TLTransitionLayout.h"
+#import "TLTransitionCore+UIKit.h"
+#import "TLTransitionTrace.h"
 
 @interface TLTransitionLayout ()
 @property (nonatomic) BOOL toContentOffsetInitialized;
-@property (strong, nonatomic) NSDictionary *poses;
+@property (strong, nonatomic) NSMutableArray *itemPoses;
+@property (strong, nonatomic) NSDictionary *supplementaryPoses;
+@property (strong, nonatomic) NSMutableDictionary *slotsByIdentifier;
 @property (nonatomic) CGFloat previousProgress;
 @property (strong, nonatomic) NSArray *supplementaryKinds;
+@property (strong, nonatomic) NSDictionary *disappearingPoses;
+@property (strong, nonatomic) NSSet *retainedKeys;
 @end
 
+/*
+ Returns the slot of the given cell in `itemPoses`, or `NSNotFound` if the index
+ path is out of range.
+ */
+static NSUInteger TLItemSlot(NSData *sectionStarts, NSInteger section, NSInteger item)
+{
+    NSInteger numberOfSections = (NSInteger)(sectionStarts.length / sizeof(NSUInteger)) - 1;
+    if (section < 0 || section >= numberOfSections || item < 0) {
+        return NSNotFound;
+    }
+    const NSUInteger *starts = sectionStarts.bytes;
+    NSUInteger slot = starts[section] + item;
+    return slot < starts[section + 1] ? slot : NSNotFound;
+}
+
+typedef NS_ENUM(NSUInteger, TLTransitionEndpoint) {
+    TLTransitionEndpointCurrent,
+    TLTransitionEndpointNext,
+};
+
 @implementation TLTransitionLayout
+{
+    // metrics for the frame in progress, only maintained while a sink is installed
+    TLCoreFrameMetrics _frameMetrics;
+    BOOL _frameMetricsPending;
+    uint64_t _frameCount;
+    CFTimeInterval _lastDisplayLinkTimestamp;
+    // trace being recorded, only allocated while `tracePath` is set
+    TLCoreTrace *_trace;
+    CFTimeInterval _traceStartTime;
+    // cell pose slots, see `updateItemSlots`
+    NSData *_sectionStarts;
+    BOOL _itemSlotsStale;
+    // set between a data source count invalidation and the batch update it announces
+    BOOL _awaitingCollectionViewUpdates;
+    // endpoint snapshots usable for the current pass, or being captured on the first one
+    const TLCoreLayoutSnapshot *_endpointSnapshots[2];
+    NSMutableData *_capturedSnapshotData[2];
+    TLCorePose *_capturedPoses[2];
+    // element arrays for the `updatePoses` callback, reused across passes
+    NSMutableData *_batchPoses;
+    NSMutableData *_batchFromPoses;
+    NSMutableData *_batchToPoses;
+    NSMutableData *_batchVisible;
+}
 
 - (id)initWithCurrentLayout:(UICollectionViewLayout *)currentLayout nextLayout:(UICollectionViewLayout *)newLayout
 {
@@ -40,6 +90,12 @@
     return self;
 }
 
+- (void)dealloc
+{
+    [self flushFrameMetrics];
+    [self finishTrace];
+}
+
 - (void)setTransitionProgress:(CGFloat)transitionProgress time:(CGFloat)time
 {
 //    NSLog(@"setTransitionProgress=%f, time=%f", transitionProgress, time);
@@ -50,15 +106,35 @@
         // TODO since time is a user-supplied value, we might want to emit a
         // warning if time goes out-of-bounds
         _transitionTime = MAX(0, MIN(1, time));
+        if (_trace) {
+            TLCoreTraceAppendEvent(_trace, TLCoreTraceEventProgress, [self traceTimestamp],
+                                   transitionProgress, _transitionTime);
+        }
+        BOOL metricsEnabled = self.metricsSink.record != NULL;
+        uint64_t start = 0;
+        if (metricsEnabled) {
+            // each progress update starts a new frame
+            [self flushFrameMetrics];
+            [self frameMetrics];
+            start = TLCoreMetricsNow();
+        }
         if (self.toContentOffsetInitialized) {
-            CGFloat t = self.transitionProgress;
-            CGFloat f = 1 - t;
-            CGPoint offset = CGPointMake(f * self.fromContentOffset.x + t * self.toContentOffset.x, f * self.fromContentOffset.y + t * self.toContentOffset.y);
-            self.collectionView.contentOffset = offset;
+            TLCorePoint offset = TLCoreInterpolatePoint(TLCorePointFromCGPoint(self.fromContentOffset),
+                                                        TLCorePointFromCGPoint(self.toContentOffset),
+                                                        self.transitionProgress);
+            self.collectionView.contentOffset = CGPointFromTLCorePoint(offset);
+        }
+        if (metricsEnabled) {
+            uint64_t now = TLCoreMetricsNow();
+            _frameMetrics.contentOffsetNanoseconds += now - start;
+            start = now;
         }
         if (self.progressChanged) {
             self.progressChanged(transitionProgress);
         }
+        if (metricsEnabled) {
+            _frameMetrics.progressChangedNanoseconds += TLCoreMetricsNow() - start;
+        }
     }
 }
 
@@ -77,41 +153,83 @@
         return;
     };
 
+    if (_awaitingCollectionViewUpdates) {
+        // UIKit lays out with the updated counts before `prepareForCollectionViewUpdates:`
+        // says how they changed. Rebuilding the slots now would hand the in-flight poses
+        // to whichever cells took their positions, so leave the pre-update state in place
+        // for the remap.
+        _awaitingCollectionViewUpdates = NO;
+        return;
+    }
+
+    if (_trace && !self.itemPoses) {
+        [self recordTraceEndpoints];
+    }
+
+    BOOL metricsEnabled = self.metricsSink.record != NULL;
+    uint64_t start = metricsEnabled ? TLCoreMetricsNow() : 0;
+    uint64_t callbackNanoseconds = 0;
+    uint32_t elementsInterpolated = 0;
+
     BOOL reverse = self.previousProgress > self.transitionProgress;
     
-    CGFloat remaining = reverse ? self.previousProgress : 1 - self.previousProgress;
-    CGFloat t = remaining == 0 ? self.transitionProgress : fabs(self.transitionProgress - self.previousProgress) / remaining;
-    CGFloat f = 1 - t;
+    CGFloat t = TLCoreIncrementalProgress(self.previousProgress, self.transitionProgress);
     
-    NSMutableDictionary *poses = [NSMutableDictionary dictionary];
+    [self updateItemSlots];
+    [self prepareEndpointSnapshots];
+    NSMutableArray *itemPoses = [self emptyItemPoses];
+    NSMutableDictionary *supplementaryPoses = [NSMutableDictionary dictionary];
+    NSUInteger element = 0;
+    NSMutableArray *batchAttributes = self.updatePoses ? [self prepareBatch] : nil;
     for (NSInteger section = 0; section < [self.collectionView numberOfSections]; section++) {
         // cells
         for (NSInteger item = 0; item < [self.collectionView numberOfItemsInSection:section]; item++) {
             
             NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
-            NSIndexPath *key = [self keyForIndexPath:indexPath];
+            NSUInteger slot = TLItemSlot(_sectionStarts, section, item);
             
-            UICollectionViewLayoutAttributes *fromPose = self.poses
-                    ? [self.poses objectForKey:key]
-                    : [self.currentLayout layoutAttributesForItemAtIndexPath:indexPath];
-            UICollectionViewLayoutAttributes *toPose = reverse
-                    ? [self.currentLayout layoutAttributesForItemAtIndexPath:indexPath]
-                    : [self.nextLayout layoutAttributesForItemAtIndexPath:indexPath];
+            UICollectionViewLayoutAttributes *inFlightPose = [self itemPoseInSlot:slot];
+            // query each endpoint at most once; batching needs both
+            TLCorePose currentPose;
+            TLCorePose nextPose;
+            if (batchAttributes || reverse || (!inFlightPose && !self.itemPoses)) {
+                currentPose = [self poseInEndpoint:TLTransitionEndpointCurrent element:element indexPath:indexPath kind:nil];
+            }
+            if (batchAttributes || !reverse) {
+                nextPose = [self poseInEndpoint:TLTransitionEndpointNext element:element indexPath:indexPath kind:nil];
+            }
+            TLCorePose fromPose = inFlightPose ? TLCorePoseFromLayoutAttributes(inFlightPose)
+                    : self.itemPoses ? [self appearingPoseForElement:element indexPath:indexPath kind:nil]
+                    : currentPose;
+            TLCorePose toPose = reverse ? currentPose : nextPose;
             UICollectionViewLayoutAttributes *pose = [[[self class] layoutAttributesClass]
                                                       layoutAttributesForCellWithIndexPath:indexPath];
             
-            [self interpolatePose:pose fromPose:fromPose toPose:toPose fromProgress:f toProgress:t];
+            TLCorePose interpolated;
+            TLCoreInterpolatePose(&interpolated, &fromPose, &toPose, t);
+            if (batchAttributes) {
+                [self batchElement:element pose:interpolated fromPose:currentPose toPose:nextPose];
+                [batchAttributes addObject:pose];
+            } else {
+                TLCoreApplyPoseToLayoutAttributes(interpolated, pose);
+            }
             
-            if (self.updateLayoutAttributes) {
+            if (self.updateLayoutAttributes && !batchAttributes) {
+                uint64_t callbackStart = metricsEnabled ? TLCoreMetricsNow() : 0;
                 UICollectionViewLayoutAttributes *fromPose = [self.currentLayout layoutAttributesForItemAtIndexPath:indexPath];
                 UICollectionViewLayoutAttributes *toPose = [self.nextLayout layoutAttributesForItemAtIndexPath:indexPath];
                 UICollectionViewLayoutAttributes *updatedPose = self.updateLayoutAttributes(pose, fromPose, toPose, self.transitionProgress);
                 if (updatedPose) {
                     pose = updatedPose;
                 }
+                if (metricsEnabled) {
+                    callbackNanoseconds += TLCoreMetricsNow() - callbackStart;
+                }
             }
             
-            [poses setObject:pose forKey:key];
+            [itemPoses replaceObjectAtIndex:slot withObject:pose];
+            element++;
+            elementsInterpolated++;
         }
         // supplementary views
         for (NSString *kind in self.supplementaryKinds) {
@@ -119,76 +237,152 @@
             NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:section];
             NSString *key = [self keyForIndexPath:indexPath kind:kind];
             
-            UICollectionViewLayoutAttributes *fromPose = self.poses
-                    ? [self.poses objectForKey:key]
-                    : [self.currentLayout layoutAttributesForSupplementaryViewOfKind:kind atIndexPath:indexPath];
-            UICollectionViewLayoutAttributes *toPose = reverse
-                    ? [self.currentLayout layoutAttributesForSupplementaryViewOfKind:kind atIndexPath:indexPath]
-                    : [self.nextLayout layoutAttributesForSupplementaryViewOfKind:kind atIndexPath:indexPath];
+            UICollectionViewLayoutAttributes *inFlightPose = [self.supplementaryPoses objectForKey:key];
+            TLCorePose currentPose;
+            TLCorePose nextPose;
+            if (batchAttributes || reverse || (!inFlightPose && !self.itemPoses)) {
+                currentPose = [self poseInEndpoint:TLTransitionEndpointCurrent element:element indexPath:indexPath kind:kind];
+            }
+            if (batchAttributes || !reverse) {
+                nextPose = [self poseInEndpoint:TLTransitionEndpointNext element:element indexPath:indexPath kind:kind];
+            }
+            TLCorePose fromPose = inFlightPose ? TLCorePoseFromLayoutAttributes(inFlightPose)
+                    : self.itemPoses ? [self appearingPoseForElement:element indexPath:indexPath kind:kind]
+                    : currentPose;
+            TLCorePose toPose = reverse ? currentPose : nextPose;
             UICollectionViewLayoutAttributes *pose = [[[self class] layoutAttributesClass]
                                                       layoutAttributesForSupplementaryViewOfKind:kind withIndexPath:indexPath];
             
-            [self interpolatePose:pose fromPose:fromPose toPose:toPose fromProgress:f toProgress:t];
+            TLCorePose interpolated;
+            TLCoreInterpolatePose(&interpolated, &fromPose, &toPose, t);
+            if (batchAttributes) {
+                [self batchElement:element pose:interpolated fromPose:currentPose toPose:nextPose];
+                [batchAttributes addObject:pose];
+            } else {
+                TLCoreApplyPoseToLayoutAttributes(interpolated, pose);
+            }
             
-            // TODO need to incorporate the `updateLayoutAttributes` callback
+            // the `updateLayoutAttributes` callback only covers cells; `updatePoses` covers both
             
-            [poses setObject:pose forKey:key];
+            [supplementaryPoses setObject:pose forKey:key];
+            element++;
+            elementsInterpolated++;
+        }
+    }
+    self.itemPoses = itemPoses;
+    self.supplementaryPoses = supplementaryPoses;
+    [self finishCapturingEndpointSnapshots];
+
+    if (batchAttributes) {
+        uint64_t callbackStart = metricsEnabled ? TLCoreMetricsNow() : 0;
+        [self updateBatchedPoses:batchAttributes];
+        if (metricsEnabled) {
+            callbackNanoseconds += TLCoreMetricsNow() - callbackStart;
         }
     }
-    self.poses = poses;
+
+    if (metricsEnabled) {
+        TLCoreFrameMetrics *metrics = [self frameMetrics];
+        metrics->elementsInterpolated += elementsInterpolated;
+        metrics->updateLayoutAttributesNanoseconds += callbackNanoseconds;
+        metrics->prepareLayoutNanoseconds += TLCoreMetricsNow() - start - callbackNanoseconds;
+    }
 }
 
-- (void)interpolatePose:(UICollectionViewLayoutAttributes *)pose fromPose:(UICollectionViewLayoutAttributes *)fromPose toPose:(UICollectionViewLayoutAttributes *)toPose fromProgress:(CGFloat)f toProgress:(CGFloat)t
+#pragma mark - Batched updates
+
+/*
+ Sizes the element arrays for the current contents of the collection view and
+ returns an array to collect the elements' layout attributes in element order.
+ */
+- (NSMutableArray *)prepareBatch
 {
-    CGRect bounds = CGRectZero;
-    bounds.size.width = f * fromPose.bounds.size.width + t * toPose.bounds.size.width;
-    bounds.size.height = f * fromPose.bounds.size.height + t * toPose.bounds.size.height;
-    pose.bounds = bounds;
- 
-    CGPoint center = CGPointZero;
-    center.x = f * fromPose.center.x + t * toPose.center.x;
-    center.y = f * fromPose.center.y + t * toPose.center.y;
-    pose.center = center;
-    
-    pose.alpha = f * fromPose.alpha + t * toPose.alpha;
-
-    CGAffineTransform transform = CGAffineTransformIdentity;
-    transform.a = f * fromPose.transform.a + t * toPose.transform.a;
-    transform.b = f * fromPose.transform.b + t * toPose.transform.b;
-    transform.c = f * fromPose.transform.c + t * toPose.transform.c;
-    transform.d = f * fromPose.transform.d + t * toPose.transform.d;
-    transform.tx = f * fromPose.transform.tx + t * toPose.transform.tx;
-    transform.ty = f * fromPose.transform.ty + t * toPose.transform.ty;
-    pose.transform = transform;
-    
-    CATransform3D transform3D = CATransform3DIdentity;
-    transform3D.m11 = f * fromPose.transform3D.m11 + t * toPose.transform3D.m11;
-    transform3D.m12 = f * fromPose.transform3D.m12 + t * toPose.transform3D.m12;
-    transform3D.m13 = f * fromPose.transform3D.m13 + t * toPose.transform3D.m13;
-    transform3D.m14 = f * fromPose.transform3D.m14 + t * toPose.transform3D.m14;
-    transform3D.m21 = f * fromPose.transform3D.m21 + t * toPose.transform3D.m21;
-    transform3D.m22 = f * fromPose.transform3D.m22 + t * toPose.transform3D.m22;
-    transform3D.m23 = f * fromPose.transform3D.m23 + t * toPose.transform3D.m23;
-    transform3D.m24 = f * fromPose.transform3D.m24 + t * toPose.transform3D.m24;
-    transform3D.m31 = f * fromPose.transform3D.m31 + t * toPose.transform3D.m31;
-    transform3D.m32 = f * fromPose.transform3D.m32 + t * toPose.transform3D.m32;
-    transform3D.m33 = f * fromPose.transform3D.m33 + t * toPose.transform3D.m33;
-    transform3D.m34 = f * fromPose.transform3D.m34 + t * toPose.transform3D.m34;
-    transform3D.m41 = f * fromPose.transform3D.m41 + t * toPose.transform3D.m41;
-    transform3D.m42 = f * fromPose.transform3D.m42 + t * toPose.transform3D.m42;
-    transform3D.m43 = f * fromPose.transform3D.m43 + t * toPose.transform3D.m43;
-    transform3D.m44 = f * fromPose.transform3D.m44 + t * toPose.transform3D.m44;
-    pose.transform3D = transform3D;
+    NSUInteger numberOfSections = _sectionStarts.length / sizeof(NSUInteger) - 1;
+    NSUInteger count = ((const NSUInteger *)_sectionStarts.bytes)[numberOfSections] + numberOfSections * self.supplementaryKinds.count;
+    if (_batchPoses.length < count * sizeof(TLCorePose)) {
+        _batchPoses = [NSMutableData dataWithLength:count * sizeof(TLCorePose)];
+        _batchFromPoses = [NSMutableData dataWithLength:count * sizeof(TLCorePose)];
+        _batchToPoses = [NSMutableData dataWithLength:count * sizeof(TLCorePose)];
+        _batchVisible = [NSMutableData dataWithLength:count * sizeof(BOOL)];
+    }
+    return [NSMutableArray arrayWithCapacity:count];
+}
+
+- (void)batchElement:(NSUInteger)element pose:(TLCorePose)pose fromPose:(TLCorePose)fromPose toPose:(TLCorePose)toPose
+{
+    ((TLCorePose *)_batchPoses.mutableBytes)[element] = pose;
+    ((TLCorePose *)_batchFromPoses.mutableBytes)[element] = fromPose;
+    ((TLCorePose *)_batchToPoses.mutableBytes)[element] = toPose;
+}
+
+/*
+ Flags the elements intersecting the visible bounds, hands the element arrays to the
+ `updatePoses` callback and applies the results to the elements' layout attributes.
+ */
+- (void)updateBatchedPoses:(NSArray *)attributes
+{
+    NSUInteger count = attributes.count;
+    TLCorePose *poses = _batchPoses.mutableBytes;
+    BOOL *visible = _batchVisible.mutableBytes;
+    TLCoreRect bounds = TLCoreRectFromCGRect(self.collectionView.bounds);
+    for (NSUInteger element = 0; element < count; element++) {
+        TLCorePose pose = poses[element];
+        TLCoreRect frame = {{pose.center.x - pose.size.width / 2, pose.center.y - pose.size.height / 2}, pose.size};
+        visible[element] = TLCoreRectGetMinX(frame) < TLCoreRectGetMaxX(bounds) && TLCoreRectGetMaxX(frame) > TLCoreRectGetMinX(bounds)
+                && TLCoreRectGetMinY(frame) < TLCoreRectGetMaxY(bounds) && TLCoreRectGetMaxY(frame) > TLCoreRectGetMinY(bounds);
+    }
+    self.updatePoses(poses, _batchFromPoses.bytes, _batchToPoses.bytes, visible, count, self.transitionProgress);
+    NSUInteger element = 0;
+    for (UICollectionViewLayoutAttributes *pose in attributes) {
+        TLCoreApplyPoseToLayoutAttributes(poses[element++], pose);
+    }
+}
+
+- (NSIndexPath *)indexPathForElement:(NSUInteger)element kind:(NSString * __autoreleasing *)kind
+{
+    if (kind) {
+        *kind = nil;
+    }
+    NSUInteger numberOfSections = _sectionStarts.length / sizeof(NSUInteger);
+    if (numberOfSections-- == 0) {
+        return nil;
+    }
+    const NSUInteger *starts = _sectionStarts.bytes;
+    NSUInteger kindCount = self.supplementaryKinds.count;
+    // binary search for the last section starting at or before the element
+    NSUInteger low = 0;
+    NSUInteger high = numberOfSections;
+    while (low < high) {
+        NSUInteger mid = (low + high) / 2;
+        if (starts[mid + 1] + (mid + 1) * kindCount <= element) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == numberOfSections) {
+        return nil;
+    }
+    NSUInteger offset = element - starts[low] - low * kindCount;
+    NSUInteger numberOfItems = starts[low + 1] - starts[low];
+    if (offset < numberOfItems) {
+        return [NSIndexPath indexPathForItem:offset inSection:low];
+    }
+    if (kind) {
+        *kind = [self.supplementaryKinds objectAtIndex:offset - numberOfItems];
+    }
+    return [NSIndexPath indexPathForItem:0 inSection:low];
 }
 
 - (NSArray *)layoutAttributesForElementsInRect:(CGRect)rect
 {
+    BOOL metricsEnabled = self.metricsSink.record != NULL;
+    uint64_t start = metricsEnabled ? TLCoreMetricsNow() : 0;
     NSMutableArray *poses = [NSMutableArray array];
     for (NSInteger section = 0; section < [self.collectionView numberOfSections]; section++) {
         // cells
         for (NSInteger item = 0; item < [self.collectionView numberOfItemsInSection:section]; item++) {
-            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
-            UICollectionViewLayoutAttributes *pose = [self.poses objectForKey:indexPath];
+            UICollectionViewLayoutAttributes *pose = [self itemPoseInSlot:TLItemSlot(_sectionStarts, section, item)];
             CGRect intersection = CGRectIntersection(rect, pose.frame);
             if (!CGRectIsEmpty(intersection)) {
                 [poses addObject:pose];
@@ -198,29 +392,183 @@
         for (NSString *kind in self.supplementaryKinds) {
             NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:section];
             id key = [self keyForIndexPath:indexPath kind:kind];
-            UICollectionViewLayoutAttributes *pose = [self.poses objectForKey:key];
+            UICollectionViewLayoutAttributes *pose = [self.supplementaryPoses objectForKey:key];
             CGRect intersection = CGRectIntersection(rect, pose.frame);
             if (!CGRectIsEmpty(intersection)) {
                 [poses addObject:pose];
             }
         }
     }
+    if (metricsEnabled) {
+        TLCoreFrameMetrics *metrics = [self frameMetrics];
+        metrics->rectQueries++;
+        metrics->elementsReturned += (uint32_t)poses.count;
+        metrics->rectQueryNanoseconds += TLCoreMetricsNow() - start;
+    }
     return poses;
 }
 
 - (UICollectionViewLayoutAttributes *)layoutAttributesForItemAtIndexPath:(NSIndexPath *)indexPath
 {
-    id key = [self keyForIndexPath:indexPath];
-    return [self.poses objectForKey:key];
+    return [self itemPoseInSlot:TLItemSlot(_sectionStarts, indexPath.section, indexPath.item)];
 }
 
 - (UICollectionViewLayoutAttributes *)layoutAttributesForSupplementaryViewOfKind:(NSString *)kind atIndexPath:(NSIndexPath *)indexPath
 {
     id key = [self keyForIndexPath:indexPath kind:kind];
-    UICollectionViewLayoutAttributes *pose = [self.poses objectForKey:key];
+    UICollectionViewLayoutAttributes *pose = [self.supplementaryPoses objectForKey:key];
     return pose;
 }
 
+#pragma mark - Endpoint snapshots
+
+/*
+ Determines which endpoint snapshots apply to the current contents of the collection
+ view. On the first pass, starts capturing the endpoints that have none if requested.
+ */
+- (void)prepareEndpointSnapshots
+{
+    TLLayoutSnapshot *snapshots[2] = {self.currentLayoutSnapshot, self.nextLayoutSnapshot};
+    for (NSUInteger endpoint = TLTransitionEndpointCurrent; endpoint <= TLTransitionEndpointNext; endpoint++) {
+        TLLayoutSnapshot *snapshot = snapshots[endpoint];
+        BOOL usable = [snapshot matchesCollectionView:self.collectionView supplementaryKinds:self.supplementaryKinds];
+        _endpointSnapshots[endpoint] = usable ? snapshot.coreSnapshot : NULL;
+        if (!usable && !self.itemPoses && self.capturesLayoutSnapshots) {
+            TLCorePose *poses = NULL;
+            _capturedSnapshotData[endpoint] = [TLLayoutSnapshot dataForCollectionView:self.collectionView
+                                                                   supplementaryKinds:self.supplementaryKinds
+                                                                                poses:&poses];
+            _capturedPoses[endpoint] = poses;
+        }
+    }
+}
+
+/*
+ Every element of both endpoints is read on the first pass, so captured snapshots
+ are complete at the end of it.
+ */
+- (void)finishCapturingEndpointSnapshots
+{
+    if (_capturedSnapshotData[TLTransitionEndpointCurrent]) {
+        _currentLayoutSnapshot = [[TLLayoutSnapshot alloc] initWithData:_capturedSnapshotData[TLTransitionEndpointCurrent]];
+    }
+    if (_capturedSnapshotData[TLTransitionEndpointNext]) {
+        _nextLayoutSnapshot = [[TLLayoutSnapshot alloc] initWithData:_capturedSnapshotData[TLTransitionEndpointNext]];
+    }
+    for (NSUInteger endpoint = TLTransitionEndpointCurrent; endpoint <= TLTransitionEndpointNext; endpoint++) {
+        _capturedSnapshotData[endpoint] = nil;
+        _capturedPoses[endpoint] = NULL;
+    }
+}
+
+/*
+ Returns the pose of an element in one of the endpoint layouts, read from the endpoint's
+ snapshot when there is a usable one. `kind` is nil for cells.
+ */
+- (TLCorePose)poseInEndpoint:(TLTransitionEndpoint)endpoint element:(NSUInteger)element indexPath:(NSIndexPath *)indexPath kind:(NSString *)kind
+{
+    if (_endpointSnapshots[endpoint]) {
+        return _endpointSnapshots[endpoint]->poses[element];
+    }
+    UICollectionViewLayout *layout = endpoint == TLTransitionEndpointCurrent ? self.currentLayout : self.nextLayout;
+    UICollectionViewLayoutAttributes *attributes = kind
+            ? [layout layoutAttributesForSupplementaryViewOfKind:kind atIndexPath:indexPath]
+            : [layout layoutAttributesForItemAtIndexPath:indexPath];
+    TLCorePose pose = TLCorePoseFromLayoutAttributes(attributes);
+    if (_capturedPoses[endpoint]) {
+        _capturedPoses[endpoint][element] = pose;
+    }
+    return pose;
+}
+
+#pragma mark - Pose storage
+
+/*
+ Cell poses are stored densely in `itemPoses`, one slot per cell in section order,
+ so that looking one up is an array index rather than a hash of a normalized index
+ path. With `identifierForItemAtIndexPath`, the slots are renumbered whenever the
+ item counts change or after batch updates, and each in-flight pose is moved to
+ the new slot of the cell with its identifier. Cells without an identifier, and
+ cells repeating one already seen in the pass, keep the pose at their index path.
+ */
+- (void)updateItemSlots
+{
+    NSInteger numberOfSections = [self.collectionView numberOfSections];
+    NSMutableData *sectionStarts = [NSMutableData dataWithLength:(numberOfSections + 1) * sizeof(NSUInteger)];
+    NSUInteger *starts = sectionStarts.mutableBytes;
+    for (NSInteger section = 0; section < numberOfSections; section++) {
+        starts[section + 1] = starts[section] + [self.collectionView numberOfItemsInSection:section];
+    }
+    NSData *oldSectionStarts = _sectionStarts;
+    BOOL countsChanged = ![sectionStarts isEqualToData:oldSectionStarts];
+    _sectionStarts = sectionStarts;
+    NSUInteger numberOfItems = starts[numberOfSections];
+
+    BOOL stale = _itemSlotsStale || countsChanged;
+    _itemSlotsStale = NO;
+    if (!self.identifierForItemAtIndexPath) {
+        self.slotsByIdentifier = nil;
+        return;
+    }
+    if (self.slotsByIdentifier && !stale) {
+        return;
+    }
+    NSDictionary *oldSlotsByIdentifier = self.slotsByIdentifier;
+    NSArray *oldItemPoses = self.itemPoses;
+    NSMutableArray *itemPoses = oldItemPoses ? [self emptyItemPoses] : nil;
+    NSMutableIndexSet *movedSlots = [NSMutableIndexSet indexSet];
+    NSMutableArray *unidentifiedIndexPaths = [NSMutableArray array];
+    self.slotsByIdentifier = [NSMutableDictionary dictionaryWithCapacity:numberOfItems];
+    for (NSInteger section = 0; section < numberOfSections; section++) {
+        for (NSInteger item = 0; starts[section] + item < starts[section + 1]; item++) {
+            NSUInteger slot = starts[section] + item;
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
+            id identifier = self.identifierForItemAtIndexPath(indexPath);
+            if (!identifier || [self.slotsByIdentifier objectForKey:identifier]) {
+                [unidentifiedIndexPaths addObject:indexPath];
+                continue;
+            }
+            [self.slotsByIdentifier setObject:@(slot) forKey:identifier];
+            NSNumber *oldSlot = [oldSlotsByIdentifier objectForKey:identifier];
+            if (oldSlot && [oldSlot unsignedIntegerValue] < oldItemPoses.count) {
+                [itemPoses replaceObjectAtIndex:slot withObject:[oldItemPoses objectAtIndex:[oldSlot unsignedIntegerValue]]];
+                [movedSlots addIndex:[oldSlot unsignedIntegerValue]];
+            }
+        }
+    }
+    // cells matched by index path only take poses no identified cell claimed
+    if (itemPoses) {
+        for (NSIndexPath *indexPath in unidentifiedIndexPaths) {
+            NSUInteger oldSlot = TLItemSlot(oldSectionStarts, indexPath.section, indexPath.item);
+            if (oldSlot < oldItemPoses.count && ![movedSlots containsIndex:oldSlot]) {
+                NSUInteger slot = starts[indexPath.section] + indexPath.item;
+                [itemPoses replaceObjectAtIndex:slot withObject:[oldItemPoses objectAtIndex:oldSlot]];
+            }
+        }
+        self.itemPoses = itemPoses;
+    }
+}
+
+- (NSMutableArray *)emptyItemPoses
+{
+    NSUInteger numberOfItems = ((const NSUInteger *)_sectionStarts.bytes)[_sectionStarts.length / sizeof(NSUInteger) - 1];
+    NSMutableArray *itemPoses = [NSMutableArray arrayWithCapacity:numberOfItems];
+    NSNull *empty = [NSNull null];
+    for (NSUInteger slot = 0; slot < numberOfItems; slot++) {
+        [itemPoses addObject:empty];
+    }
+    return itemPoses;
+}
+
+- (UICollectionViewLayoutAttributes *)itemPoseInSlot:(NSUInteger)slot
+{
+    if (slot >= self.itemPoses.count) {
+        return nil;
+    }
+    id pose = [self.itemPoses objectAtIndex:slot];
+    return pose == [NSNull null] ? nil : pose;
+}
+
 /*
  Must generate a key for index path because `[NSIndexPath isEqual] is not reliable
  under iOS7 (I think because `UITableView` sometimes uses `NSIndexPath` and other times `UIMutableIndexPath`
@@ -244,15 +592,262 @@
     self.toContentOffsetInitialized = YES;
     if (!CGPointEqualToPoint(_toContentOffset, toContentOffset)) {
         _toContentOffset = toContentOffset;
+        if (_trace) {
+            TLCoreTraceAppendEvent(_trace, TLCoreTraceEventRetarget, [self traceTimestamp],
+                                   toContentOffset.x, toContentOffset.y);
+        }
         [self invalidateLayout];
     }
 }
 
+#pragma mark - Batch updates
+
+- (void)invalidateLayoutWithContext:(UICollectionViewLayoutInvalidationContext *)context
+{
+    // batch updates invalidate the data source counts without invalidating everything;
+    // `reloadData` does both and isn't followed by `prepareForCollectionViewUpdates:`
+    if (context.invalidateDataSourceCounts && !context.invalidateEverything && self.itemPoses) {
+        _awaitingCollectionViewUpdates = YES;
+    }
+    [super invalidateLayoutWithContext:context];
+}
+
+/*
+ Remaps the in-flight poses to the updated index paths so that a batch update applied
+ mid-transition continues from where elements are rather than restarting from the
+ current layout. Deleted elements fade out from their in-flight pose and inserted
+ elements fade in over the remainder of the transition (see `appearingPoseForElement:indexPath:kind:`).
+ */
+- (void)prepareForCollectionViewUpdates:(NSArray *)updateItems
+{
+    [super prepareForCollectionViewUpdates:updateItems];
+    _awaitingCollectionViewUpdates = NO;
+
+    if (!self.itemPoses || self.cancelledInPlace) {
+        return;
+    }
+
+    // a trace's element set is fixed, so recording ends at the first batch update
+    [self finishTrace];
+
+    // the endpoint layouts need to pick up the updated data on the next layout pass
+    // and snapshots of the old data no longer apply
+    [self.currentLayout invalidateLayout];
+    [self.nextLayout invalidateLayout];
+    self.currentLayoutSnapshot = nil;
+    self.nextLayoutSnapshot = nil;
+
+    // the slot table and poses still describe the data before the update (see
+    // `invalidateLayoutWithContext:`) until they are replaced below
+    NSInteger numberOfSections = [self.collectionView numberOfSections];
+    NSData *oldSectionStarts = _sectionStarts;
+    NSArray *oldItemPoses = self.itemPoses;
+    NSInteger oldNumberOfSections = (NSInteger)(oldSectionStarts.length / sizeof(NSUInteger)) - 1;
+    const NSUInteger *oldStarts = oldSectionStarts.bytes;
+
+    NSMutableData *updates = [NSMutableData dataWithLength:updateItems.count * sizeof(TLCoreUpdate)];
+    NSUInteger updateCount = 0;
+    for (UICollectionViewUpdateItem *updateItem in updateItems) {
+        NSIndexPath *before = updateItem.indexPathBeforeUpdate;
+        NSIndexPath *after = updateItem.indexPathAfterUpdate;
+        TLCoreUpdate update;
+        switch (updateItem.updateAction) {
+            case UICollectionUpdateActionDelete:
+                update.action = TLCoreUpdateActionDelete;
+                break;
+            case UICollectionUpdateActionInsert:
+                update.action = TLCoreUpdateActionInsert;
+                break;
+            case UICollectionUpdateActionMove:
+                update.action = TLCoreUpdateActionMove;
+                break;
+            default:
+                // reloaded elements keep their index paths and in-flight poses
+                continue;
+        }
+        update.before = TLCoreIndexPathFromIndexPath(before);
+        update.after = TLCoreIndexPathFromIndexPath(after);
+        ((TLCoreUpdate *)updates.mutableBytes)[updateCount++] = update;
+    }
+    NSMutableData *oldItemCounts = [NSMutableData dataWithLength:MAX(0, oldNumberOfSections) * sizeof(long)];
+    for (NSInteger section = 0; section < oldNumberOfSections; section++) {
+        ((long *)oldItemCounts.mutableBytes)[section] = (long)(oldStarts[section + 1] - oldStarts[section]);
+    }
+    NSUInteger oldNumberOfItems = oldNumberOfSections > 0 ? oldStarts[oldNumberOfSections] : 0;
+    NSMutableData *newSections = [NSMutableData dataWithLength:MAX(0, oldNumberOfSections) * sizeof(long)];
+    NSMutableData *newIndexPaths = [NSMutableData dataWithLength:oldNumberOfItems * sizeof(TLCoreIndexPath)];
+    if (!TLCoreRemapIndexPaths(oldItemCounts.bytes, oldNumberOfSections, updates.bytes, updateCount,
+                               newSections.mutableBytes, newIndexPaths.mutableBytes)) {
+        // start the remaining transition from the current layout instead
+        self.itemPoses = nil;
+        self.supplementaryPoses = nil;
+        return;
+    }
+
+    // with identifiers, this also moves each in-flight pose to its cell's new slot
+    _itemSlotsStale = YES;
+    [self updateItemSlots];
+
+    NSMutableArray *itemPoses = [self emptyItemPoses];
+    NSMutableDictionary *supplementaryPoses = [NSMutableDictionary dictionaryWithCapacity:self.supplementaryPoses.count];
+    NSMutableDictionary *disappearingPoses = [NSMutableDictionary dictionary];
+    NSMutableSet *retainedKeys = [NSMutableSet set];
+    void (^retainItemPose)(UICollectionViewLayoutAttributes *, NSIndexPath *) = ^(UICollectionViewLayoutAttributes *pose, NSIndexPath *indexPath) {
+        NSUInteger slot = TLItemSlot(_sectionStarts, indexPath.section, indexPath.item);
+        if (slot == NSNotFound) {
+            return;
+        }
+        UICollectionViewLayoutAttributes *remappedPose = [pose copy];
+        remappedPose.indexPath = indexPath;
+        [itemPoses replaceObjectAtIndex:slot withObject:remappedPose];
+        [retainedKeys addObject:indexPath];
+    };
+
+    // with identifiers, cells are matched by identity: a cell keeps its in-flight
+    // pose wherever the update moved it
+    BOOL matchByIdentifier = self.identifierForItemAtIndexPath != nil;
+    NSHashTable *matchedPoses = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    if (matchByIdentifier) {
+        for (NSInteger section = 0; section < numberOfSections; section++) {
+            for (NSInteger item = 0; item < [self.collectionView numberOfItemsInSection:section]; item++) {
+                NSUInteger slot = TLItemSlot(_sectionStarts, section, item);
+                UICollectionViewLayoutAttributes *pose = [self itemPoseInSlot:slot];
+                if (pose) {
+                    retainItemPose(pose, [NSIndexPath indexPathForItem:item inSection:section]);
+                    [matchedPoses addObject:pose];
+                }
+            }
+        }
+    }
+
+    // otherwise, cells follow their remapped index paths
+    const long *remappedSections = newSections.bytes;
+    const TLCoreIndexPath *remappedIndexPaths = newIndexPaths.bytes;
+    for (NSInteger section = 0; section < oldNumberOfSections; section++) {
+        // cells
+        for (NSInteger item = 0; oldStarts[section] + item < oldStarts[section + 1]; item++) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
+            NSUInteger oldSlot = TLItemSlot(oldSectionStarts, section, item);
+            id pose = oldSlot < oldItemPoses.count ? [oldItemPoses objectAtIndex:oldSlot] : nil;
+            if (!pose || pose == [NSNull null]) {
+                continue;
+            }
+            if (matchByIdentifier) {
+                if (![matchedPoses containsObject:pose]) {
+                    [disappearingPoses setObject:pose forKey:indexPath];
+                }
+                continue;
+            }
+            TLCoreIndexPath newIndexPath = remappedIndexPaths[oldStarts[section] + item];
+            if (newIndexPath.section != TLCoreNotFound) {
+                retainItemPose(pose, [NSIndexPath indexPathForItem:newIndexPath.item inSection:newIndexPath.section]);
+            } else {
+                [disappearingPoses setObject:pose forKey:indexPath];
+            }
+        }
+        // supplementary views
+        NSInteger newSection = remappedSections[section];
+        for (NSString *kind in self.supplementaryKinds) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:section];
+            id key = [self keyForIndexPath:indexPath kind:kind];
+            UICollectionViewLayoutAttributes *pose = [self.supplementaryPoses objectForKey:key];
+            if (!pose) {
+                continue;
+            }
+            if (newSection != TLCoreNotFound) {
+                NSIndexPath *newIndexPath = [NSIndexPath indexPathForItem:0 inSection:newSection];
+                id newKey = [self keyForIndexPath:newIndexPath kind:kind];
+                UICollectionViewLayoutAttributes *remappedPose = [pose copy];
+                remappedPose.indexPath = newIndexPath;
+                [supplementaryPoses setObject:remappedPose forKey:newKey];
+                [retainedKeys addObject:newKey];
+            } else {
+                [disappearingPoses setObject:pose forKey:key];
+            }
+        }
+    }
+
+    self.itemPoses = itemPoses;
+    self.supplementaryPoses = supplementaryPoses;
+    self.retainedKeys = retainedKeys;
+    self.disappearingPoses = disappearingPoses;
+    // the remapped poses are already at the current progress, so the next pass
+    // must not apply the last progress step to them again
+    self.previousProgress = self.transitionProgress;
+}
+
+- (void)finalizeCollectionViewUpdates
+{
+    [super finalizeCollectionViewUpdates];
+    self.retainedKeys = nil;
+    self.disappearingPoses = nil;
+}
+
+- (UICollectionViewLayoutAttributes *)initialLayoutAttributesForAppearingItemAtIndexPath:(NSIndexPath *)itemIndexPath
+{
+    id key = [self keyForIndexPath:itemIndexPath];
+    UICollectionViewLayoutAttributes *pose = [self layoutAttributesForItemAtIndexPath:itemIndexPath];
+    return [self transparentPose:pose forAppearingKey:key] ?: [super initialLayoutAttributesForAppearingItemAtIndexPath:itemIndexPath];
+}
+
+- (UICollectionViewLayoutAttributes *)initialLayoutAttributesForAppearingSupplementaryElementOfKind:(NSString *)elementKind atIndexPath:(NSIndexPath *)elementIndexPath
+{
+    id key = [self keyForIndexPath:elementIndexPath kind:elementKind];
+    UICollectionViewLayoutAttributes *pose = [self.supplementaryPoses objectForKey:key];
+    return [self transparentPose:pose forAppearingKey:key] ?: [super initialLayoutAttributesForAppearingSupplementaryElementOfKind:elementKind atIndexPath:elementIndexPath];
+}
+
+- (UICollectionViewLayoutAttributes *)finalLayoutAttributesForDisappearingItemAtIndexPath:(NSIndexPath *)itemIndexPath
+{
+    id key = [self keyForIndexPath:itemIndexPath];
+    UICollectionViewLayoutAttributes *pose = [[self.disappearingPoses objectForKey:key] copy];
+    pose.alpha = 0;
+    return pose ?: [super finalLayoutAttributesForDisappearingItemAtIndexPath:itemIndexPath];
+}
+
+- (UICollectionViewLayoutAttributes *)finalLayoutAttributesForDisappearingSupplementaryElementOfKind:(NSString *)elementKind atIndexPath:(NSIndexPath *)elementIndexPath
+{
+    id key = [self keyForIndexPath:elementIndexPath kind:elementKind];
+    UICollectionViewLayoutAttributes *pose = [[self.disappearingPoses objectForKey:key] copy];
+    pose.alpha = 0;
+    return pose ?: [super finalLayoutAttributesForDisappearingSupplementaryElementOfKind:elementKind atIndexPath:elementIndexPath];
+}
+
+- (UICollectionViewLayoutAttributes *)transparentPose:(UICollectionViewLayoutAttributes *)pose forAppearingKey:(id)key
+{
+    if (!self.retainedKeys || [self.retainedKeys containsObject:key]) {
+        return nil;
+    }
+    UICollectionViewLayoutAttributes *transparentPose = [pose copy];
+    transparentPose.alpha = 0;
+    return transparentPose;
+}
+
+/*
+ The starting pose for an element inserted mid-transition: where the element would be
+ at the current progress had it been there all along, but transparent, so it fades in
+ as it completes the transition with the other elements.
+ */
+- (TLCorePose)appearingPoseForElement:(NSUInteger)element indexPath:(NSIndexPath *)indexPath kind:(NSString *)kind
+{
+    TLCorePose fromPose = [self poseInEndpoint:TLTransitionEndpointCurrent element:element indexPath:indexPath kind:kind];
+    TLCorePose toPose = [self poseInEndpoint:TLTransitionEndpointNext element:element indexPath:indexPath kind:kind];
+    TLCorePose pose;
+    TLCoreInterpolatePose(&pose, &fromPose, &toPose, self.transitionProgress);
+    pose.alpha = 0;
+    return pose;
+}
+
 #pragma mark - Cancelling in place
 
 - (void)cancelInPlace
 {
     _cancelledInPlace = YES;
+    [self flushFrameMetrics];
+    if (_trace) {
+        TLCoreTraceAppendEvent(_trace, TLCoreTraceEventCancel, [self traceTimestamp], 0, 0);
+    }
+    [self finishTrace];
 }
 
 #pragma mark - TLTransitionAnimatorLayout
@@ -262,6 +857,155 @@
     if (finish && self.toContentOffsetInitialized) {
         collectionView.contentOffset = self.toContentOffset;
     }
+    [self flushFrameMetrics];
+    [self finishTrace];
+}
+
+#pragma mark - Metrics
+
+- (void)setMetricsSink:(TLCoreMetricsSink)metricsSink
+{
+    [self flushFrameMetrics];
+    _metricsSink = metricsSink;
+}
+
+/*
+ Returns the metrics for the frame in progress, starting a new frame if needed.
+ */
+- (TLCoreFrameMetrics *)frameMetrics
+{
+    if (!_frameMetricsPending) {
+        memset(&_frameMetrics, 0, sizeof(_frameMetrics));
+        _frameMetrics.frame = _frameCount++;
+        _frameMetrics.progress = self.transitionProgress;
+        _frameMetrics.time = self.transitionTime;
+        _frameMetricsPending = YES;
+    }
+    return &_frameMetrics;
+}
+
+- (void)flushFrameMetrics
+{
+    if (_frameMetricsPending) {
+        _frameMetricsPending = NO;
+        _frameMetrics.totalNanoseconds = _frameMetrics.contentOffsetNanoseconds
+                + _frameMetrics.prepareLayoutNanoseconds + _frameMetrics.rectQueryNanoseconds
+                + _frameMetrics.updateLayoutAttributesNanoseconds + _frameMetrics.progressChangedNanoseconds;
+        if (self.metricsSink.record) {
+            self.metricsSink.record(self.metricsSink.context, &_frameMetrics);
+        }
+    }
+}
+
+/*
+ Called by the `transitionToCollectionViewLayout:duration:easing:completion:` driver
+ after each progress update to attribute dropped display link frames to the frame
+ in progress.
+ */
+- (void)recordDisplayLinkTimestamp:(CFTimeInterval)timestamp duration:(CFTimeInterval)duration
+{
+    if (_trace) {
+        TLCoreTraceAppendEvent(_trace, TLCoreTraceEventDisplayLink, timestamp, duration, 0);
+    }
+    if (self.metricsSink.record == NULL) {
+        return;
+    }
+    if (_lastDisplayLinkTimestamp > 0 && duration > 0) {
+        long dropped = lround((timestamp - _lastDisplayLinkTimestamp) / duration) - 1;
+        [self frameMetrics]->droppedFrames += (uint32_t)MAX(0, dropped);
+    }
+    _lastDisplayLinkTimestamp = timestamp;
+}
+
+#pragma mark - Tracing
+
+- (void)setTracePath:(NSString *)tracePath
+{
+    _tracePath = [tracePath copy];
+    if (!tracePath) {
+        TLCoreTraceDestroy(_trace);
+        _trace = NULL;
+    } else if (!_trace) {
+        _trace = TLCoreTraceCreate();
+        _traceStartTime = 0;
+    }
+}
+
+/*
+ Event times are relative to the start of the transition, i.e. its first layout
+ pass or progress update, rather than to when `tracePath` was set.
+ */
+- (CFTimeInterval)traceTimestamp
+{
+    CFTimeInterval now = CACurrentMediaTime();
+    if (_traceStartTime == 0) {
+        _traceStartTime = now;
+    }
+    return now - _traceStartTime;
+}
+
+/*
+ Captures the endpoint poses in the same element order that `prepareLayout` visits them.
+ */
+- (void)recordTraceEndpoints
+{
+    NSInteger numberOfSections = [self.collectionView numberOfSections];
+    uint32_t count = 0;
+    for (NSInteger section = 0; section < numberOfSections; section++) {
+        count += (uint32_t)([self.collectionView numberOfItemsInSection:section] + self.supplementaryKinds.count);
+    }
+    if (!TLCoreTraceSetElementCount(_trace, count)) {
+        TLCoreTraceDestroy(_trace);
+        _trace = NULL;
+        return;
+    }
+    uint32_t i = 0;
+    for (NSInteger section = 0; section < numberOfSections; section++) {
+        for (NSInteger item = 0; item < [self.collectionView numberOfItemsInSection:section]; item++) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:item inSection:section];
+            _trace->fromPoses[i] = TLCorePoseFromLayoutAttributes([self.currentLayout layoutAttributesForItemAtIndexPath:indexPath]);
+            _trace->toPoses[i] = TLCorePoseFromLayoutAttributes([self.nextLayout layoutAttributesForItemAtIndexPath:indexPath]);
+            i++;
+        }
+        for (NSString *kind in self.supplementaryKinds) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForItem:0 inSection:section];
+            _trace->fromPoses[i] = TLCorePoseFromLayoutAttributes([self.currentLayout layoutAttributesForSupplementaryViewOfKind:kind atIndexPath:indexPath]);
+            _trace->toPoses[i] = TLCorePoseFromLayoutAttributes([self.nextLayout layoutAttributesForSupplementaryViewOfKind:kind atIndexPath:indexPath]);
+            i++;
+        }
+    }
+    _trace->viewportSize = TLCoreSizeFromCGSize(self.collectionView.bounds.size);
+    _trace->fromContentOffset = TLCorePointFromCGPoint(self.fromContentOffset);
+    // the target may have been set before recording started, in which case no
+    // retarget event was recorded for it
+    _trace->hasToContentOffset = self.toContentOffsetInitialized;
+    _trace->toContentOffset = TLCorePointFromCGPoint(self.toContentOffset);
+    if (_traceStartTime == 0) {
+        _traceStartTime = CACurrentMediaTime();
+    }
+}
+
+/*
+ Hands the trace off to a background queue for writing. Recording stops afterwards.
+ */
+- (void)finishTrace
+{
+    if (!_trace) {
+        return;
+    }
+    TLCoreTrace *trace = _trace;
+    NSString *path = self.tracePath;
+    _trace = NULL;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+        FILE *file = fopen([path fileSystemRepresentation], "wb");
+        if (!file || !TLCoreTraceWrite(trace, file)) {
+            NSLog(@"Failed to write transition trace to %@", path);
+        }
+        if (file) {
+            fclose(file);
+        }
+        TLCoreTraceDestroy(trace);
+    });
 }
 
 #pragma mark - Creating layouts
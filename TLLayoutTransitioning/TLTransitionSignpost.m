@@ -0,0 +1,66 @@
+//
+//  TLTransitionSignpost.m
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+
+#import "TLTransitionSignpost.h"
+
+#if __has_include(<os/signpost.h>)
+#import <os/signpost.h>
+
+static void TLTransitionSignpostRecord(void *context, const TLCoreFrameMetrics *metrics)
+{
+    if (@available(iOS 12.0, *)) {
+        os_log_t log = (__bridge os_log_t)context;
+        os_signpost_event_emit(log, OS_SIGNPOST_ID_EXCLUSIVE, "Transition Frame",
+                               "frame=%llu progress=%.3f elements=%u rectQueries=%u returned=%u dropped=%u "
+                               "contentOffsetNs=%llu prepareNs=%llu rectNs=%llu updateAttributesNs=%llu progressChangedNs=%llu totalNs=%llu",
+                               metrics->frame, metrics->progress, metrics->elementsInterpolated, metrics->rectQueries,
+                               metrics->elementsReturned, metrics->droppedFrames, metrics->contentOffsetNanoseconds,
+                               metrics->prepareLayoutNanoseconds, metrics->rectQueryNanoseconds,
+                               metrics->updateLayoutAttributesNanoseconds, metrics->progressChangedNanoseconds,
+                               metrics->totalNanoseconds);
+    }
+}
+
+TLCoreMetricsSink TLTransitionSignpostMetricsSink(void)
+{
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        if (@available(iOS 12.0, *)) {
+            log = os_log_create("com.tractablelabs.TLLayoutTransitioning", "Transitions");
+        }
+    });
+    TLCoreMetricsSink sink = {log ? TLTransitionSignpostRecord : NULL, (__bridge void *)log};
+    return sink;
+}
+
+#else
+
+TLCoreMetricsSink TLTransitionSignpostMetricsSink(void)
+{
+    TLCoreMetricsSink sink = {NULL, NULL};
+    return sink;
+}
+
+#endif
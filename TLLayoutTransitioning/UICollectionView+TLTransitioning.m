@@ -26,9 +26,14 @@
 
 #import "UICollectionView+TLTransitioning.h"
 #import "TLTransitionLayout.h"
+#import "TLTransitionCore+UIKit.h"
 
 CGPoint kTLPlacementAnchorDefault = (CGPoint){CGFLOAT_MAX, CGFLOAT_MAX};
 
+@interface TLTransitionLayout (TLTransitionMetricsDriver)
+- (void)recordDisplayLinkTimestamp:(CFTimeInterval)timestamp duration:(CFTimeInterval)duration;
+@end
+
 @interface TLCancelLayout : UICollectionViewLayout
 @property (nonatomic) CGPoint contentOffset;
 - (instancetype)initWithLayout:(UICollectionViewLayout *)layout;
@@ -147,6 +152,9 @@ static char kTLEasingFunctionKey;
         } else {
             [l setTransitionProgress:progress];
         }
+        if ([l respondsToSelector:@selector(recordDisplayLinkTimestamp:duration:)]) {
+            [l recordDisplayLinkTimestamp:link.timestamp duration:link.duration];
+        }
         [l invalidateLayout];
         if (time >= 1) {
             [self finishTransition:link];
@@ -203,9 +211,7 @@ static char kTLEasingFunctionKey;
 CGFloat transitionProgress(CGFloat initialValue, CGFloat currentValue,
                            CGFloat finalValue, AHEasingFunction easingFunction)
 {
-    CGFloat p = (currentValue - initialValue) / (finalValue - initialValue);
-    p = MIN(1.0, p);
-    p = MAX(0, p);
+    CGFloat p = TLCoreProgress(initialValue, currentValue, finalValue);
     return easingFunction ? easingFunction(p) : p;
 }
 
@@ -244,106 +250,18 @@ CGFloat transitionProgress(CGFloat initialValue, CGFloat currentValue,
         }
     }
     
-    CGRect placementFrame = UIEdgeInsetsInsetRect((CGRect){{0, 0}, toSize}, placementInset);
-    
-    CGPoint contentOffset = self.contentOffset;
-    
-    // location of the point we're adjusting for, in the coordinate system
-    // of the content
-    CGPoint sourcePoint;
-    
-    // location where we want the source point to end up, in the coordinate
-    // system of the collection view
-    CGPoint destinationPoint;
-
-    if (defaultPlacementAnchor) {
-        sourcePoint = CGPointMake(CGRectGetMidX(toFrame), CGRectGetMidY(toFrame));
-    } else {
-        sourcePoint = pointForAnchorPoint(placementAnchor, toFrame);
-    }
-
-    switch (placement) {
-        case TLTransitionLayoutIndexPathPlacementMinimal:
-            if (defaultPlacementAnchor) {
-                destinationPoint = CGPointMake(CGRectGetMidX(fromFrame), CGRectGetMidY(fromFrame));
-            } else {
-                destinationPoint = pointForAnchorPoint(placementAnchor, fromFrame);
-            }
-            destinationPoint.x -= contentOffset.x;
-            destinationPoint.y -= contentOffset.y;
-            break;
-        case TLTransitionLayoutIndexPathPlacementVisible:
-        {
-            // calculate the minimal toContentOffset and the resulting
-            // frame in collection view space
-            CGPoint minimalToContentOffset = [self toContentOffsetForLayout:layout
-                                                                 indexPaths:indexPaths
-                                                                  placement:TLTransitionLayoutIndexPathPlacementMinimal
-                                                            placementAnchor:placementAnchor
-                                                             placementInset:placementInset
-                                                                     toSize:toSize
-                                                             toContentInset:toContentInset];
-            CGRect translatedToFrameUnion = toFrame;
-            translatedToFrameUnion.origin.x -= minimalToContentOffset.x;
-            translatedToFrameUnion.origin.y -= minimalToContentOffset.y;
-            // now calculate the minimal offset that maximizes this frame's visibility
-            CGPoint maximalIntersectionOffset =
-                    minimalOffsetForMaximalIntersection(placementFrame, translatedToFrameUnion);
-            minimalToContentOffset.x -= maximalIntersectionOffset.x;
-            minimalToContentOffset.y -= maximalIntersectionOffset.y;
-            return minimalToContentOffset;
-        }
-        case TLTransitionLayoutIndexPathPlacementCenter:
-            destinationPoint = CGPointMake(CGRectGetMidX(placementFrame), CGRectGetMidY(placementFrame));
-            break;
-        case TLTransitionLayoutIndexPathPlacementTop:
-            if (defaultPlacementAnchor) {
-                sourcePoint = CGPointMake(CGRectGetMidX(toFrame), CGRectGetMinY(toFrame));
-            }
-            destinationPoint = CGPointMake(CGRectGetMidX(placementFrame), CGRectGetMinY(placementFrame));
-            break;
-        case TLTransitionLayoutIndexPathPlacementLeft:
-            if (defaultPlacementAnchor) {
-                sourcePoint = CGPointMake(CGRectGetMinX(toFrame), CGRectGetMidY(toFrame));
-            }
-            destinationPoint = CGPointMake(CGRectGetMinX(placementFrame), CGRectGetMidY(placementFrame));
-            break;
-        case TLTransitionLayoutIndexPathPlacementBottom:
-            if (defaultPlacementAnchor) {
-                sourcePoint = CGPointMake(CGRectGetMidX(toFrame), CGRectGetMaxY(toFrame));
-            }
-            destinationPoint = CGPointMake(CGRectGetMidX(placementFrame), CGRectGetMaxY(placementFrame));
-            break;
-        case TLTransitionLayoutIndexPathPlacementRight:
-            if (defaultPlacementAnchor) {
-                sourcePoint = CGPointMake(CGRectGetMaxX(toFrame), CGRectGetMidY(toFrame));
-            }
-            destinationPoint = CGPointMake(CGRectGetMaxX(placementFrame), CGRectGetMidY(placementFrame));
-            break;
-        default:
-            destinationPoint = CGPointZero;
-            break;
-    }
-    
-    CGSize contentSize = layout.nextLayout.collectionViewContentSize;
-    
-    CGPoint offset = CGPointMake(sourcePoint.x - destinationPoint.x, sourcePoint.y - destinationPoint.y);
-    
-    CGFloat minOffsetX = -toContentInset.left;
-    CGFloat minOffsetY = -toContentInset.top;
-    
-    CGFloat maxOffsetX = toContentInset.right + contentSize.width - placementFrame.size.width;
-    CGFloat maxOffsetY = toContentInset.bottom + contentSize.height - placementFrame.size.height;
-    maxOffsetX = MAX(minOffsetX, maxOffsetX);
-    maxOffsetY = MAX(minOffsetY, maxOffsetY);
-    
-    offset.x = MAX(minOffsetX, offset.x);
-    offset.y = MAX(minOffsetY, offset.y);
-    
-    offset.x = MIN(maxOffsetX, offset.x);
-    offset.y = MIN(maxOffsetY, offset.y);
-    
-    return offset;
+    TLCorePlacementContext context;
+    context.placement = (TLCorePlacement)placement;
+    context.defaultPlacementAnchor = defaultPlacementAnchor;
+    context.placementAnchor = TLCorePointFromCGPoint(placementAnchor);
+    context.placementInset = TLCoreInsetsFromUIEdgeInsets(placementInset);
+    context.toSize = TLCoreSizeFromCGSize(toSize);
+    context.toContentInset = TLCoreInsetsFromUIEdgeInsets(toContentInset);
+    context.toContentSize = TLCoreSizeFromCGSize(layout.nextLayout.collectionViewContentSize);
+    context.contentOffset = TLCorePointFromCGPoint(self.contentOffset);
+    context.fromFrame = TLCoreRectFromCGRect(fromFrame);
+    context.toFrame = TLCoreRectFromCGRect(toFrame);
+    return CGPointFromTLCorePoint(TLCoreContentOffsetForPlacement(&context));
 }
 
 - (CGPoint)toContentOffsetForLayout:(UICollectionViewTransitionLayout *)layout
@@ -367,80 +285,37 @@ CGFloat transitionProgress(CGFloat initialValue, CGFloat currentValue,
 
 CGRect TLTransitionFrame(CGRect fromFrame, CGRect toFrame, CGFloat progress)
 {
-    CGFloat t = progress;
-    CGFloat f = 1 - t;
-    CGRect frame;
-    frame.origin.x = t * toFrame.origin.x + f * fromFrame.origin.x;
-    frame.origin.y = t * toFrame.origin.y + f * fromFrame.origin.y;
-    frame.size.width = t * toFrame.size.width + f * fromFrame.size.width;
-    frame.size.height = t * toFrame.size.height + f * fromFrame.size.height;
-    return frame;
+    return CGRectFromTLCoreRect(TLCoreInterpolateRect(TLCoreRectFromCGRect(fromFrame), TLCoreRectFromCGRect(toFrame), progress));
 }
 
 CGPoint TLTransitionPoint(CGPoint fromPoint, CGPoint toPoint, CGFloat progress)
 {
-    CGFloat t = progress;
-    CGFloat f = 1 - t;
-    CGPoint point;
-    point.x = t * toPoint.x + f * fromPoint.x;
-    point.y = t * toPoint.y + f * fromPoint.y;
-    return point;
+    return CGPointFromTLCorePoint(TLCoreInterpolatePoint(TLCorePointFromCGPoint(fromPoint), TLCorePointFromCGPoint(toPoint), progress));
 }
 
 CGSize TLTransitionSize(CGSize fromSize, CGSize toSize, CGFloat progress)
 {
-    CGFloat t = progress;
-    CGFloat f = 1 - t;
-    CGSize size;
-    size.width = t * toSize.width + f * fromSize.width;
-    size.height = t * toSize.height + f * fromSize.height;
-    return size;
+    return CGSizeFromTLCoreSize(TLCoreInterpolateSize(TLCoreSizeFromCGSize(fromSize), TLCoreSizeFromCGSize(toSize), progress));
 }
 
 CGFloat TLTransitionFloat(CGFloat fromFloat, CGFloat toFloat, CGFloat progress)
 {
-    CGFloat t = progress;
-    CGFloat f = 1 - t;
-    return t * toFloat + f * fromFloat;
+    return TLCoreInterpolateFloat(fromFloat, toFloat, progress);
 }
 
 UIEdgeInsets TLTransitionInset(UIEdgeInsets fromInset, UIEdgeInsets toInset, CGFloat progress)
 {
-    CGFloat top = TLTransitionFloat(fromInset.top, toInset.top, progress);
-    CGFloat left = TLTransitionFloat(fromInset.left, toInset.left, progress);
-    CGFloat bottom = TLTransitionFloat(fromInset.bottom, toInset.bottom, progress);
-    CGFloat right = TLTransitionFloat(fromInset.right, toInset.right, progress);
-    return UIEdgeInsetsMake(top, left, bottom, right);
+    return UIEdgeInsetsFromTLCoreInsets(TLCoreInterpolateInsets(TLCoreInsetsFromUIEdgeInsets(fromInset), TLCoreInsetsFromUIEdgeInsets(toInset), progress));
 }
 
 CGFloat TLConvertTimespace(CGFloat time, CGFloat startTime, CGFloat endTime)
 {
-    // sanitize input
-    time = MAX(0, MIN(1, time));
-    startTime = MAX(0, MIN(1, startTime));
-    endTime = MAX(0, MIN(1, endTime));
-    if (endTime <= startTime) {
-        return 1;
-    }
-    if (time <= startTime) {
-        return 0;
-    }
-    if (time >= endTime) {
-        return 1;
-    }
-    // calculate time in the converted timespace
-    return (time - startTime) / (endTime - startTime);
+    return TLCoreConvertTimespace(time, startTime, endTime);
 }
 
 extern CGPoint TLRelativePointInRect(CGPoint point, CGRect rect)
 {
-    CGPoint origin = rect.origin;
-    CGPoint relativePoint = CGPointMake(point.x - origin.x, point.y - origin.y);
-    CGFloat width = CGRectGetWidth(rect);
-    CGFloat height = CGRectGetHeight(rect);
-    relativePoint.x = width == 0 ? 0 : relativePoint.x / width;
-    relativePoint.y = height == 0 ? 0 : relativePoint.y / height;
-    return relativePoint;
+    return CGPointFromTLCorePoint(TLCoreRelativePointInRect(TLCorePointFromCGPoint(point), TLCoreRectFromCGRect(rect)));
 }
 
 CGPoint addPoints(CGPoint point, CGPoint otherPoint)
@@ -461,37 +336,6 @@ CGAffineTransform translationToCollectionViewSpace(CGPoint contentOffset)
     return CGAffineTransformMakeTranslation(- contentOffset.x, - contentOffset.y);
 }
 
-CGPoint pointForAnchorPoint(CGPoint anchorPoint, CGRect frame)
-{
-    CGFloat pointX = (1.f - anchorPoint.x) * CGRectGetMinX(frame) + anchorPoint.x * CGRectGetMaxX(frame);
-    CGFloat pointY = (1.f - anchorPoint.y) * CGRectGetMinY(frame) + anchorPoint.y * CGRectGetMaxY(frame);
-    return CGPointMake(pointX, pointY);
-}
-
-CGPoint minimalOffsetForMaximalIntersection(CGRect parentFrame, CGRect childFrame)
-{
-    CGFloat topSpace = CGRectGetMinY(childFrame) - CGRectGetMinY(parentFrame);
-    CGFloat leftSpace = CGRectGetMinX(childFrame) - CGRectGetMinX(parentFrame);
-    CGFloat bottomSpace = CGRectGetMaxY(parentFrame) - CGRectGetMaxY(childFrame);
-    CGFloat rightSpace = CGRectGetMaxX(parentFrame) - CGRectGetMaxX(childFrame);
-    return CGPointMake(linearOffset(leftSpace, rightSpace), linearOffset(topSpace, bottomSpace));
-}
-
-CGFloat linearOffset(CGFloat spaceBeforeChild, CGFloat spaceAfterChild)
-{
-    // if both before and after space have the same sign, then there is no offset.
-    // If they're both negative, an offset will not improve anything. If they are
-    // both positive, no offset is needed.
-    if (spaceBeforeChild * spaceAfterChild >= 0) {
-        return 0;
-    }
-    if (spaceBeforeChild < 0) {
-        return MIN(spaceAfterChild, -spaceBeforeChild);
-    } else {
-        return MAX(spaceAfterChild, -spaceBeforeChild);
-    }
-}
-
 @end
 
 #pragma mark - TLCancelLayout implementation
@@ -0,0 +1,526 @@
+//
+//  TLTransitionCoreTests.c
+//  Tests
+//
+//  Copyright (c) 2013 Tim Moose (http://tractablelabs.com)
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+// Unit tests for the portable transition core. Run with `ctest` or directly;
+// exits non-zero if any check fails.
+
+#include "TLTransitionCore.h"
+#include "TLTransitionSnapshot.h"
+#include "TLTransitionTrace.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failureCount;
+
+#define TLCheck(condition) \
+    TLCheckImpl((condition), #condition, __FILE__, __LINE__)
+
+#define TLCheckFloat(actual, expected) \
+    TLCheckFloatImpl((actual), (expected), #actual, __FILE__, __LINE__)
+
+#define TLCheckPoint(actual, expectedX, expectedY) \
+    do { \
+        TLCorePoint point_ = (actual); \
+        TLCheckFloatImpl(point_.x, (expectedX), #actual ".x", __FILE__, __LINE__); \
+        TLCheckFloatImpl(point_.y, (expectedY), #actual ".y", __FILE__, __LINE__); \
+    } while (0)
+
+static void TLCheckImpl(bool condition, const char *expression, const char *file, int line)
+{
+    if (!condition) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+        failureCount++;
+    }
+}
+
+static void TLCheckFloatImpl(double actual, double expected, const char *expression, const char *file, int line)
+{
+    if (fabs(actual - expected) > 1e-9) {
+        fprintf(stderr, "%s:%d: %s is %.12g, expected %.12g\n", file, line, expression, actual, expected);
+        failureCount++;
+    }
+}
+
+static TLCorePose TLTestPose(double x, double y, double width, double height, double alpha)
+{
+    TLCorePose pose;
+    memset(&pose, 0, sizeof(pose));
+    pose.center = (TLCorePoint){x, y};
+    pose.size = (TLCoreSize){width, height};
+    pose.alpha = alpha;
+    pose.transform = (TLCoreAffineTransform){1, 0, 0, 1, 0, 0};
+    pose.transform3D.m11 = pose.transform3D.m22 = pose.transform3D.m33 = pose.transform3D.m44 = 1;
+    return pose;
+}
+
+static bool TLTestPosesEqual(const TLCorePose *pose, const TLCorePose *otherPose)
+{
+    const double *a = (const double *)pose;
+    const double *b = (const double *)otherPose;
+    for (size_t i = 0; i < sizeof(TLCorePose) / sizeof(double); i++) {
+        if (fabs(a[i] - b[i]) > 1e-9) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Placement
+
+static TLCorePlacementContext TLTestPlacementContext(TLCorePlacement placement)
+{
+    TLCorePlacementContext context;
+    memset(&context, 0, sizeof(context));
+    context.placement = placement;
+    context.defaultPlacementAnchor = true;
+    context.toSize = (TLCoreSize){100, 100};
+    context.toContentSize = (TLCoreSize){1000, 1000};
+    context.contentOffset = (TLCorePoint){50, 50};
+    context.fromFrame = (TLCoreRect){{130, 130}, {20, 20}};
+    context.toFrame = (TLCoreRect){{300, 400}, {40, 40}};
+    return context;
+}
+
+static TLCorePoint TLTestContentOffset(TLCorePlacement placement)
+{
+    TLCorePlacementContext context = TLTestPlacementContext(placement);
+    return TLCoreContentOffsetForPlacement(&context);
+}
+
+static void TLTestPlacements(void)
+{
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementNone), 320, 420);
+    // keeps the frame's midpoint where it was on screen
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementMinimal), 230, 330);
+    // the minimal offset would leave the frame 10 points past the bottom right
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementVisible), 240, 340);
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementCenter), 270, 370);
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementTop), 270, 400);
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementLeft), 300, 370);
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementBottom), 270, 340);
+    TLCheckPoint(TLTestContentOffset(TLCorePlacementRight), 240, 370);
+
+    // custom anchors replace the placement's default edge
+    TLCorePlacementContext context = TLTestPlacementContext(TLCorePlacementCenter);
+    context.defaultPlacementAnchor = false;
+    context.placementAnchor = (TLCorePoint){0, 0};
+    TLCheckPoint(TLCoreContentOffsetForPlacement(&context), 250, 350);
+    context.placement = TLCorePlacementTop;
+    context.placementAnchor = (TLCorePoint){1, 1};
+    TLCheckPoint(TLCoreContentOffsetForPlacement(&context), 290, 440);
+
+    // placement insets shrink the frame that is placed into
+    context = TLTestPlacementContext(TLCorePlacementTop);
+    context.placementInset = (TLCoreInsets){20, 0, 0, 0};
+    TLCheckPoint(TLCoreContentOffsetForPlacement(&context), 270, 380);
+
+    // offsets are clamped to the content size and insets
+    context = TLTestPlacementContext(TLCorePlacementCenter);
+    context.toContentSize = (TLCoreSize){200, 200};
+    TLCheckPoint(TLCoreContentOffsetForPlacement(&context), 100, 100);
+    context.toContentInset = (TLCoreInsets){0, 0, 10, 30};
+    TLCheckPoint(TLCoreContentOffsetForPlacement(&context), 130, 110);
+    context = TLTestPlacementContext(TLCorePlacementCenter);
+    context.toFrame = (TLCoreRect){{0, 0}, {20, 20}};
+    context.toContentInset = (TLCoreInsets){10, 5, 0, 0};
+    TLCheckPoint(TLCoreContentOffsetForPlacement(&context), -5, -10);
+
+    TLCheckFloat(TLCoreLinearOffset(10, 20), 0);
+    TLCheckFloat(TLCoreLinearOffset(-10, -20), 0);
+    TLCheckFloat(TLCoreLinearOffset(-10, 20), 10);
+    TLCheckFloat(TLCoreLinearOffset(-30, 20), 20);
+    TLCheckFloat(TLCoreLinearOffset(10, -20), -10);
+    TLCheckPoint(TLCoreRelativePointInRect((TLCorePoint){15, 30}, (TLCoreRect){{10, 10}, {10, 40}}), 0.5, 0.5);
+    TLCheckPoint(TLCoreRelativePointInRect((TLCorePoint){15, 30}, (TLCoreRect){{10, 10}, {0, 0}}), 0, 0);
+}
+
+// Progress and time
+
+static void TLTestIncrementalProgress(void)
+{
+    TLCheckFloat(TLCoreIncrementalProgress(0, 0.25), 0.25);
+    TLCheckFloat(TLCoreIncrementalProgress(0.5, 0.75), 0.5);
+    TLCheckFloat(TLCoreIncrementalProgress(0.5, 0.25), 0.5);
+    TLCheckFloat(TLCoreIncrementalProgress(0.5, 0.5), 0);
+    TLCheckFloat(TLCoreIncrementalProgress(1, 1), 1);
+
+    // stepping incrementally from the previous poses, in either direction, must
+    // land exactly where interpolating from the endpoints would
+    TLCorePose from = TLTestPose(0, 0, 10, 10, 1);
+    TLCorePose to = TLTestPose(100, 200, 30, 50, 0);
+    TLCorePose pose = from;
+    double steps[] = {0.1, 0.4, 0.4, 0.25, 0, 0.6, 0.9, 1, 0.5};
+    double previous = 0;
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        double progress = steps[i];
+        bool reverse = previous > progress;
+        TLCoreInterpolatePose(&pose, &pose, reverse ? &from : &to, TLCoreIncrementalProgress(previous, progress));
+        TLCorePose expected;
+        TLCoreInterpolatePose(&expected, &from, &to, progress);
+        TLCheck(TLTestPosesEqual(&pose, &expected));
+        previous = progress;
+    }
+}
+
+static void TLTestTimespace(void)
+{
+    TLCheckFloat(TLCoreProgress(10, 15, 20), 0.5);
+    TLCheckFloat(TLCoreProgress(20, 15, 10), 0.5);
+    TLCheckFloat(TLCoreProgress(10, 5, 20), 0);
+    TLCheckFloat(TLCoreProgress(10, 25, 20), 1);
+
+    TLCheckFloat(TLCoreConvertTimespace(0.5, 0.25, 0.75), 0.5);
+    TLCheckFloat(TLCoreConvertTimespace(0.3, 0.25, 0.75), 0.1);
+    TLCheckFloat(TLCoreConvertTimespace(0.1, 0.25, 0.75), 0);
+    TLCheckFloat(TLCoreConvertTimespace(0.9, 0.25, 0.75), 1);
+    // an empty or inverted timespace has already finished
+    TLCheckFloat(TLCoreConvertTimespace(0.1, 0.5, 0.5), 1);
+    TLCheckFloat(TLCoreConvertTimespace(0.1, 0.75, 0.25), 1);
+    // inputs are clamped to [0, 1]
+    TLCheckFloat(TLCoreConvertTimespace(-1, -1, 2), 0);
+    TLCheckFloat(TLCoreConvertTimespace(2, -1, 2), 1);
+
+    TLCheckFloat(TLCoreInterpolateFloat(10, 20, 0.25), 12.5);
+    TLCorePoint point = TLCoreInterpolatePoint((TLCorePoint){0, 10}, (TLCorePoint){10, 0}, 0.5);
+    TLCheckPoint(point, 5, 5);
+    TLCoreRect rect = TLCoreRectUnion(TLCoreRectNull, (TLCoreRect){{10, 10}, {-5, -5}});
+    TLCheckPoint(rect.origin, 5, 5);
+    rect = TLCoreRectUnion(rect, (TLCoreRect){{20, 0}, {5, 5}});
+    TLCheckPoint(rect.origin, 5, 0);
+    TLCheckFloat(rect.size.width, 20);
+    TLCheckFloat(rect.size.height, 10);
+}
+
+// Snapshots
+
+static void TLTestSnapshots(void)
+{
+    uint32_t itemCounts[] = {2, 0, 3};
+    size_t length = TLCoreLayoutSnapshotLength(3, itemCounts, 1);
+    TLCheck(length > 0);
+    uint64_t *storage = calloc(length / 8 + 1, 8);
+    TLCorePose *poses = TLCoreLayoutSnapshotInit(storage, 3, itemCounts, 1, (TLCoreSize){320, 480});
+    for (uint32_t i = 0; i < 8; i++) {
+        poses[i] = TLTestPose(i, i * 2, 10, 10, 1);
+    }
+
+    TLCoreLayoutSnapshot snapshot;
+    TLCheck(TLCoreLayoutSnapshotParse(&snapshot, storage, length));
+    TLCheck(snapshot.numberOfSections == 3);
+    TLCheck(snapshot.supplementaryKindCount == 1);
+    TLCheck(snapshot.elementCount == 8);
+    TLCheckFloat(snapshot.boundsSize.width, 320);
+    TLCheckFloat(snapshot.boundsSize.height, 480);
+    TLCheck(memcmp(snapshot.itemCounts, itemCounts, sizeof(itemCounts)) == 0);
+    TLCheck(snapshot.poses == poses);
+    TLCheckFloat(snapshot.poses[7].center.y, 14);
+
+    // truncated, padded, misaligned and corrupt buffers are rejected
+    TLCheck(!TLCoreLayoutSnapshotParse(&snapshot, NULL, length));
+    TLCheck(!TLCoreLayoutSnapshotParse(&snapshot, storage, length - 1));
+    TLCheck(!TLCoreLayoutSnapshotParse(&snapshot, storage, length + 8));
+    TLCheck(!TLCoreLayoutSnapshotParse(&snapshot, storage, 16));
+    TLCheck(!TLCoreLayoutSnapshotParse(&snapshot, (char *)storage + 4, length - 4));
+    char *bytes = (char *)storage;
+    bytes[0] = 'X';
+    TLCheck(!TLCoreLayoutSnapshotParse(&snapshot, storage, length));
+    bytes[0] = 'T';
+    TLCheck(TLCoreLayoutSnapshotParse(&snapshot, storage, length));
+    // an item count that disagrees with the element count
+    uint32_t *counts = (uint32_t *)(uintptr_t)snapshot.itemCounts;
+    counts[1] = 1;
+    TLCheck(!TLCoreLayoutSnapshotParse(&snapshot, storage, length));
+    free(storage);
+}
+
+// Traces
+
+static TLCoreTrace *TLTestCreateTrace(void)
+{
+    TLCoreTrace *trace = TLCoreTraceCreate();
+    TLCheck(trace && TLCoreTraceSetElementCount(trace, 3));
+    for (uint32_t i = 0; i < 3; i++) {
+        trace->fromPoses[i] = TLTestPose(i * 50, 25, 50, 50, 1);
+        trace->toPoses[i] = TLTestPose(25, i * 50, 50, 50, 1);
+    }
+    trace->viewportSize = (TLCoreSize){100, 100};
+    trace->fromContentOffset = (TLCorePoint){0, 0};
+    trace->hasToContentOffset = true;
+    trace->toContentOffset = (TLCorePoint){0, 50};
+    for (int i = 1; i <= 4; i++) {
+        TLCheck(TLCoreTraceAppendEvent(trace, TLCoreTraceEventDisplayLink, i / 60.0, 1 / 60.0, 0));
+        TLCheck(TLCoreTraceAppendEvent(trace, TLCoreTraceEventProgress, i / 60.0, i / 4.0, i / 4.0));
+    }
+    TLCheck(TLCoreTraceAppendEvent(trace, TLCoreTraceEventRetarget, 0.1, 10, 20));
+    TLCheck(TLCoreTraceAppendEvent(trace, TLCoreTraceEventCancel, 0.2, 0, 0));
+    return trace;
+}
+
+static size_t TLTestWriteTrace(const TLCoreTrace *trace, char **bytes)
+{
+    FILE *file = tmpfile();
+    TLCheck(file && TLCoreTraceWrite(trace, file));
+    long length = ftell(file);
+    *bytes = malloc(length > 0 ? (size_t)length : 1);
+    rewind(file);
+    TLCheck(length > 0 && fread(*bytes, 1, (size_t)length, file) == (size_t)length);
+    fclose(file);
+    return length > 0 ? (size_t)length : 0;
+}
+
+static TLCoreTrace *TLTestReadTrace(const char *bytes, size_t length)
+{
+    FILE *file = tmpfile();
+    TLCheck(file && fwrite(bytes, 1, length, file) == length);
+    rewind(file);
+    TLCoreTrace *trace = TLCoreTraceRead(file);
+    fclose(file);
+    return trace;
+}
+
+static void TLTestFrameCount(void *context, const TLCoreFrameMetrics *metrics)
+{
+    (void)metrics;
+    (*(size_t *)context)++;
+}
+
+static void TLTestTraces(void)
+{
+    TLCoreTrace *trace = TLTestCreateTrace();
+    char *bytes;
+    size_t length = TLTestWriteTrace(trace, &bytes);
+
+    TLCoreTrace *read = TLTestReadTrace(bytes, length);
+    TLCheck(read != NULL);
+    if (read) {
+        TLCheck(read->elementCount == trace->elementCount);
+        for (uint32_t i = 0; i < trace->elementCount; i++) {
+            TLCheck(TLTestPosesEqual(&read->fromPoses[i], &trace->fromPoses[i]));
+            TLCheck(TLTestPosesEqual(&read->toPoses[i], &trace->toPoses[i]));
+        }
+        TLCheckFloat(read->viewportSize.width, 100);
+        TLCheck(read->hasToContentOffset);
+        TLCheckPoint(read->toContentOffset, 0, 50);
+        TLCheck(read->eventCount == trace->eventCount);
+        TLCheck(memcmp(read->events, trace->events, trace->eventCount * sizeof(TLCoreTraceEvent)) == 0);
+
+        size_t frames = 0;
+        TLCoreMetricsSink sink = {TLTestFrameCount, &frames};
+        TLCheck(TLCoreTraceReplay(read, sink) == 4);
+        TLCheck(frames == 4);
+        TLCoreTraceDestroy(read);
+    }
+
+    // every truncation is rejected
+    for (size_t truncated = 0; truncated < length; truncated++) {
+        read = TLTestReadTrace(bytes, truncated);
+        TLCheck(read == NULL);
+        TLCoreTraceDestroy(read);
+    }
+
+    // as are bad magic, versions and byte orders
+    for (size_t offset = 0; offset < 12; offset += 4) {
+        bytes[offset] ^= 0x40;
+        read = TLTestReadTrace(bytes, length);
+        TLCheck(read == NULL);
+        TLCoreTraceDestroy(read);
+        bytes[offset] ^= 0x40;
+    }
+
+    // and counts larger than the file, which must fail before being allocated
+    uint32_t elementCount = UINT32_MAX;
+    memcpy(bytes + 12, &elementCount, sizeof(elementCount));
+    read = TLTestReadTrace(bytes, length);
+    TLCheck(read == NULL);
+    TLCoreTraceDestroy(read);
+    elementCount = trace->elementCount;
+    memcpy(bytes + 12, &elementCount, sizeof(elementCount));
+    size_t eventCountOffset = length - trace->eventCount * sizeof(TLCoreTraceEvent) - sizeof(uint64_t);
+    uint64_t eventCounts[] = {trace->eventCount + 1, UINT64_MAX / sizeof(TLCoreTraceEvent), UINT64_MAX};
+    for (size_t i = 0; i < sizeof(eventCounts) / sizeof(eventCounts[0]); i++) {
+        memcpy(bytes + eventCountOffset, &eventCounts[i], sizeof(uint64_t));
+        read = TLTestReadTrace(bytes, length);
+        TLCheck(read == NULL);
+        TLCoreTraceDestroy(read);
+    }
+    uint64_t eventCount = trace->eventCount;
+    memcpy(bytes + eventCountOffset, &eventCount, sizeof(eventCount));
+    read = TLTestReadTrace(bytes, length);
+    TLCheck(read != NULL);
+    TLCoreTraceDestroy(read);
+
+    free(bytes);
+    TLCoreTraceDestroy(trace);
+}
+
+// Batch updates
+
+static bool TLTestIndexPathEquals(TLCoreIndexPath indexPath, long section, long item)
+{
+    return indexPath.section == section && indexPath.item == item;
+}
+
+static void TLTestRemapSections(void)
+{
+    // delete section 0, insert a section at 1 and move section 2 to 0
+    long itemCounts[] = {2, 1, 2};
+    TLCoreUpdate updates[] = {
+        {TLCoreUpdateActionDelete, {0, TLCoreNotFound}, {TLCoreNotFound, TLCoreNotFound}},
+        {TLCoreUpdateActionInsert, {TLCoreNotFound, TLCoreNotFound}, {1, TLCoreNotFound}},
+        {TLCoreUpdateActionMove, {2, TLCoreNotFound}, {0, TLCoreNotFound}},
+    };
+    long newSections[3];
+    TLCoreIndexPath newIndexPaths[5];
+    TLCheck(TLCoreRemapIndexPaths(itemCounts, 3, updates, 3, newSections, newIndexPaths));
+    TLCheck(newSections[0] == TLCoreNotFound);
+    TLCheck(newSections[1] == 2);
+    TLCheck(newSections[2] == 0);
+    TLCheck(TLTestIndexPathEquals(newIndexPaths[0], TLCoreNotFound, TLCoreNotFound));
+    TLCheck(TLTestIndexPathEquals(newIndexPaths[1], TLCoreNotFound, TLCoreNotFound));
+    TLCheck(TLTestIndexPathEquals(newIndexPaths[2], 2, 0));
+    TLCheck(TLTestIndexPathEquals(newIndexPaths[3], 0, 0));
+    TLCheck(TLTestIndexPathEquals(newIndexPaths[4], 0, 1));
+
+    // no updates is the identity
+    TLCheck(TLCoreRemapIndexPaths(itemCounts, 3, NULL, 0, newSections, newIndexPaths));
+    TLCheck(newSections[0] == 0 && newSections[1] == 1 && newSections[2] == 2);
+    TLCheck(TLTestIndexPathEquals(newIndexPaths[4], 2, 1));
+}
+
+/*
+ Drives the core the way `TLTransitionLayout` does through an insert, a delete and
+ a move applied while a transition is in flight: in-flight poses follow their cells
+ to the new index paths, deleted cells disappear from where they are, inserted cells
+ appear at the current progress, and the remainder of the transition lands every
+ cell on its new endpoint without reapplying the step taken before the update.
+ */
+static void TLTestUpdatesMidTransition(void)
+{
+    // cells are identified by name; "from" is a column, "to" a row
+    const char *oldCells[] = {"A", "B", "C", "D", "E", "F"};
+    long oldItemCounts[] = {4, 2};
+    TLCorePose oldFrom[6], oldTo[6], poses[6];
+    for (int i = 0; i < 6; i++) {
+        oldFrom[i] = TLTestPose(0, i * 10, 10, 10, 1);
+        oldTo[i] = TLTestPose(i * 20, 0, 20, 20, 1);
+        poses[i] = oldFrom[i];
+    }
+    double previousProgress = 0;
+    double steps[] = {0.2, 0.4};
+    for (int s = 0; s < 2; s++) {
+        double t = TLCoreIncrementalProgress(previousProgress, steps[s]);
+        for (int i = 0; i < 6; i++) {
+            TLCoreInterpolatePose(&poses[i], &poses[i], &oldTo[i], t);
+        }
+        previousProgress = steps[s];
+    }
+    double progress = previousProgress;
+
+    // insert X at (0, 0), delete B (0, 1) and move E (1, 0) to (0, 2)
+    TLCoreUpdate updates[] = {
+        {TLCoreUpdateActionInsert, {TLCoreNotFound, TLCoreNotFound}, {0, 0}},
+        {TLCoreUpdateActionDelete, {0, 1}, {TLCoreNotFound, TLCoreNotFound}},
+        {TLCoreUpdateActionMove, {1, 0}, {0, 2}},
+    };
+    long newSections[2];
+    TLCoreIndexPath newIndexPaths[6];
+    TLCheck(TLCoreRemapIndexPaths(oldItemCounts, 2, updates, 3, newSections, newIndexPaths));
+    TLCheck(newSections[0] == 0 && newSections[1] == 1);
+
+    // the data after the update is X A E C D | F
+    const char *newCells[] = {"X", "A", "E", "C", "D", "F"};
+    long newStarts[] = {0, 5, 6};
+    TLCorePose newFrom[6], newTo[6], newPoses[6];
+    bool hasPose[6] = {false};
+    for (int i = 0; i < 6; i++) {
+        newFrom[i] = TLTestPose(5, i * 10, 10, 10, 1);
+        newTo[i] = TLTestPose(i * 20, 5, 20, 20, 1);
+    }
+    int disappearingCount = 0;
+    for (int i = 0; i < 6; i++) {
+        TLCoreIndexPath indexPath = newIndexPaths[i];
+        if (indexPath.section == TLCoreNotFound) {
+            // disappears from its in-flight pose
+            TLCheck(strcmp(oldCells[i], "B") == 0);
+            TLCheck(TLTestPosesEqual(&poses[i], &poses[1]));
+            disappearingCount++;
+            continue;
+        }
+        long element = newStarts[indexPath.section] + indexPath.item;
+        TLCheck(strcmp(newCells[element], oldCells[i]) == 0);
+        TLCheck(!hasPose[element]);
+        newPoses[element] = poses[i];
+        hasPose[element] = true;
+    }
+    TLCheck(disappearingCount == 1);
+    TLCheck(!hasPose[0]);
+    // X appears where it would be at the current progress, transparent
+    TLCoreInterpolatePose(&newPoses[0], &newFrom[0], &newTo[0], progress);
+    newPoses[0].alpha = 0;
+
+    // with the previous progress reset, the layout pass that follows the update
+    // leaves every pose where it is
+    previousProgress = progress;
+    TLCorePose settled[6];
+    double t = TLCoreIncrementalProgress(previousProgress, progress);
+    TLCheckFloat(t, 0);
+    for (int i = 0; i < 6; i++) {
+        TLCoreInterpolatePose(&settled[i], &newPoses[i], &newTo[i], t);
+        TLCheck(TLTestPosesEqual(&settled[i], &newPoses[i]));
+    }
+
+    // and the rest of the transition lands on the new "to" layout
+    double remainingSteps[] = {0.7, 1};
+    for (int s = 0; s < 2; s++) {
+        t = TLCoreIncrementalProgress(previousProgress, remainingSteps[s]);
+        for (int i = 0; i < 6; i++) {
+            TLCoreInterpolatePose(&newPoses[i], &newPoses[i], &newTo[i], t);
+        }
+        previousProgress = remainingSteps[s];
+    }
+    for (int i = 0; i < 6; i++) {
+        TLCheck(TLTestPosesEqual(&newPoses[i], &newTo[i]));
+    }
+}
+
+int main(void)
+{
+    TLTestPlacements();
+    TLTestIncrementalProgress();
+    TLTestTimespace();
+    TLTestSnapshots();
+    TLTestTraces();
+    TLTestRemapSections();
+    TLTestUpdatesMidTransition();
+    if (failureCount) {
+        fprintf(stderr, "%d check(s) failed\n", failureCount);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}